@@ -331,6 +331,37 @@ if (ENABLE_KOKKOS)
   set (FLECSI_ENABLE_KOKKOS TRUE)
 endif()
 
+#------------------------------------------------------------------------------#
+# Add option for OpenMP SIMD hints in the native kernel backend
+#------------------------------------------------------------------------------#
+
+option(ENABLE_OPENMP_SIMD
+  "Enable OpenMP SIMD directives in native forall kernels" OFF)
+
+if(ENABLE_OPENMP_SIMD)
+  include(CheckCXXCompilerFlag)
+  check_cxx_compiler_flag(-fopenmp-simd HAVE_OPENMP_SIMD_FLAG)
+
+  if(HAVE_OPENMP_SIMD_FLAG)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fopenmp-simd")
+  endif()
+endif()
+
+#------------------------------------------------------------------------------#
+# Add option for the built-in task and communication timeline tracing
+#------------------------------------------------------------------------------#
+
+option(ENABLE_TRACE
+  "Record a per-rank timeline of tasks and communication in Chrome trace format"
+  OFF)
+
+#------------------------------------------------------------------------------#
+# Add option for benchmark units
+#------------------------------------------------------------------------------#
+
+option(ENABLE_FLECSI_BENCHMARKS
+  "Enable task launch and ghost exchange benchmark units" OFF)
+
 #------------------------------------------------------------------------------#
 # Runtime models
 #------------------------------------------------------------------------------#
@@ -487,6 +518,8 @@ set(FLECSI_ENABLE_METIS ENABLE_METIS)
 set(FLECSI_ENABLE_PARMETIS ENABLE_PARMETIS)
 set(FLECSI_ENABLE_GRAPHVIZ ${ENABLE_GRAPHVIZ})
 set(FLECSI_ENABLE_DYNAMIC_CONTROL_MODEL ${ENABLE_DYNAMIC_CONTROL_MODEL})
+set(FLECSI_ENABLE_OPENMP_SIMD ${ENABLE_OPENMP_SIMD})
+set(FLECSI_ENABLE_TRACE ${ENABLE_TRACE})
 
 configure_file(${PROJECT_SOURCE_DIR}/config/flecsi-config.h.in
   ${CMAKE_BINARY_DIR}/flecsi-config.h @ONLY)
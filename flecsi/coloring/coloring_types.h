@@ -15,9 +15,12 @@
 
 /*! @file */
 
+#include <ostream>
 #include <set>
 #include <vector>
 
+#include <flecsi/utils/flat_set.h>
+
 namespace flecsi {
 namespace coloring {
 
@@ -37,10 +40,10 @@ struct coloring_info_t {
   size_t ghost;
 
   //! The aggregate set of colors that depend on our shared indices.
-  std::set<size_t> shared_users;
+  utils::flat_set_u<size_t> shared_users;
 
   //! The aggregate set of colors that we depend on for ghosts.
-  std::set<size_t> ghost_owners;
+  utils::flat_set_u<size_t> ghost_owners;
 
 }; // struct coloring_info_t
 
@@ -73,7 +76,10 @@ struct entity_info_t {
   size_t id;
   size_t rank;
   size_t offset;
-  std::set<size_t> shared;
+
+  // The ranks that share this entity. This is empty for most entities, in
+  // which case it does not allocate.
+  utils::flat_set_u<size_t> shared;
 
   /*!
    Constructor.
@@ -88,8 +94,8 @@ struct entity_info_t {
   entity_info_t(size_t id_ = 0,
     size_t rank_ = 0,
     size_t offset_ = 0,
-    std::set<size_t> shared_ = {})
-    : id(id_), rank(rank_), offset(offset_), shared(shared_) {}
+    utils::flat_set_u<size_t> shared_ = {})
+    : id(id_), rank(rank_), offset(offset_), shared(std::move(shared_)) {}
 
   /*!
    Constructor.
@@ -102,9 +108,7 @@ struct entity_info_t {
    */
 
   entity_info_t(size_t id_, size_t rank_, size_t offset_, size_t shared_)
-    : id(id_), rank(rank_), offset(offset_) {
-    shared.emplace(shared_);
-  }
+    : id(id_), rank(rank_), offset(offset_), shared{shared_} {}
 
   entity_info_t(size_t id_,
     size_t rank_,
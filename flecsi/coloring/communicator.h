@@ -18,6 +18,7 @@
 #include <set>
 
 #include <flecsi/coloring/coloring_types.h>
+#include <flecsi/utils/flat_set.h>
 
 namespace flecsi {
 namespace coloring {
@@ -81,7 +82,7 @@ public:
    */
 
   virtual std::pair<std::vector<std::set<size_t>>, std::set<entity_info_t>>
-  get_primary_info(const std::set<size_t> & primary,
+  get_primary_info(const utils::flat_set_u<size_t> & primary,
     const std::set<size_t> & request_indices) = 0;
 
   /*!
@@ -102,7 +103,7 @@ public:
    */
 
   virtual std::unordered_map<size_t, std::set<size_t>> get_entity_reduction(
-    const std::set<size_t> & local_indices) = 0;
+    const utils::flat_set_u<size_t> & local_indices) = 0;
 
   /*!
    Set a barrier.
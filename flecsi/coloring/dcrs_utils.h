@@ -23,12 +23,16 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include <flecsi/coloring/crs.h>
 #include <flecsi/topology/closure_utils.h>
 #include <flecsi/topology/mesh_definition.h>
 #include <flecsi/topology/parallel_mesh_definition.h>
+#include <flecsi/utils/mpi_comm.h>
 #include <flecsi/utils/mpi_type_traits.h>
 
 #include <flecsi/coloring/coloring_types.h>
@@ -59,8 +63,8 @@ naive_coloring(topology::mesh_definition_u<MESH_DIMENSION> & md) {
     int size;
     int rank;
 
-    MPI_Comm_size(MPI_COMM_WORLD, &size);
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(utils::mpi_comm(), &size);
+    MPI_Comm_rank(utils::mpi_comm(), &rank);
 
     //--------------------------------------------------------------------------//
     // Create a naive initial distribution of the indices
@@ -116,8 +120,8 @@ make_dcrs(const typename topology::mesh_definition_u<DIMENSION> & md) {
   int size;
   int rank;
 
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(utils::mpi_comm(), &size);
+  MPI_Comm_rank(utils::mpi_comm(), &rank);
 
   //--------------------------------------------------------------------------//
   // Create a naive initial distribution of the indices
@@ -152,48 +156,64 @@ make_dcrs(const typename topology::mesh_definition_u<DIMENSION> & md) {
   using cellid = size_t;
   using vertexid = size_t;
 
-  // essentially vertex to cell and cell to cell through vertices
-  // connectivity.
-  std::map<vertexid, std::vector<cellid>> vertex2cells;
-  std::map<cellid, std::vector<cellid>> cell2cells;
+  // Vertex to cell connectivity, stored as (vertex, cell) pairs sorted by
+  // vertex. This is a flat array rather than a map of vectors, and no
+  // cell-to-cell graph is built for cells that are not in this rank's
+  // slab.
+  std::vector<std::pair<vertexid, cellid>> vertex2cells;
+  std::vector<std::vector<vertexid>> cell2vertices(init_indices);
 
-  // build global cell to cell through # of shared vertices connectivity
   for(size_t cell(0); cell < md.num_entities(FROM_DIMENSION); ++cell) {
-    std::map<cellid, size_t> cell_counts;
-
-    for(auto vertex : md.entities(FROM_DIMENSION, 0, cell)) {
-      // build vertex to cell connectivity, O(n_cells * n_polygon_sides)
-      // of insert().
-      vertex2cells[vertex].push_back(cell);
-
-      // Count the number of times this cell shares a common vertex with
-      // some other cell. O(n_cells * n_polygon_sides * vertex to cells degrees)
-      for(auto other : vertex2cells[vertex]) {
-        if(other != cell)
-          cell_counts[other] += 1;
-      }
-    }
+    auto vertices = md.entities(FROM_DIMENSION, 0, cell);
 
-    for(auto count : cell_counts) {
-      if(count.second > THRU_DIMENSION) {
-        // append cell to cell through "dimension" connectivity, we need to
-        // add both directions
-        cell2cells[cell].push_back(count.first);
-        cell2cells[count.first].push_back(cell);
-      }
-    }
-  }
+    for(auto vertex : vertices) {
+      vertex2cells.emplace_back(vertex, cell);
+    } // for
+
+    if(cell >= dcrs.distribution[rank] && cell < dcrs.distribution[rank + 1]) {
+      cell2vertices[cell - dcrs.distribution[rank]] = std::move(vertices);
+    } // if
+  } // for
+
+  std::sort(vertex2cells.begin(), vertex2cells.end());
+
+  // Cells that share more than THRU_DIMENSION vertices are neighbors.
+  std::vector<cellid> others;
 
-  // turn subset of cell 2 cell connectivity to dcrs
   for(size_t i(0); i < init_indices; ++i) {
     auto cell = dcrs.distribution[rank] + i;
 
-    for(auto n : cell2cells[cell]) {
-      dcrs.indices.push_back(n);
+    others.clear();
+
+    for(auto vertex : cell2vertices[i]) {
+      auto first = std::lower_bound(vertex2cells.begin(), vertex2cells.end(),
+        std::make_pair(vertex, cellid{0}));
+
+      for(auto it = first; it != vertex2cells.end() && it->first == vertex;
+          ++it) {
+        if(it->second != cell) {
+          others.push_back(it->second);
+        } // if
+      } // for
     } // for
 
-    dcrs.offsets.push_back(dcrs.offsets[i] + cell2cells[cell].size());
-  }
+    std::sort(others.begin(), others.end());
+
+    size_t num_connections{0};
+
+    for(auto it = others.begin(); it != others.end();) {
+      auto last = std::upper_bound(it, others.end(), *it);
+
+      if(std::distance(it, last) > THRU_DIMENSION) {
+        dcrs.indices.push_back(*it);
+        ++num_connections;
+      } // if
+
+      it = last;
+    } // for
+
+    dcrs.offsets.push_back(dcrs.offsets[i] + num_connections);
+  } // for
 
   return dcrs;
 } // make_dcrs
@@ -212,8 +232,8 @@ make_dcrs_have_connectivity(
   int size;
   int rank;
 
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(utils::mpi_comm(), &size);
+  MPI_Comm_rank(utils::mpi_comm(), &rank);
 
   //--------------------------------------------------------------------------//
   // Create a naive initial distribution of the indices
@@ -299,7 +319,7 @@ alltoallv(const SEND_TYPE & sendbuf,
   RECV_TYPE & recvbuf,
   const ID_TYPE & recvcounts,
   const ID_TYPE & recvdispls,
-  decltype(MPI_COMM_WORLD) comm) {
+  MPI_Comm comm) {
 
   const auto mpi_send_t =
     utils::mpi_typetraits_u<typename SEND_TYPE::value_type>::type();
@@ -397,8 +417,8 @@ make_dcrs_distributed(
   int size;
   int rank;
 
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(utils::mpi_comm(), &size);
+  MPI_Comm_rank(utils::mpi_comm(), &rank);
 
   // the mpi data type for size_t
   const auto mpi_size_t = utils::mpi_typetraits_u<size_t>::type();
@@ -418,7 +438,7 @@ make_dcrs_distributed(
   dcrs.distribution[0] = 0;
 
   MPI_Allgather(&num_cells, 1, mpi_size_t, dcrs.distribution.data() + 1, 1,
-    mpi_size_t, MPI_COMM_WORLD);
+    mpi_size_t, utils::mpi_comm());
 
   for(size_t i = 0; i < size; ++i)
     dcrs.distribution[i + 1] += dcrs.distribution[i];
@@ -441,7 +461,7 @@ make_dcrs_distributed(
   // now the global max id
   size_t tot_verts{0};
   MPI_Allreduce(
-    &max_global_vert_id, &tot_verts, 1, mpi_size_t, MPI_MAX, MPI_COMM_WORLD);
+    &max_global_vert_id, &tot_verts, 1, mpi_size_t, MPI_MAX, utils::mpi_comm());
   tot_verts++;
 
   decltype(dcrs.distribution) vert_dist;
@@ -451,10 +471,15 @@ make_dcrs_distributed(
   // Create the Local vertex-to-cell graph.
   //----------------------------------------------------------------------------
 
-  // essentially vertex to cell connectivity
-  std::map<size_t, std::vector<size_t>> vertex2cell;
+  // Vertex to cell connectivity, stored as (vertex, cell) pairs sorted by
+  // global vertex id. Only vertices touched by this rank's cells, or owned
+  // by this rank in the vertex subdivision, ever appear here.
+  using vertex_cell_t = std::pair<size_t, size_t>;
+  std::vector<vertex_cell_t> vertex2cell;
   const auto & cells2vertex = md.entities_crs(from_dimension, to_dimension);
 
+  vertex2cell.reserve(cells2vertex.indices.size());
+
   // Travel from the FROM_DIMENSION (cell) to the TO_DIMENSION (other)
   for(size_t ic = 0; ic < num_cells; ++ic) {
     auto cell = cells_start + ic;
@@ -462,24 +487,26 @@ make_dcrs_distributed(
         ++i) {
       auto iv = cells2vertex.indices[i];
       auto vertex = vertex_local_to_global[iv];
-      vertex2cell[vertex].emplace_back(cell);
+      vertex2cell.emplace_back(vertex, cell);
     }
   }
 
-  // remove duplicates
-  auto remove_duplicates = [](auto & vertex2cell) {
-    for(auto & vertex_cells : vertex2cell) {
-      auto v = vertex_cells.first;
-      auto & cells = vertex_cells.second;
-      std::sort(cells.begin(), cells.end());
-      auto first = cells.begin();
-      auto last = std::unique(first, cells.end());
-      cells.erase(last, cells.end());
-    }
+  // sort and remove duplicates
+  auto remove_duplicates = [](auto & pairs) {
+    std::sort(pairs.begin(), pairs.end());
+    auto last = std::unique(pairs.begin(), pairs.end());
+    pairs.erase(last, pairs.end());
   };
 
   remove_duplicates(vertex2cell);
 
+  // the range of pairs of a given vertex
+  auto vertex_cells = [&vertex2cell](size_t vertex) {
+    return std::equal_range(vertex2cell.begin(), vertex2cell.end(),
+      vertex_cell_t(vertex, 0),
+      [](const auto & a, const auto & b) { return a.first < b.first; });
+  };
+
   //----------------------------------------------------------------------------
   // Send vertex information to the deemed vertex-owner
   //----------------------------------------------------------------------------
@@ -488,15 +515,13 @@ make_dcrs_distributed(
   // defined using the vertex subdivision above
   std::vector<size_t> sendcounts(size, 0);
 
-  // count
-  for(const auto & vs_pair : vertex2cell) {
-    size_t global_id = vs_pair.first;
-    auto r = rank_owner(vert_dist, global_id);
-    // we will be sending vertex id, number of cells, plus cell ids
-    if(r != rank) {
-      auto n = 2 + vs_pair.second.size();
-      sendcounts[r] += n;
-    }
+  // count, we will be sending vertex id, number of cells, plus cell ids
+  for(auto it = vertex2cell.begin(); it != vertex2cell.end();) {
+    auto range = vertex_cells(it->first);
+    auto r = rank_owner(vert_dist, it->first);
+    if(r != rank)
+      sendcounts[r] += 2 + std::distance(range.first, range.second);
+    it = range.second;
   }
 
   // finish displacements
@@ -510,27 +535,26 @@ make_dcrs_distributed(
   // fill buffers
   std::vector<size_t> sendbuf(senddispls[size]);
 
-  for(const auto & vs_pair : vertex2cell) {
-    size_t global_id = vs_pair.first;
-    auto r = rank_owner(vert_dist, global_id);
-    // we will be sending vertex id, number of cells, plus cell ids
+  for(auto it = vertex2cell.begin(); it != vertex2cell.end();) {
+    auto range = vertex_cells(it->first);
+    auto r = rank_owner(vert_dist, it->first);
     if(r != rank) {
       // get offset
       auto offset = senddispls[r] + sendcounts[r];
       // populate data
-      sendbuf[offset++] = global_id;
-      sendbuf[offset++] = vs_pair.second.size();
-      for(auto v : vs_pair.second)
-        sendbuf[offset++] = v;
+      sendbuf[offset++] = it->first;
+      sendbuf[offset++] = std::distance(range.first, range.second);
+      for(auto jt = range.first; jt != range.second; ++jt)
+        sendbuf[offset++] = jt->second;
       // bump counters
-      auto n = 2 + vs_pair.second.size();
-      sendcounts[r] += n;
+      sendcounts[r] = offset - senddispls[r];
     }
+    it = range.second;
   }
 
   std::vector<size_t> recvcounts(size, 0);
   auto ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(),
-    1, mpi_size_t, MPI_COMM_WORLD);
+    1, mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -543,7 +567,7 @@ make_dcrs_distributed(
 
   // now send the actual vertex info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
@@ -551,51 +575,48 @@ make_dcrs_distributed(
   // Append received vertex information to the local vertex-to-cell graph
   //----------------------------------------------------------------------------
 
-  // and add the results to our local list
-  std::map<size_t, std::vector<size_t>> vertex2rank;
+  // keep track of the ranks that share each vertex, as (vertex, rank) pairs
+  std::vector<std::pair<size_t, size_t>> vertex2rank;
 
-  for(size_t r = 0; r < size; ++r) {
-    for(size_t i = recvdispls[r]; i < recvdispls[r + 1];) {
-      // get vertex
-      auto vertex = recvbuf[i];
-      ++i;
-      // keep track of ranks that share this vertex
-      vertex2rank[vertex].emplace_back(r);
-      assert(i < recvdispls[r + 1]);
-      // unpack cell neighbors
-      auto n = recvbuf[i];
-      ++i;
-      for(size_t j = 0; j < n; ++j) {
+  auto unpack = [&](bool track_ranks) {
+    for(size_t r = 0; r < size; ++r) {
+      for(size_t i = recvdispls[r]; i < recvdispls[r + 1];) {
+        // get vertex
+        auto vertex = recvbuf[i];
+        ++i;
+        if(track_ranks)
+          vertex2rank.emplace_back(vertex, r);
         assert(i < recvdispls[r + 1]);
-        auto cell = recvbuf[i];
+        // unpack cell neighbors
+        auto n = recvbuf[i];
         ++i;
-        // might not already be there
-        vertex2cell[vertex].emplace_back(cell);
+        for(size_t j = 0; j < n; ++j) {
+          assert(i < recvdispls[r + 1]);
+          // might not already be there
+          vertex2cell.emplace_back(vertex, recvbuf[i]);
+          ++i;
+        }
       }
     }
-  }
+  };
+
+  unpack(true);
 
-  // remove duplicates
   remove_duplicates(vertex2cell);
+  remove_duplicates(vertex2rank);
 
   //----------------------------------------------------------------------------
   // Send back the final results for shared vertices
   //----------------------------------------------------------------------------
 
-  // now perpare to send results back
-
   // count send buffer size
   std::fill(sendcounts.begin(), sendcounts.end(), 0);
-  for(const auto & vertex_pair : vertex2rank) {
-    auto vertex = vertex_pair.first;
-    for(auto r : vertex_pair.second) {
-      if(r != rank) { // should always enter anyway!
-        // better already be there
-        const auto & cells = vertex2cell.at(vertex);
-        // we will be sending vertex id, number of cells, plus cell ids
-        auto n = 2 + cells.size();
-        sendcounts[r] += n;
-      }
+  for(const auto & vertex_rank : vertex2rank) {
+    auto r = vertex_rank.second;
+    if(r != rank) { // should always enter anyway!
+      auto range = vertex_cells(vertex_rank.first);
+      // we will be sending vertex id, number of cells, plus cell ids
+      sendcounts[r] += 2 + std::distance(range.first, range.second);
     }
   }
 
@@ -610,29 +631,26 @@ make_dcrs_distributed(
 
   // now fill buffer
   std::fill(sendcounts.begin(), sendcounts.end(), 0);
-  for(const auto & vertex_pair : vertex2rank) {
-    auto vertex = vertex_pair.first;
-    for(auto r : vertex_pair.second) {
-      if(r != rank) { // should always enter anyway!
-        auto j = senddispls[r] + sendcounts[r];
-        // better already be there
-        const auto & cells = vertex2cell.at(vertex);
-        // we will be sending vertex id, number of cells, plus cell ids
-        auto n = 2 + cells.size();
-        sendbuf[j++] = vertex;
-        sendbuf[j++] = cells.size();
-        for(auto c : cells)
-          sendbuf[j++] = c;
-        // increment send counter
-        sendcounts[r] = j - senddispls[r];
-      }
+  for(const auto & vertex_rank : vertex2rank) {
+    auto r = vertex_rank.second;
+    if(r != rank) { // should always enter anyway!
+      auto j = senddispls[r] + sendcounts[r];
+      // better already be there
+      auto range = vertex_cells(vertex_rank.first);
+      assert(range.first != range.second);
+      sendbuf[j++] = vertex_rank.first;
+      sendbuf[j++] = std::distance(range.first, range.second);
+      for(auto it = range.first; it != range.second; ++it)
+        sendbuf[j++] = it->second;
+      // increment send counter
+      sendcounts[r] = j - senddispls[r];
     }
   }
 
   // send counts
   std::fill(recvcounts.begin(), recvcounts.end(), 0);
   ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(), 1,
-    mpi_size_t, MPI_COMM_WORLD);
+    mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating back vertex counts");
 
@@ -647,7 +665,7 @@ make_dcrs_distributed(
 
   // now send the final vertex info back
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating new vertices");
 
@@ -655,28 +673,8 @@ make_dcrs_distributed(
   // Append received vertex information to the local vertex-to-cell graph
   //----------------------------------------------------------------------------
 
-  for(size_t r = 0; r < size; ++r) {
-    for(size_t i = recvdispls[r]; i < recvdispls[r + 1];) {
-      // get vertex
-      auto vertex = recvbuf[i];
-      ++i;
-      // keep track of ranks that share this vertex
-      vertex2rank[vertex].emplace_back(r);
-      assert(i < recvdispls[r + 1]);
-      // unpack cell neighbors
-      auto n = recvbuf[i];
-      ++i;
-      for(size_t j = 0; j < n; ++j) {
-        assert(i < recvdispls[r + 1]);
-        auto cell = recvbuf[i];
-        ++i;
-        // might not already be there
-        vertex2cell[vertex].emplace_back(cell);
-      }
-    }
-  }
+  unpack(false);
 
-  // remove duplicates
   remove_duplicates(vertex2cell);
 
   //----------------------------------------------------------------------------
@@ -684,16 +682,17 @@ make_dcrs_distributed(
   //----------------------------------------------------------------------------
 
   // Set the first offset (always zero).
-  dcrs.offsets.reserve(num_cells);
+  dcrs.offsets.reserve(num_cells + 1);
   dcrs.indices.reserve(from_dimension * from_dimension * num_cells); // guess
   dcrs.offsets.push_back(0);
 
-  std::map<size_t, size_t> cell_counts;
+  // the cells attached to each vertex of a cell, one entry per shared vertex
+  std::vector<size_t> others;
 
   for(size_t ic = 0; ic < num_cells; ++ic) {
     auto cell = cells_start + ic;
 
-    cell_counts.clear();
+    others.clear();
 
     // iterate over vertices
     auto start = cells2vertex.offsets[ic];
@@ -701,22 +700,26 @@ make_dcrs_distributed(
     for(auto i = start; i < end; ++i) {
       auto iv = cells2vertex.indices[i];
       auto vertex = vertex_local_to_global[iv];
-      // now count attached cells
-      for(auto other : vertex2cell.at(vertex)) {
-        // new entries are initialized to zero
-        if(other != cell)
-          cell_counts[other] += 1;
+      // now collect attached cells
+      auto range = vertex_cells(vertex);
+      for(auto it = range.first; it != range.second; ++it) {
+        if(it->second != cell)
+          others.push_back(it->second);
       }
     }
 
-    // now add results
+    std::sort(others.begin(), others.end());
+
+    // now add results, the run length of each cell is its connection count
     int num_connections{0};
 
-    for(auto count : cell_counts) {
-      if(count.second >= min_connections) {
-        dcrs.indices.emplace_back(count.first);
+    for(auto it = others.begin(); it != others.end();) {
+      auto last = std::upper_bound(it, others.end(), *it);
+      if(std::distance(it, last) >= min_connections) {
+        dcrs.indices.emplace_back(*it);
         num_connections++;
       }
+      it = last;
     }
 
     dcrs.offsets.emplace_back(dcrs.offsets.back() + num_connections);
@@ -736,8 +739,8 @@ migrate(size_t dimension,
 
   int comm_size, comm_rank;
 
-  MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank);
+  MPI_Comm_size(utils::mpi_comm(), &comm_size);
+  MPI_Comm_rank(utils::mpi_comm(), &comm_rank);
 
   //----------------------------------------------------------------------------
   // Pack information together.
@@ -827,7 +830,7 @@ migrate(size_t dimension,
 
   std::vector<size_t> recvcounts(comm_size, 0);
   auto ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(),
-    1, mpi_size_t, MPI_COMM_WORLD);
+    1, mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -840,7 +843,7 @@ migrate(size_t dimension,
 
   // now send the actual info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
@@ -908,7 +911,7 @@ migrate(size_t dimension,
   dcrs.distribution[0] = 0;
 
   MPI_Allgather(&num_elements, 1, mpi_size_t, dcrs.distribution.data() + 1, 1,
-    mpi_size_t, MPI_COMM_WORLD);
+    mpi_size_t, utils::mpi_comm());
 
   for(size_t i = 0; i < comm_size; ++i)
     dcrs.distribution[i + 1] += dcrs.distribution[i];
@@ -920,8 +923,8 @@ get_owner_info(const dcrs_t & dcrs,
   flecsi::coloring::coloring_info_t & color_info) {
 
   int comm_size, comm_rank;
-  MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank);
+  MPI_Comm_size(utils::mpi_comm(), &comm_size);
+  MPI_Comm_rank(utils::mpi_comm(), &comm_rank);
 
   //----------------------------------------------------------------------------
   // Determine primary/ghost division
@@ -936,6 +939,10 @@ get_owner_info(const dcrs_t & dcrs,
   // keep track of shared ranks
   std::set<size_t> shared_ranks;
 
+  // ghosts are found in no particular order, so they are collected and
+  // inserted at once
+  std::vector<entity_info_t> ghosts;
+
   for(size_t local_id = 0; local_id < num_entities; ++local_id) {
 
     // determine clobal id
@@ -953,15 +960,7 @@ get_owner_info(const dcrs_t & dcrs,
         // create possible new ghost
         // auto ghost_id = num_entities+num_ghost;
         auto ghost_id = neighbor - dcrs.distribution[rank];
-        auto e = entity_info_t(neighbor, rank, ghost_id, comm_rank);
-        // search for it
-        auto it = entities.ghost.find(e);
-        // if it has not been added, then add it!
-        if(it == entities.ghost.end()) {
-          entities.ghost.emplace(e);
-          color_info.ghost_owners.insert(rank);
-          // num_ghost++;
-        }
+        ghosts.emplace_back(neighbor, rank, ghost_id, comm_rank);
         // keep track of shared ranks for the parent cell
         shared_ranks.emplace(rank);
       }
@@ -979,6 +978,13 @@ get_owner_info(const dcrs_t & dcrs,
     }
   }
 
+  // duplicates are removed by the insertion
+  entities.ghost.insert(ghosts.begin(), ghosts.end());
+
+  for(auto & e : entities.ghost) {
+    color_info.ghost_owners.insert(e.rank);
+  }
+
   // store the sizes of each set
   color_info.exclusive = entities.exclusive.size();
   color_info.shared = entities.shared.size();
@@ -998,8 +1004,8 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
   size_t & connectivity_counts) {
 
   int comm_size, comm_rank;
-  MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank);
+  MPI_Comm_size(utils::mpi_comm(), &comm_size);
+  MPI_Comm_rank(utils::mpi_comm(), &comm_rank);
 
   // the mpi data type for size_t
   const auto mpi_size_t = utils::mpi_typetraits_u<size_t>::type();
@@ -1095,7 +1101,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
   // send the counts
   std::vector<size_t> recvcounts(comm_size);
   auto ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(),
-    1, mpi_size_t, MPI_COMM_WORLD);
+    1, mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -1111,7 +1117,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
 
   // now send the actual vertex info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
@@ -1154,7 +1160,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
   // now the global max id
   size_t tot_ents{0};
   MPI_Allreduce(
-    &max_global_ent_id, &tot_ents, 1, mpi_size_t, MPI_MAX, MPI_COMM_WORLD);
+    &max_global_ent_id, &tot_ents, 1, mpi_size_t, MPI_MAX, utils::mpi_comm());
   tot_ents++;
 
   std::vector<size_t> ent_dist;
@@ -1216,7 +1222,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
 
   // send counts
   ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(), 1,
-    mpi_size_t, MPI_COMM_WORLD);
+    mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -1230,7 +1236,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
 
   // now send the actual vertex info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
@@ -1292,7 +1298,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
 
   // send counts
   ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(), 1,
-    mpi_size_t, MPI_COMM_WORLD);
+    mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -1306,7 +1312,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
 
   // now send the actual vertex info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
@@ -1377,7 +1383,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
 
   // send counts
   ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(), 1,
-    mpi_size_t, MPI_COMM_WORLD);
+    mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -1391,7 +1397,7 @@ color_entities(const flecsi::coloring::crs_t & cells2entity,
 
   // now send the actual vertex info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
@@ -1469,8 +1475,8 @@ match_ids(
   std::map<size_t, size_t> & global2local) {
 
   int comm_size, comm_rank;
-  MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank);
+  MPI_Comm_size(utils::mpi_comm(), &comm_size);
+  MPI_Comm_rank(utils::mpi_comm(), &comm_rank);
 
   // the mpi data type for size_t
   const auto mpi_size_t = utils::mpi_typetraits_u<size_t>::type();
@@ -1489,7 +1495,7 @@ match_ids(
   // now the global max id
   size_t tot_verts{0};
   MPI_Allreduce(
-    &max_global_vert_id, &tot_verts, 1, mpi_size_t, MPI_MAX, MPI_COMM_WORLD);
+    &max_global_vert_id, &tot_verts, 1, mpi_size_t, MPI_MAX, utils::mpi_comm());
   tot_verts++;
 
   std::vector<size_t> vert_dist;
@@ -1579,7 +1585,7 @@ match_ids(
   // send the counts
   std::vector<size_t> recvcounts(comm_size);
   auto ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(),
-    1, mpi_size_t, MPI_COMM_WORLD);
+    1, mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -1592,7 +1598,7 @@ match_ids(
 
   // now send the actual vertex info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
@@ -1632,7 +1638,7 @@ match_ids(
   edge_dist[0] = 0;
 
   MPI_Allgather(
-    &my_edges, 1, mpi_size_t, &edge_dist[1], 1, mpi_size_t, MPI_COMM_WORLD);
+    &my_edges, 1, mpi_size_t, &edge_dist[1], 1, mpi_size_t, utils::mpi_comm());
 
   for(size_t r = 0; r < comm_size; ++r)
     edge_dist[r + 1] += edge_dist[r];
@@ -1676,7 +1682,7 @@ match_ids(
 
   // send the counts
   ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(), 1,
-    mpi_size_t, MPI_COMM_WORLD);
+    mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -1689,7 +1695,7 @@ match_ids(
 
   // now send the actual vertex info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
@@ -1739,8 +1745,8 @@ ghost_connectivity(const flecsi::coloring::crs_t & from2to,
   flecsi::coloring::crs_t & connectivity) {
 
   int comm_size, comm_rank;
-  MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank);
+  MPI_Comm_size(utils::mpi_comm(), &comm_size);
+  MPI_Comm_rank(utils::mpi_comm(), &comm_rank);
 
   // the mpi data type for size_t
   const auto mpi_size_t = utils::mpi_typetraits_u<size_t>::type();
@@ -1807,7 +1813,7 @@ ghost_connectivity(const flecsi::coloring::crs_t & from2to,
   // send the counts
   std::vector<size_t> recvcounts(comm_size);
   auto ret = MPI_Alltoall(sendcounts.data(), 1, mpi_size_t, recvcounts.data(),
-    1, mpi_size_t, MPI_COMM_WORLD);
+    1, mpi_size_t, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertex counts");
 
@@ -1820,7 +1826,7 @@ ghost_connectivity(const flecsi::coloring::crs_t & from2to,
 
   // now send the actual vertex info
   ret = alltoallv(sendbuf, sendcounts, senddispls, recvbuf, recvcounts,
-    recvdispls, MPI_COMM_WORLD);
+    recvdispls, utils::mpi_comm());
   if(ret != MPI_SUCCESS)
     clog_error("Error communicating vertices");
 
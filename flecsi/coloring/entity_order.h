@@ -0,0 +1,225 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include <flecsi/coloring/crs.h>
+#include <flecsi/coloring/geometric_colorer.h>
+#include <flecsi/coloring/index_coloring.h>
+#include <flecsi/geometry/point.h>
+#include <flecsi/topology/mesh_definition.h>
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+// Locality orderings of the entities of one color. Each returns a
+// permutation in which entry i is the index of the entity that is placed
+// at position i, in the form expected by context_t::set_exclusive_order.
+//----------------------------------------------------------------------------//
+
+/*!
+  Return the reverse Cuthill-McKee ordering of a local graph. Each
+  connected component is ordered by a breadth-first traversal from one of
+  its entities of minimum degree, visiting neighbors in order of
+  increasing degree. Edges to entities outside of [0, graph.size()) are
+  ignored, so the graph may include off-color neighbors.
+
+  @param graph The adjacency graph of the entities, in local indices.
+
+  @ingroup coloring
+ */
+
+inline std::vector<size_t>
+rcm_order(const crs_t & graph) {
+  const size_t n = graph.size();
+
+  auto neighbors = [&](size_t i) {
+    return std::make_pair(graph.indices.begin() + graph.offsets[i],
+      graph.indices.begin() + graph.offsets[i + 1]);
+  };
+
+  std::vector<size_t> degree(n, 0);
+
+  for(size_t i(0); i < n; ++i) {
+    auto range = neighbors(i);
+    degree[i] = std::count_if(range.first, range.second,
+      [&](size_t j) { return j < n && j != i; });
+  } // for
+
+  std::vector<size_t> starts(n);
+  std::iota(starts.begin(), starts.end(), 0);
+  std::stable_sort(starts.begin(), starts.end(),
+    [&](size_t a, size_t b) { return degree[a] < degree[b]; });
+
+  std::vector<bool> visited(n, false);
+  std::vector<size_t> order;
+  order.reserve(n);
+
+  std::vector<size_t> next;
+
+  for(auto start : starts) {
+    if(visited[start]) {
+      continue;
+    } // if
+
+    visited[start] = true;
+    order.push_back(start);
+
+    // The order vector doubles as the breadth-first queue.
+    for(size_t head(order.size() - 1); head < order.size(); ++head) {
+      auto range = neighbors(order[head]);
+      next.clear();
+
+      for(auto it = range.first; it != range.second; ++it) {
+        if(*it < n && !visited[*it]) {
+          visited[*it] = true;
+          next.push_back(*it);
+        } // if
+      } // for
+
+      std::stable_sort(next.begin(), next.end(),
+        [&](size_t a, size_t b) { return degree[a] < degree[b]; });
+      order.insert(order.end(), next.begin(), next.end());
+    } // for
+  } // for
+
+  std::reverse(order.begin(), order.end());
+
+  return order;
+} // rcm_order
+
+/*!
+  Return the ordering of a set of points along the Hilbert curve through
+  their bounding box. Ties are kept in their original order.
+
+  @param points The points, e.g., the centroids of the entities.
+
+  @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+std::vector<size_t>
+hilbert_order(const std::vector<point_u<double, DIMENSION>> & points) {
+  using curve_t = hilbert_colorer_u<DIMENSION>;
+
+  const size_t n = points.size();
+
+  std::array<double, DIMENSION> lower, upper;
+  lower.fill(std::numeric_limits<double>::max());
+  upper.fill(std::numeric_limits<double>::lowest());
+
+  for(auto & p : points) {
+    for(size_t d(0); d < DIMENSION; ++d) {
+      lower[d] = std::min(lower[d], p[d]);
+      upper[d] = std::max(upper[d], p[d]);
+    } // for
+  } // for
+
+  std::vector<std::uint64_t> keys(n);
+
+  for(size_t i(0); i < n; ++i) {
+    std::array<std::uint64_t, DIMENSION> coords;
+
+    for(size_t d(0); d < DIMENSION; ++d) {
+      const double extent = upper[d] - lower[d];
+      const double x =
+        extent > 0.0 ? (points[i][d] - lower[d]) / extent : 0.0;
+      coords[d] = std::uint64_t(x * double(curve_t::max_coordinate));
+    } // for
+
+    keys[i] = curve_t::hilbert_index(coords);
+  } // for
+
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+    [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+  return order;
+} // hilbert_order
+
+/*!
+  Return the adjacency graph of the exclusive entities of an index
+  coloring, in which two entities are adjacent if they share a vertex.
+  Entities are numbered by their position in the exclusive set, i.e., in
+  id order, and only exclusive neighbors are included.
+
+  @param md        The mesh definition.
+  @param coloring  The index coloring of this rank.
+  @param dimension The topological dimension of the entities.
+
+  @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+crs_t
+exclusive_graph(const topology::mesh_definition_u<DIMENSION> & md,
+  const index_coloring_t & coloring,
+  size_t dimension) {
+  std::vector<std::vector<size_t>> vertices;
+  vertices.reserve(coloring.exclusive.size());
+
+  std::unordered_map<size_t, std::vector<size_t>> vertex_entities;
+
+  for(auto & e : coloring.exclusive) {
+    const size_t local = vertices.size();
+    vertices.emplace_back(md.entities(dimension, 0, e.id));
+
+    for(auto v : vertices.back()) {
+      vertex_entities[v].push_back(local);
+    } // for
+  } // for
+
+  crs_t graph;
+  graph.offsets.reserve(vertices.size() + 1);
+  graph.offsets.push_back(0);
+
+  std::vector<size_t> neighbors;
+
+  for(size_t i(0); i < vertices.size(); ++i) {
+    neighbors.clear();
+
+    for(auto v : vertices[i]) {
+      auto & entities = vertex_entities[v];
+      neighbors.insert(neighbors.end(), entities.begin(), entities.end());
+    } // for
+
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(
+      std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+    for(auto j : neighbors) {
+      if(j != i) {
+        graph.indices.push_back(j);
+      } // if
+    } // for
+
+    graph.offsets.push_back(graph.indices.size());
+  } // for
+
+  return graph;
+} // exclusive_graph
+
+} // namespace coloring
+} // namespace flecsi
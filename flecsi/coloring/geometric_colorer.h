@@ -0,0 +1,653 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <cinchlog.h>
+
+#include <flecsi-config.h>
+
+#if !defined(FLECSI_ENABLE_MPI)
+#error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include <flecsi/coloring/colorer.h>
+#include <flecsi/geometry/point.h>
+#include <flecsi/utils/mpi_comm.h>
+
+namespace flecsi {
+namespace coloring {
+
+/*!
+  The geometric_colorer_u type is the common base of the geometric
+  implementations of the colorer_t interface. These partition the entities
+  of a dcrs_t by the coordinates of their centroids, with optional
+  per-entity weights, and do not use the graph connectivity at all.
+
+  The centroids and weights are given for the entities that are local to
+  this rank in the dcrs_t, i.e., entity \em i has the global id
+  dcrs.distribution[rank] + i.
+
+  Partitions are computed with a distributed weighted splitter search, so
+  no rank ever holds more than its own entities. Ties between equal keys
+  are broken by global id, which keeps the parts balanced on structured
+  meshes where many centroids share a coordinate.
+
+  @tparam DIMENSION The dimension of the centroids.
+
+  @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+struct geometric_colorer_u : public colorer_t {
+
+  using point_t = point_u<double, DIMENSION>;
+
+  /*!
+    Constructor.
+
+    @param centroids The centroids of the local entities.
+    @param weights   The weights of the local entities. If empty, every
+                     entity has unit weight.
+   */
+
+  geometric_colorer_u(const std::vector<point_t> & centroids,
+    const std::vector<double> & weights = {})
+    : centroids_(centroids), weights_(weights) {
+    if(weights_.empty()) {
+      weights_.resize(centroids_.size(), 1.0);
+    } // if
+
+    clog_assert(weights_.size() == centroids_.size(),
+      "number of weights does not match the number of centroids");
+  } // geometric_colorer_u
+
+  /*!
+    Implementation of color method. See \ref colorer_t::color.
+   */
+
+  std::set<size_t> color(const dcrs_t & dcrs) override {
+    int rank;
+    MPI_Comm_rank(utils::mpi_comm(), &rank);
+
+    std::vector<size_t> ids(dcrs.size());
+    std::iota(ids.begin(), ids.end(), dcrs.distribution[rank]);
+
+    return exchange_parts(new_color(dcrs), ids);
+  } // color
+
+  /*!
+    Compute a new primary coloring from the current one, e.g., to rebalance
+    a run with measured per-entity costs. The centroids and weights passed
+    to the constructor are those of the entities of \em primary, in order.
+    Since the keys of the entities depend only on their centroids, the
+    new parts are close to the old ones when the weights change little.
+
+    @param primary The current primary coloring of this rank.
+
+    @return The new primary coloring of this rank.
+   */
+
+  std::set<size_t> recolor(const std::set<size_t> & primary) {
+    int size, rank;
+    MPI_Comm_size(utils::mpi_comm(), &size);
+    MPI_Comm_rank(utils::mpi_comm(), &rank);
+
+    // The splitter search only uses the distribution of the dcrs_t to
+    // break ties, so a dcrs_t without edges is sufficient.
+    dcrs_t dcrs;
+    dcrs.distribution.resize(size + 1, 0);
+    dcrs.offsets.resize(primary.size() + 1, 0);
+
+    size_t local = primary.size();
+    MPI_Allgather(&local, 1, MPI_UNSIGNED_LONG_LONG,
+      dcrs.distribution.data() + 1, 1, MPI_UNSIGNED_LONG_LONG,
+      utils::mpi_comm());
+    std::partial_sum(dcrs.distribution.begin(), dcrs.distribution.end(),
+      dcrs.distribution.begin());
+
+    return exchange_parts(new_color(dcrs),
+      std::vector<size_t>(primary.begin(), primary.end()));
+  } // recolor
+
+protected:
+  static_assert(sizeof(size_t) == sizeof(unsigned long long),
+    "MPI_UNSIGNED_LONG_LONG is used for size_t");
+
+  /*!
+    A composite sort key: the partitioning key and the global id.
+   */
+
+  using key_t = std::pair<std::uint64_t, std::uint64_t>;
+
+  /*!
+    Send the global id \em ids[i] of each local entity to the rank
+    \em part[i], and return the ids received by this rank.
+   */
+
+  static std::set<size_t> exchange_parts(const std::vector<size_t> & part,
+    const std::vector<size_t> & ids) {
+    int size;
+    MPI_Comm_size(utils::mpi_comm(), &size);
+
+    std::vector<int> send_cnts(size, 0);
+
+    for(auto p : part) {
+      ++send_cnts[p];
+    } // for
+
+    std::vector<int> send_displs(size + 1, 0);
+    std::partial_sum(
+      send_cnts.begin(), send_cnts.end(), send_displs.begin() + 1);
+
+    std::vector<size_t> send_ids(part.size());
+    std::vector<int> fill(send_displs.begin(), send_displs.end() - 1);
+
+    for(size_t i(0); i < part.size(); ++i) {
+      send_ids[fill[part[i]]++] = ids[i];
+    } // for
+
+    std::vector<int> recv_cnts(size);
+    MPI_Alltoall(send_cnts.data(), 1, MPI_INT, recv_cnts.data(), 1, MPI_INT,
+      utils::mpi_comm());
+
+    std::vector<int> recv_displs(size + 1, 0);
+    std::partial_sum(
+      recv_cnts.begin(), recv_cnts.end(), recv_displs.begin() + 1);
+
+    std::vector<size_t> recv_ids(recv_displs[size]);
+    MPI_Alltoallv(send_ids.data(), send_cnts.data(), send_displs.data(),
+      MPI_UNSIGNED_LONG_LONG, recv_ids.data(), recv_cnts.data(),
+      recv_displs.data(), MPI_UNSIGNED_LONG_LONG, utils::mpi_comm());
+
+    std::set<size_t> primary(recv_ids.begin(), recv_ids.end());
+
+    clog_assert(primary.size() > 0,
+      "At least one rank has an empty primary coloring. Please either "
+      "increase the problem size or use fewer ranks");
+
+    return primary;
+  } // exchange_parts
+
+  /*!
+    Find weighted splitters within groups of entities.
+
+    Entity \em i belongs to group \em group[i] and is ordered within its
+    group by \em keys[i]. Splitter \em s belongs to group \em split_group[s]
+    and is the smallest key such that the total weight of the entities of
+    the group with keys not greater than it is at least \em targets[s].
+    This is collective, and every rank must pass the same splitter groups
+    and targets.
+   */
+
+  std::vector<key_t> find_splitters(const std::vector<size_t> & group,
+    const std::vector<key_t> & keys,
+    const std::vector<size_t> & split_group,
+    const std::vector<double> & targets) const {
+
+    const size_t n = keys.size();
+    const size_t nsplits = targets.size();
+
+    // Sort the local entities by group and key, with running weights, so
+    // that the weight below any key is a binary search.
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return std::tie(group[a], keys[a]) < std::tie(group[b], keys[b]);
+    });
+
+    std::vector<size_t> sorted_group(n);
+    std::vector<key_t> sorted_keys(n);
+    std::vector<double> prefix(n + 1, 0.0);
+
+    for(size_t i(0); i < n; ++i) {
+      sorted_group[i] = group[order[i]];
+      sorted_keys[i] = keys[order[i]];
+      prefix[i + 1] = prefix[i] + weights_[order[i]];
+    } // for
+
+    auto weight_below = [&](size_t g, const key_t & key) {
+      auto first =
+        std::lower_bound(sorted_group.begin(), sorted_group.end(), g) -
+        sorted_group.begin();
+      auto last =
+        std::upper_bound(sorted_group.begin(), sorted_group.end(), g) -
+        sorted_group.begin();
+      auto pos = std::upper_bound(sorted_keys.begin() + first,
+                   sorted_keys.begin() + last, key) -
+                 sorted_keys.begin();
+      return prefix[pos] - prefix[first];
+    };
+
+    std::vector<key_t> lo(nsplits, key_t(0, 0));
+    std::vector<key_t> hi(nsplits, key_t(max_key, max_key));
+    std::vector<double> local(nsplits);
+    std::vector<double> global(nsplits);
+
+    // Bisection over the 128-bit composite keys. The bounds are identical
+    // on every rank, so all ranks leave the loop together.
+    for(size_t iteration(0); iteration < 128; ++iteration) {
+      if(lo == hi) {
+        break;
+      } // if
+
+      for(size_t s(0); s < nsplits; ++s) {
+        local[s] = weight_below(split_group[s], midpoint(lo[s], hi[s]));
+      } // for
+
+      MPI_Allreduce(local.data(), global.data(), nsplits, MPI_DOUBLE, MPI_SUM,
+        utils::mpi_comm());
+
+      for(size_t s(0); s < nsplits; ++s) {
+        if(lo[s] == hi[s]) {
+          continue;
+        } // if
+
+        auto mid = midpoint(lo[s], hi[s]);
+
+        if(global[s] >= targets[s]) {
+          hi[s] = mid;
+        }
+        else {
+          lo[s] = next(mid);
+        } // if
+      } // for
+    } // for
+
+    return hi;
+  } // find_splitters
+
+  /*!
+    Return the global id of the first local entity of \em dcrs.
+   */
+
+  static std::uint64_t first_id(const dcrs_t & dcrs) {
+    int rank;
+    MPI_Comm_rank(utils::mpi_comm(), &rank);
+    return dcrs.distribution[rank];
+  } // first_id
+
+  /*!
+    Compute the global bounding box of the centroids of each of
+    \em ngroups groups, where local entity \em i belongs to \em group[i].
+   */
+
+  void bounding_boxes(const std::vector<size_t> & group,
+    size_t ngroups,
+    std::vector<point_t> & lower,
+    std::vector<point_t> & upper) const {
+    // Reduce with MPI_MIN over the lower bounds and negated upper bounds.
+    std::vector<double> local(2 * DIMENSION * ngroups,
+      std::numeric_limits<double>::max());
+    std::vector<double> global(local.size());
+
+    for(size_t i(0); i < centroids_.size(); ++i) {
+      double * box = &local[2 * DIMENSION * group[i]];
+
+      for(size_t d(0); d < DIMENSION; ++d) {
+        box[d] = std::min(box[d], centroids_[i][d]);
+        box[DIMENSION + d] = std::min(box[DIMENSION + d], -centroids_[i][d]);
+      } // for
+    } // for
+
+    MPI_Allreduce(local.data(), global.data(), local.size(), MPI_DOUBLE,
+      MPI_MIN, utils::mpi_comm());
+
+    lower.resize(ngroups);
+    upper.resize(ngroups);
+
+    for(size_t g(0); g < ngroups; ++g) {
+      for(size_t d(0); d < DIMENSION; ++d) {
+        lower[g][d] = global[2 * DIMENSION * g + d];
+        upper[g][d] = -global[2 * DIMENSION * g + DIMENSION + d];
+      } // for
+    } // for
+  } // bounding_boxes
+
+  std::vector<point_t> centroids_;
+  std::vector<double> weights_;
+
+private:
+  static constexpr std::uint64_t max_key =
+    std::numeric_limits<std::uint64_t>::max();
+
+  /*!
+    Return the floor of the mean of two keys, as 128-bit integers.
+   */
+
+  static key_t midpoint(const key_t & lo, const key_t & hi) {
+    // half = (hi - lo) / 2
+    const std::uint64_t borrow = hi.second < lo.second;
+    const std::uint64_t diff_first = hi.first - lo.first - borrow;
+    const std::uint64_t diff_second = hi.second - lo.second;
+    const std::uint64_t half_first = diff_first >> 1;
+    const std::uint64_t half_second = (diff_second >> 1) | (diff_first << 63);
+
+    // lo + half
+    const std::uint64_t second = lo.second + half_second;
+    const std::uint64_t carry = second < lo.second;
+
+    return key_t(lo.first + half_first + carry, second);
+  } // midpoint
+
+  /*!
+    Return the key that follows \em key, as a 128-bit integer.
+   */
+
+  static key_t next(const key_t & key) {
+    return key.second == max_key ? key_t(key.first + 1, 0)
+                                 : key_t(key.first, key.second + 1);
+  } // next
+
+}; // struct geometric_colorer_u
+
+/*!
+  The rcb_colorer_u type provides a recursive coordinate bisection
+  implementation of the colorer_t interface. Each part is recursively
+  split at the weighted median of its centroids along its longest
+  extent, in proportion to the number of ranks on each side, so any
+  number of ranks is supported. All parts at one level of the recursion
+  are split together.
+
+  @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+struct rcb_colorer_u : public geometric_colorer_u<DIMENSION> {
+
+  using base_t = geometric_colorer_u<DIMENSION>;
+  using typename base_t::key_t;
+  using typename base_t::point_t;
+  using base_t::base_t;
+
+  /*!
+   Implementation of new_color method. See \ref colorer_t::new_color.
+   */
+
+  std::vector<size_t> new_color(const dcrs_t & dcrs) override {
+    int size;
+    MPI_Comm_size(utils::mpi_comm(), &size);
+
+    const size_t n = this->centroids_.size();
+    const std::uint64_t offset = this->first_id(dcrs);
+
+    clog_assert(n == dcrs.size(),
+      "number of centroids does not match the dcrs size");
+
+    // Each tree node is a half-open range of parts. Every entity starts in
+    // the root, which covers all parts.
+    std::vector<std::pair<size_t, size_t>> nodes{{0, size_t(size)}};
+    std::vector<size_t> node(n, 0);
+
+    std::vector<double> local_weight;
+    std::vector<double> global_weight;
+    std::vector<key_t> keys(n);
+    std::vector<point_t> lower, upper;
+
+    while(std::any_of(nodes.begin(), nodes.end(),
+      [](const auto & p) { return p.second - p.first > 1; })) {
+
+      const size_t nnodes = nodes.size();
+
+      this->bounding_boxes(node, nnodes, lower, upper);
+
+      local_weight.assign(nnodes, 0.0);
+      global_weight.resize(nnodes);
+
+      for(size_t i(0); i < n; ++i) {
+        local_weight[node[i]] += this->weights_[i];
+      } // for
+
+      MPI_Allreduce(local_weight.data(), global_weight.data(), nnodes,
+        MPI_DOUBLE, MPI_SUM, utils::mpi_comm());
+
+      // Split each node along its longest extent.
+      std::vector<size_t> axis(nnodes, 0);
+      std::vector<size_t> split_group;
+      std::vector<double> targets;
+
+      for(size_t g(0); g < nnodes; ++g) {
+        for(size_t d(1); d < DIMENSION; ++d) {
+          if(upper[g][d] - lower[g][d] >
+             upper[g][axis[g]] - lower[g][axis[g]]) {
+            axis[g] = d;
+          } // if
+        } // for
+
+        const auto & p = nodes[g];
+        const size_t mid = p.first + (p.second - p.first) / 2;
+
+        split_group.push_back(g);
+        targets.push_back(global_weight[g] * double(mid - p.first) /
+                          double(p.second - p.first));
+      } // for
+
+      for(size_t i(0); i < n; ++i) {
+        keys[i] = key_t(
+          ordered_bits(this->centroids_[i][axis[node[i]]]), offset + i);
+      } // for
+
+      auto splitters = this->find_splitters(node, keys, split_group, targets);
+
+      // Create the children. Nodes with a single part are kept as leaves.
+      std::vector<std::pair<size_t, size_t>> children;
+      std::vector<std::pair<size_t, size_t>> child_of(nnodes);
+
+      for(size_t g(0); g < nnodes; ++g) {
+        const auto & p = nodes[g];
+
+        if(p.second - p.first > 1) {
+          const size_t mid = p.first + (p.second - p.first) / 2;
+          child_of[g] = {children.size(), children.size() + 1};
+          children.emplace_back(p.first, mid);
+          children.emplace_back(mid, p.second);
+        }
+        else {
+          child_of[g] = {children.size(), children.size()};
+          children.push_back(p);
+        } // if
+      } // for
+
+      for(size_t i(0); i < n; ++i) {
+        const size_t g = node[i];
+        node[i] =
+          keys[i] <= splitters[g] ? child_of[g].first : child_of[g].second;
+      } // for
+
+      nodes = std::move(children);
+    } // while
+
+    std::vector<size_t> partitioning(n);
+
+    for(size_t i(0); i < n; ++i) {
+      partitioning[i] = nodes[node[i]].first;
+    } // for
+
+    return partitioning;
+  } // new_color
+
+private:
+  /*!
+    Map a double to an unsigned integer with the same ordering.
+   */
+
+  static std::uint64_t ordered_bits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const std::uint64_t sign = std::uint64_t(1) << 63;
+    return bits & sign ? ~bits : bits | sign;
+  } // ordered_bits
+
+}; // struct rcb_colorer_u
+
+/*!
+  The hilbert_colorer_u type provides a Hilbert space-filling curve
+  implementation of the colorer_t interface. The centroids are quantized
+  on the global bounding box and ordered along the curve, which is then
+  cut into contiguous pieces of equal weight.
+
+  @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+struct hilbert_colorer_u : public geometric_colorer_u<DIMENSION> {
+
+  using base_t = geometric_colorer_u<DIMENSION>;
+  using typename base_t::key_t;
+  using typename base_t::point_t;
+  using base_t::base_t;
+
+  /*!
+   Implementation of new_color method. See \ref colorer_t::new_color.
+   */
+
+  std::vector<size_t> new_color(const dcrs_t & dcrs) override {
+    int size;
+    MPI_Comm_size(utils::mpi_comm(), &size);
+
+    const size_t n = this->centroids_.size();
+    const std::uint64_t offset = this->first_id(dcrs);
+
+    clog_assert(n == dcrs.size(),
+      "number of centroids does not match the dcrs size");
+
+    std::vector<size_t> group(n, 0);
+    std::vector<point_t> lower, upper;
+    this->bounding_boxes(group, 1, lower, upper);
+
+    double local_weight{0.0};
+    double global_weight;
+
+    for(auto w : this->weights_) {
+      local_weight += w;
+    } // for
+
+    MPI_Allreduce(&local_weight, &global_weight, 1, MPI_DOUBLE, MPI_SUM,
+      utils::mpi_comm());
+
+    std::vector<key_t> keys(n);
+
+    for(size_t i(0); i < n; ++i) {
+      std::array<std::uint64_t, DIMENSION> coords;
+
+      for(size_t d(0); d < DIMENSION; ++d) {
+        const double extent = upper[0][d] - lower[0][d];
+        const double x = extent > 0.0
+                           ? (this->centroids_[i][d] - lower[0][d]) / extent
+                           : 0.0;
+        coords[d] = std::uint64_t(x * double(max_coordinate));
+      } // for
+
+      keys[i] = key_t(hilbert_index(coords), offset + i);
+    } // for
+
+    // Cut the curve into size pieces of equal weight.
+    std::vector<size_t> split_group(size - 1, 0);
+    std::vector<double> targets(size - 1);
+
+    for(size_t s(0); s < targets.size(); ++s) {
+      targets[s] = global_weight * double(s + 1) / double(size);
+    } // for
+
+    auto splitters = this->find_splitters(group, keys, split_group, targets);
+
+    std::vector<size_t> partitioning(n);
+
+    for(size_t i(0); i < n; ++i) {
+      partitioning[i] =
+        std::lower_bound(splitters.begin(), splitters.end(), keys[i]) -
+        splitters.begin();
+    } // for
+
+    return partitioning;
+  } // new_color
+
+  //! The number of bits per coordinate.
+  static constexpr size_t bits = 64 / DIMENSION > 32 ? 32 : 64 / DIMENSION;
+
+  static constexpr std::uint64_t max_coordinate =
+    (std::uint64_t(1) << bits) - 1;
+
+  /*!
+    Return the index of a point along the Hilbert curve, using Skilling's
+    transpose algorithm. Each coordinate has \em bits bits.
+   */
+
+  static std::uint64_t hilbert_index(std::array<std::uint64_t, DIMENSION> x) {
+    if constexpr(DIMENSION == 1) {
+      return x[0];
+    } // if
+
+    // Inverse undo of the excess work.
+    for(std::uint64_t q = std::uint64_t(1) << (bits - 1); q > 1; q >>= 1) {
+      const std::uint64_t p = q - 1;
+
+      for(size_t d(0); d < DIMENSION; ++d) {
+        if(x[d] & q) {
+          x[0] ^= p;
+        }
+        else {
+          const std::uint64_t t = (x[0] ^ x[d]) & p;
+          x[0] ^= t;
+          x[d] ^= t;
+        } // if
+      } // for
+    } // for
+
+    // Gray encode.
+    for(size_t d(1); d < DIMENSION; ++d) {
+      x[d] ^= x[d - 1];
+    } // for
+
+    std::uint64_t t{0};
+    for(std::uint64_t q = std::uint64_t(1) << (bits - 1); q > 1; q >>= 1) {
+      if(x[DIMENSION - 1] & q) {
+        t ^= q - 1;
+      } // if
+    } // for
+
+    for(size_t d(0); d < DIMENSION; ++d) {
+      x[d] ^= t;
+    } // for
+
+    // Interleave the transposed bits, most significant first.
+    std::uint64_t index{0};
+    for(size_t b(bits); b-- > 0;) {
+      for(size_t d(0); d < DIMENSION; ++d) {
+        index = (index << 1) | ((x[d] >> b) & 1);
+      } // for
+    } // for
+
+    return index;
+  } // hilbert_index
+
+}; // struct hilbert_colorer_u
+
+} // namespace coloring
+} // namespace flecsi
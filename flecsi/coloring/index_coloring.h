@@ -20,31 +20,38 @@
 #include <vector>
 
 #include <flecsi/coloring/communicator.h>
+#include <flecsi/utils/flat_set.h>
 
 namespace flecsi {
 namespace coloring {
 
 /*!
-  FIXME Add description.
+  The coloring of an index space for one color. The entity sets are
+  sorted arrays rather than trees, so that they use little more memory
+  than the entities themselves and can be traversed and indexed
+  efficiently. They are best built in increasing id order, or in bulk
+  with a range insert.
  */
 struct index_coloring_t {
   using entity_info_t = flecsi::coloring::entity_info_t;
+  using index_set_t = utils::flat_set_u<size_t>;
+  using entity_set_t = utils::flat_set_u<entity_info_t>;
 
   //------------------------------------------------------------------------//
   // Data members.
   //------------------------------------------------------------------------//
 
   // Set of mesh ids of the primary coloring
-  std::set<size_t> primary;
+  index_set_t primary;
 
   // Set of entity_info_t type of the exclusive coloring
-  std::set<entity_info_t> exclusive;
+  entity_set_t exclusive;
 
   // Set of entity_info_t type of the shared coloring
-  std::set<entity_info_t> shared;
+  entity_set_t shared;
 
   // Set of entity_info_t type of the ghost coloring
-  std::set<entity_info_t> ghost;
+  entity_set_t ghost;
 
   // Rank id to number of entities
   std::unordered_map<size_t, size_t> entities_per_rank;
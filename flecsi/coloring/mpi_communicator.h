@@ -24,6 +24,7 @@
 #include <mpi.h>
 
 #include <flecsi/coloring/communicator.h>
+#include <flecsi/utils/mpi_comm.h>
 #include <flecsi/utils/mpi_type_traits.h>
 #include <flecsi/utils/set_utils.h>
 
@@ -39,8 +40,9 @@ namespace coloring {
 class mpi_communicator_t : public communicator_t
 {
 public:
-  /// Default constructor
-  mpi_communicator_t() {}
+  /// Constructor. The communicator defaults to the one of the runtime.
+  explicit mpi_communicator_t(MPI_Comm comm = utils::mpi_comm())
+    : comm_(comm) {}
 
   /// Copy constructor (disabled)
   mpi_communicator_t(const mpi_communicator_t &) = delete;
@@ -58,7 +60,7 @@ public:
 
   size_t size() const override {
     int num;
-    MPI_Comm_size(MPI_COMM_WORLD, &num);
+    MPI_Comm_size(comm_, &num);
     return num;
   }
 
@@ -69,7 +71,7 @@ public:
 
   size_t rank() const override {
     int rk;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rk);
+    MPI_Comm_rank(comm_, &rk);
     return rk;
   }
 
@@ -78,13 +80,13 @@ public:
    */
 
   void barrier() const override {
-    auto ret = MPI_Barrier(MPI_COMM_WORLD);
+    auto ret = MPI_Barrier(comm_);
   };
 
   /*!
    Reduces info_indices from all MPI ranks
 
-   @param request_indices  std::set of shared, ghost etc
+   @param request_indices  sorted set of shared, ghost etc
    @param max_request_indices Maximum # of indices per rank
    @param colors Number of MPI ranks
 
@@ -94,7 +96,8 @@ public:
    @ingroup coloring
    */
 
-  std::vector<size_t> get_info_indices(const std::set<size_t> & request_indices,
+  template<typename SET>
+  std::vector<size_t> get_info_indices(const SET & request_indices,
     size_t max_request_indices,
     int colors) {
     // Pad the request indices with size_t max. We will then set
@@ -121,7 +124,7 @@ public:
     // Send the request indices to all other ranks.
     int result =
       MPI_Alltoall(&input_indices[0], max_request_indices, mpi_size_t_type,
-        &info_indices[0], max_request_indices, mpi_size_t_type, MPI_COMM_WORLD);
+        &info_indices[0], max_request_indices, mpi_size_t_type, comm_);
 
     return info_indices;
   } // get_info_indices
@@ -139,7 +142,7 @@ public:
   */
 
   std::pair<std::vector<std::set<size_t>>, std::set<entity_info_t>>
-  get_primary_info(const std::set<size_t> & primary,
+  get_primary_info(const utils::flat_set_u<size_t> & primary,
     const std::set<size_t> & request_indices) override {
     auto colors = size();
     auto color = rank();
@@ -216,12 +219,12 @@ public:
     // Send the indices information back to all ranks.
     int result =
       MPI_Alltoall(&input_indices[0], max_request_indices, mpi_size_t_type,
-        &info_indices[0], max_request_indices, mpi_size_t_type, MPI_COMM_WORLD);
+        &info_indices[0], max_request_indices, mpi_size_t_type, comm_);
 
     // Send the offsets information back to all ranks.
     result =
       MPI_Alltoall(&input_offsets[0], max_request_indices, mpi_size_t_type,
-        &info_offsets[0], max_request_indices, mpi_size_t_type, MPI_COMM_WORLD);
+        &info_offsets[0], max_request_indices, mpi_size_t_type, comm_);
 
     std::set<entity_info_t> remote;
 
@@ -352,7 +355,7 @@ public:
    */
 
   std::unordered_map<size_t, std::set<size_t>> get_entity_reduction(
-    const std::set<size_t> & local_indices) override {
+    const utils::flat_set_u<size_t> & local_indices) override {
     auto colors = size();
     auto color = rank();
 
@@ -411,7 +414,7 @@ public:
     std::vector<size_t> recv_cnts(colors);
     int result = MPI_Alltoall(&send_cnts[0], 1,
       utils::mpi_typetraits_u<size_t>::type(), &recv_cnts[0], 1,
-      utils::mpi_typetraits_u<size_t>::type(), MPI_COMM_WORLD);
+      utils::mpi_typetraits_u<size_t>::type(), comm_);
 
     // Start receive operations (non-blocking).
     std::vector<std::vector<size_t>> rbuffers(colors);
@@ -421,7 +424,7 @@ public:
         rbuffers[r].resize(recv_cnts[r]);
         requests.push_back({});
         MPI_Irecv(&rbuffers[r][0], recv_cnts[r],
-          utils::mpi_typetraits_u<size_t>::type(), r, 0, MPI_COMM_WORLD,
+          utils::mpi_typetraits_u<size_t>::type(), r, 0, comm_,
           &requests[requests.size() - 1]);
       } // if
     } // for
@@ -434,7 +437,7 @@ public:
           std::back_inserter(sbuffers[r]));
 
         MPI_Send(&sbuffers[r][0], send_cnts[r],
-          utils::mpi_typetraits_u<size_t>::type(), r, 0, MPI_COMM_WORLD);
+          utils::mpi_typetraits_u<size_t>::type(), r, 0, comm_);
       } // if
     } // for
 
@@ -471,7 +474,7 @@ public:
         rbuffers[r].resize(send_cnts[r], 0);
         requests.push_back({});
         MPI_Irecv(&rbuffers[r][0], send_cnts[r],
-          utils::mpi_typetraits_u<size_t>::type(), r, 0, MPI_COMM_WORLD,
+          utils::mpi_typetraits_u<size_t>::type(), r, 0, comm_,
           &requests[requests.size() - 1]);
       } // if
     } // for
@@ -481,7 +484,7 @@ public:
       // If we received a request, prepare to send an answer.
       if(recv_cnts[r]) {
         MPI_Send(&sbuffers[r][0], recv_cnts[r],
-          utils::mpi_typetraits_u<size_t>::type(), r, 0, MPI_COMM_WORLD);
+          utils::mpi_typetraits_u<size_t>::type(), r, 0, comm_);
       } // if
     } // for
 
@@ -513,7 +516,7 @@ public:
   std::vector<size_t> gather_sizes(const size_t & size) override {
     int colors;
 
-    MPI_Comm_size(MPI_COMM_WORLD, &colors);
+    MPI_Comm_size(comm_, &colors);
 
     std::vector<size_t> buffer(colors);
 
@@ -521,7 +524,7 @@ public:
       flecsi::utils::mpi_typetraits_u<size_t>::type();
 
     int result = MPI_Allgather(&size, 1, mpi_size_t_type, buffer.data(), 1,
-      mpi_size_t_type, MPI_COMM_WORLD);
+      mpi_size_t_type, comm_);
 
     return buffer;
   } // gather_sizes
@@ -536,8 +539,8 @@ public:
    @ingroup coloring
    */
 
-  template<typename Lambda>
-  void alltoall_coloring_info(std::set<size_t> & request_indices,
+  template<typename SET, typename Lambda>
+  void alltoall_coloring_info(const SET & request_indices,
     Lambda && function) {
     auto colors = size();
     auto color = rank();
@@ -590,7 +593,7 @@ public:
     const size_t bytes = sizeof(size_info_t);
 
     int result = MPI_Allgather(
-      &color_info, bytes, MPI_BYTE, &buffer, bytes, MPI_BYTE, MPI_COMM_WORLD);
+      &color_info, bytes, MPI_BYTE, &buffer, bytes, MPI_BYTE, comm_);
 
     std::unordered_map<size_t, coloring_info_t> coloring_info;
 
@@ -633,12 +636,13 @@ public:
     // to determine the maximum number of indices requested by any rank
     // so that we can pad out the all-to-all communication below.
     int result = MPI_Allreduce(&request_indices, &max_request_indices, 1,
-      mpi_size_t_type, MPI_MAX, MPI_COMM_WORLD);
+      mpi_size_t_type, MPI_MAX, comm_);
 
     return max_request_indices;
   } // get_max_request_size
 
 private:
+  MPI_Comm comm_;
 }; // class mpi_communicator_t
 
 } // namespace coloring
@@ -28,6 +28,7 @@
 #include <parmetis.h>
 
 #include <flecsi/coloring/colorer.h>
+#include <flecsi/utils/mpi_comm.h>
 #include <flecsi/utils/mpi_type_traits.h>
 
 namespace flecsi {
@@ -67,8 +68,8 @@ struct parmetis_colorer_t : public colorer_t {
     int size;
     int rank;
 
-    MPI_Comm_size(MPI_COMM_WORLD, &size);
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(utils::mpi_comm(), &size);
+    MPI_Comm_rank(utils::mpi_comm(), &rank);
 
     //------------------------------------------------------------------------//
     // Call ParMETIS partitioner.
@@ -100,7 +101,7 @@ struct parmetis_colorer_t : public colorer_t {
     real_t ubvec = 1.05;
     idx_t options = 0;
     idx_t edgecut;
-    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm comm = utils::mpi_comm();
     std::vector<idx_t> part(dcrs.size(), std::numeric_limits<idx_t>::max());
 
 #if 0
@@ -178,7 +179,7 @@ struct parmetis_colorer_t : public colorer_t {
     std::vector<idx_t> recv_cnts(size);
     result = MPI_Alltoall(&send_cnts[0], 1,
       utils::mpi_typetraits_u<idx_t>::type(), &recv_cnts[0], 1,
-      utils::mpi_typetraits_u<idx_t>::type(), MPI_COMM_WORLD);
+      utils::mpi_typetraits_u<idx_t>::type(), utils::mpi_comm());
 
 #if 0
     if(rank == 0) {
@@ -200,7 +201,7 @@ struct parmetis_colorer_t : public colorer_t {
         rbuffers[r].resize(recv_cnts[r]);
         requests.push_back({});
         MPI_Irecv(&rbuffers[r][0], recv_cnts[r],
-          utils::mpi_typetraits_u<idx_t>::type(), r, 0, MPI_COMM_WORLD,
+          utils::mpi_typetraits_u<idx_t>::type(), r, 0, utils::mpi_comm(),
           &requests[requests.size() - 1]);
       } // if
     } // for
@@ -210,7 +211,7 @@ struct parmetis_colorer_t : public colorer_t {
       if(send_cnts[r]) {
         sbuffers[r].resize(send_cnts[r]);
         MPI_Send(&sbuffers[r][0], send_cnts[r],
-          utils::mpi_typetraits_u<idx_t>::type(), r, 0, MPI_COMM_WORLD);
+          utils::mpi_typetraits_u<idx_t>::type(), r, 0, utils::mpi_comm());
       } // if
     } // for
 
@@ -252,8 +253,8 @@ struct parmetis_colorer_t : public colorer_t {
     int size;
     int rank;
 
-    MPI_Comm_size(MPI_COMM_WORLD, &size);
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(utils::mpi_comm(), &size);
+    MPI_Comm_rank(utils::mpi_comm(), &rank);
 
     //------------------------------------------------------------------------//
     // Call ParMETIS partitioner.
@@ -268,7 +269,7 @@ struct parmetis_colorer_t : public colorer_t {
     std::vector<real_t> ubvec(ncon, 1.05);
     idx_t options[3] = {0, 0, 0};
     idx_t edgecut;
-    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm comm = utils::mpi_comm();
     std::vector<idx_t> part(dcrs.size(), std::numeric_limits<idx_t>::max());
 
     // Get the dCRS information using ParMETIS types.
@@ -0,0 +1,307 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cinchlog.h>
+
+#include <flecsi-config.h>
+
+#if !defined(FLECSI_ENABLE_MPI)
+#error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include <flecsi/coloring/index_coloring.h>
+#include <flecsi/utils/mpi_comm.h>
+
+namespace flecsi {
+namespace coloring {
+
+/*!
+  The migration_plan_t type describes how to move the data of an index
+  space from one index coloring to another, e.g., after a repartition.
+  Positions refer to the local storage of an index coloring, which holds
+  the exclusive, shared, and ghost entities, in that order. Every entity
+  of the new coloring, including its ghosts, receives the data of the
+  exclusive or shared copy of the entity in the old coloring.
+
+  @ingroup coloring
+ */
+
+struct migration_plan_t {
+
+  //! The storage size of the old coloring of this rank.
+  size_t old_size = 0;
+
+  //! The storage size of the new coloring of this rank.
+  size_t new_size = 0;
+
+  //! For each rank, the old positions of the entities sent to it.
+  std::vector<std::vector<size_t>> send_positions;
+
+  //! For each rank, the new positions of the entities received from it,
+  //! in the order in which they are sent.
+  std::vector<std::vector<size_t>> recv_positions;
+
+}; // struct migration_plan_t
+
+namespace detail {
+
+static_assert(sizeof(size_t) == sizeof(unsigned long long),
+  "MPI_UNSIGNED_LONG_LONG is used for size_t");
+
+/*!
+  Send \em send[r] to each rank \em r and return the values received from
+  each rank.
+ */
+
+inline std::vector<std::vector<size_t>>
+alltoallv(const std::vector<std::vector<size_t>> & send) {
+  const size_t size = send.size();
+
+  std::vector<int> send_cnts(size);
+  std::vector<int> send_displs(size + 1, 0);
+
+  for(size_t r(0); r < size; ++r) {
+    send_cnts[r] = send[r].size();
+    send_displs[r + 1] = send_displs[r] + send_cnts[r];
+  } // for
+
+  std::vector<size_t> send_buffer;
+  send_buffer.reserve(send_displs[size]);
+
+  for(auto & s : send) {
+    send_buffer.insert(send_buffer.end(), s.begin(), s.end());
+  } // for
+
+  std::vector<int> recv_cnts(size);
+  MPI_Alltoall(send_cnts.data(), 1, MPI_INT, recv_cnts.data(), 1, MPI_INT,
+    utils::mpi_comm());
+
+  std::vector<int> recv_displs(size + 1, 0);
+  std::partial_sum(recv_cnts.begin(), recv_cnts.end(), recv_displs.begin() + 1);
+
+  std::vector<size_t> recv_buffer(recv_displs[size]);
+  MPI_Alltoallv(send_buffer.data(), send_cnts.data(), send_displs.data(),
+    MPI_UNSIGNED_LONG_LONG, recv_buffer.data(), recv_cnts.data(),
+    recv_displs.data(), MPI_UNSIGNED_LONG_LONG, utils::mpi_comm());
+
+  std::vector<std::vector<size_t>> recv(size);
+
+  for(size_t r(0); r < size; ++r) {
+    recv[r].assign(recv_buffer.begin() + recv_displs[r],
+      recv_buffer.begin() + recv_displs[r + 1]);
+  } // for
+
+  return recv;
+} // alltoallv
+
+} // namespace detail
+
+/*!
+  Return the ids of the entities of an index coloring in the default
+  storage order, i.e., the exclusive, shared, and ghost entities, each in
+  id order.
+ */
+
+inline std::vector<size_t>
+storage_ids(const index_coloring_t & coloring) {
+  std::vector<size_t> ids;
+  ids.reserve(
+    coloring.exclusive.size() + coloring.shared.size() + coloring.ghost.size());
+
+  for(auto & entities :
+    {&coloring.exclusive, &coloring.shared, &coloring.ghost}) {
+    for(auto & e : *entities) {
+      ids.push_back(e.id);
+    } // for
+  } // for
+
+  return ids;
+} // storage_ids
+
+/*!
+  Compute the plan to migrate the data of an index space from one local
+  storage layout to another. The old owner of each entity is found
+  through a distributed directory, in which the entity with id \em i is
+  registered on rank i % size, so no rank holds more than its share of
+  the global ids. This is collective.
+
+  @param from  The ids of the old local storage of this rank.
+  @param owned The number of exclusive and shared entities at the front
+               of \em from, i.e., the entities owned by this rank.
+  @param to    The ids of the new local storage of this rank.
+ */
+
+inline migration_plan_t
+make_migration_plan(const std::vector<size_t> & from,
+  size_t owned,
+  const std::vector<size_t> & to) {
+  int size;
+  MPI_Comm_size(utils::mpi_comm(), &size);
+
+  migration_plan_t plan;
+  plan.old_size = from.size();
+  plan.new_size = to.size();
+
+  // Register the old positions of the entities owned by this rank with
+  // the directory as (id, position) pairs.
+  std::vector<std::vector<size_t>> registrations(size);
+
+  for(size_t position(0); position < owned; ++position) {
+    auto & r = registrations[from[position] % size];
+    r.push_back(from[position]);
+    r.push_back(position);
+  } // for
+
+  registrations = detail::alltoallv(registrations);
+
+  std::unordered_map<size_t, std::pair<size_t, size_t>> directory;
+
+  for(size_t r(0); r < size_t(size); ++r) {
+    for(size_t i(0); i < registrations[r].size(); i += 2) {
+      directory[registrations[r][i]] = {r, registrations[r][i + 1]};
+    } // for
+  } // for
+
+  // Look up the old owner and position of every entity of the new
+  // storage, including the ghosts.
+  std::vector<std::vector<size_t>> queries(size);
+  std::vector<std::vector<size_t>> query_positions(size);
+
+  for(size_t position(0); position < to.size(); ++position) {
+    queries[to[position] % size].push_back(to[position]);
+    query_positions[to[position] % size].push_back(position);
+  } // for
+
+  auto requests = detail::alltoallv(queries);
+
+  for(auto & r : requests) {
+    std::vector<size_t> replies;
+    replies.reserve(2 * r.size());
+
+    for(auto id : r) {
+      auto it = directory.find(id);
+      clog_assert(it != directory.end(),
+        "entity " << id << " is not owned by any rank in the old coloring");
+      replies.push_back(it->second.first);
+      replies.push_back(it->second.second);
+    } // for
+
+    r = std::move(replies);
+  } // for
+
+  auto owners = detail::alltoallv(requests);
+
+  // Request the data of each entity from its old owner.
+  std::vector<std::vector<size_t>> pulls(size);
+  plan.recv_positions.resize(size);
+
+  for(size_t d(0); d < size_t(size); ++d) {
+    for(size_t i(0); i < query_positions[d].size(); ++i) {
+      const size_t owner = owners[d][2 * i];
+      pulls[owner].push_back(owners[d][2 * i + 1]);
+      plan.recv_positions[owner].push_back(query_positions[d][i]);
+    } // for
+  } // for
+
+  plan.send_positions = detail::alltoallv(pulls);
+
+  return plan;
+} // make_migration_plan
+
+/*!
+  Compute the plan to migrate the data of an index space from the
+  coloring \em from to the coloring \em to, both in the default storage
+  order. See \ref storage_ids.
+
+  @param from The old index coloring of this rank.
+  @param to   The new index coloring of this rank.
+ */
+
+inline migration_plan_t
+make_migration_plan(const index_coloring_t & from,
+  const index_coloring_t & to) {
+  return make_migration_plan(storage_ids(from),
+    from.exclusive.size() + from.shared.size(), storage_ids(to));
+} // make_migration_plan
+
+/*!
+  Migrate data with a migration plan. This is collective, and sends one
+  message to every rank.
+
+  @param plan   The migration plan.
+  @param pack   A callable object with signature
+                void(size_t position, std::vector<uint8_t> & buffer) that
+                appends the data of the entity at \em position of the old
+                coloring to \em buffer.
+  @param unpack A callable object with signature
+                void(size_t position, const uint8_t *& buffer) that reads
+                the data of the entity at \em position of the new coloring
+                from \em buffer and advances it past the data.
+ */
+
+template<typename PACK, typename UNPACK>
+void
+migrate(const migration_plan_t & plan, PACK && pack, UNPACK && unpack) {
+  const size_t size = plan.send_positions.size();
+
+  std::vector<uint8_t> send_buffer;
+  std::vector<int> send_cnts(size);
+  std::vector<int> send_displs(size + 1, 0);
+
+  for(size_t r(0); r < size; ++r) {
+    for(auto position : plan.send_positions[r]) {
+      pack(position, send_buffer);
+    } // for
+
+    send_displs[r + 1] = send_buffer.size();
+    send_cnts[r] = send_displs[r + 1] - send_displs[r];
+  } // for
+
+  std::vector<int> recv_cnts(size);
+  MPI_Alltoall(send_cnts.data(), 1, MPI_INT, recv_cnts.data(), 1, MPI_INT,
+    utils::mpi_comm());
+
+  std::vector<int> recv_displs(size + 1, 0);
+  std::partial_sum(recv_cnts.begin(), recv_cnts.end(), recv_displs.begin() + 1);
+
+  std::vector<uint8_t> recv_buffer(recv_displs[size]);
+  MPI_Alltoallv(send_buffer.data(), send_cnts.data(), send_displs.data(),
+    MPI_BYTE, recv_buffer.data(), recv_cnts.data(), recv_displs.data(),
+    MPI_BYTE, utils::mpi_comm());
+
+  for(size_t r(0); r < size; ++r) {
+    const uint8_t * buffer = recv_buffer.data() + recv_displs[r];
+
+    for(auto position : plan.recv_positions[r]) {
+      unpack(position, buffer);
+    } // for
+
+    clog_assert(buffer == recv_buffer.data() + recv_displs[r + 1],
+      "migrated data from rank " << r << " was not fully unpacked");
+  } // for
+} // migrate
+
+} // namespace coloring
+} // namespace flecsi
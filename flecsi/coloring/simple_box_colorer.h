@@ -12,10 +12,16 @@
 //----------------------------------------------------------------------------//
 
 #include "mpi.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
 
 #include <flecsi/coloring/box_colorer.h>
+#include <flecsi/utils/mpi_comm.h>
 
 #include <type_traits>
 
@@ -39,7 +45,22 @@ struct simple_box_colorer_t : public box_colorer_t<D> {
   //! Destructor
   ~simple_box_colorer_t() {}
 
-  // Coloring algo
+  //! Set the cost of each cell along an axis. The splits of the axis are
+  //! then placed so that every color has about the same cost, e.g., to
+  //! give fewer cells to the colors of a refined region. The weights
+  //! apply to every slab of cells normal to the axis. They must be the
+  //! same on every rank, and there must be one per cell of the grid along
+  //! the axis, i.e., grid_size[axis] weights. The domain halo cells are
+  //! not included: they are not split, and belong to the colors on the
+  //! boundary of the domain. Without weights, the cells of an axis are
+  //! split evenly.
+  void set_weights(size_t axis, std::vector<double> weights) {
+    assert(axis < D);
+    weights_[axis] = std::move(weights);
+  } // set_weights
+
+  // Coloring algo. Entries of ncolors that are zero are chosen by the
+  // colorer, see factor_colors, and are set on return.
   box_coloring_info_t<D> color(size_t grid_size[D],
     size_t nhalo,
     size_t nhalo_domain,
@@ -48,8 +69,13 @@ struct simple_box_colorer_t : public box_colorer_t<D> {
     int size;
     int rank;
 
-    MPI_Comm_size(MPI_COMM_WORLD, &size);
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(utils::mpi_comm(), &size);
+    MPI_Comm_rank(utils::mpi_comm(), &rank);
+
+    for(size_t i = 0; i < D; ++i)
+      assert(weights_[i].empty() || weights_[i].size() == grid_size[i]);
+
+    factor_colors(grid_size, nhalo, size, ncolors);
 
     // Assert that the number of partitions is equal to number of ranks
     int count = 1;
@@ -69,8 +95,9 @@ struct simple_box_colorer_t : public box_colorer_t<D> {
       domain.upperbnd[i] = grid_size[i] + nhalo_domain - 1;
     }
 
-    // Step 2: Compute the primary box bounds for the current rank
-    auto pbox = create_primary_box(domain, ncolors, idx);
+    // Step 2: Compute the primary box bounds for the current rank. Each
+    // color should be wide enough for its shared cells on both sides.
+    auto pbox = create_primary_box(domain, ncolors, idx, 2 * nhalo);
 
     // Step 2: Create colored box type and set its primary box
     // info to the one created in step 1.
@@ -100,18 +127,140 @@ struct simple_box_colorer_t : public box_colorer_t<D> {
     return colbox;
   } // color
 
-  auto create_primary_box(box_t<D> & domain, size_t ncolors[D], size_t idx[D]) {
+  //! Choose the number of colors of each axis whose entry of ncolors is
+  //! zero, so that the product of all entries is the number of ranks.
+  //! Of the possible process grids, the one with the smallest total area
+  //! of the cuts between colors, i.e., the least halo traffic, is chosen.
+  //! Grids in which some color is narrower than 2 * nhalo cells are only
+  //! used if there is no other choice, and ties go to the grid with the
+  //! smallest largest color.
+  static void factor_colors(const size_t grid_size[D],
+    size_t nhalo,
+    size_t size,
+    size_t ncolors[D]) {
+    size_t fixed = 1;
+    bool any_free = false;
+
+    for(size_t i = 0; i < D; ++i) {
+      if(ncolors[i] == 0)
+        any_free = true;
+      else
+        fixed *= ncolors[i];
+    }
+
+    if(!any_free)
+      return;
+
+    assert(size % fixed == 0);
+
+    // Compare (infeasible, cut area, largest color) lexicographically.
+    using cost_t = std::array<size_t, 3>;
+    cost_t best_cost;
+    best_cost.fill(std::numeric_limits<size_t>::max());
+
+    size_t best[D], trial[D];
+
+    std::function<void(size_t, size_t)> search = [&](size_t axis,
+                                                   size_t remaining) {
+      if(axis == D) {
+        if(remaining != 1)
+          return;
+
+        cost_t cost = {0, 0, 1};
+
+        for(size_t i = 0; i < D; ++i) {
+          size_t area = trial[i] - 1;
+          for(size_t j = 0; j < D; ++j)
+            if(j != i)
+              area *= grid_size[j];
+
+          cost[1] += area;
+          cost[2] *= (grid_size[i] + trial[i] - 1) / trial[i];
+
+          if(trial[i] > 1 && grid_size[i] < 2 * nhalo * trial[i])
+            cost[0] = 1;
+        }
+
+        if(cost < best_cost) {
+          best_cost = cost;
+          std::copy(trial, trial + D, best);
+        }
+        return;
+      }
+
+      if(ncolors[axis] != 0) {
+        trial[axis] = ncolors[axis];
+        search(axis + 1, remaining);
+        return;
+      }
+
+      for(size_t f = 1; f <= remaining; ++f) {
+        if(remaining % f == 0) {
+          trial[axis] = f;
+          search(axis + 1, remaining / f);
+        }
+      }
+    };
+
+    search(0, size / fixed);
+    std::copy(best, best + D, ncolors);
+  } // factor_colors
+
+  //! Return the offsets of the colors along an axis, relative to the
+  //! first cell of the axis, with a final entry equal to the number of
+  //! cells. Colors are at least min_width cells wide if the axis is long
+  //! enough.
+  std::vector<size_t>
+  split_axis(size_t axis, size_t N, size_t nc, size_t min_width) const {
+    std::vector<size_t> offsets(nc + 1);
+
+    const auto & weights = weights_[axis];
+
+    if(weights.empty()) {
+      for(size_t k = 0; k <= nc; ++k)
+        offsets[k] = k * N / nc;
+      return offsets;
+    }
+
+    assert(weights.size() == N);
+
+    std::vector<double> prefix(N + 1, 0.0);
+    for(size_t c = 0; c < N; ++c)
+      prefix[c + 1] = prefix[c] + weights[c];
+
+    min_width = std::max<size_t>(1, std::min(min_width, N / nc));
+
+    offsets[0] = 0;
+    offsets[nc] = N;
+
+    for(size_t k = 1; k < nc; ++k) {
+      // Place the split at the cell boundary closest to the target cost.
+      const double target = k * prefix[N] / nc;
+      size_t b =
+        std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin();
+
+      if(b > 0 && target - prefix[b - 1] < prefix[b] - target)
+        --b;
+
+      b = std::max(b, offsets[k - 1] + min_width);
+      b = std::min(b, N - (nc - k) * min_width);
+      offsets[k] = b;
+    }
+
+    return offsets;
+  } // split_axis
+
+  auto create_primary_box(box_t<D> & domain,
+    size_t ncolors[D],
+    size_t idx[D],
+    size_t min_width = 1) {
     box_t<D> pbox;
     for(size_t i = 0; i < D; ++i) {
       size_t N = domain.upperbnd[i] - domain.lowerbnd[i] + 1;
-      size_t ne = N / ncolors[i];
-
-      pbox.lowerbnd[i] = domain.lowerbnd[i] + ne * idx[i];
+      auto offsets = split_axis(i, N, ncolors[i], min_width);
 
-      if(idx[i] != ncolors[i] - 1)
-        pbox.upperbnd[i] = domain.lowerbnd[i] + ne * (idx[i] + 1) - 1;
-      else
-        pbox.upperbnd[i] = domain.upperbnd[i];
+      pbox.lowerbnd[i] = domain.lowerbnd[i] + offsets[idx[i]];
+      pbox.upperbnd[i] = domain.lowerbnd[i] + offsets[idx[i] + 1] - 1;
     }
     return pbox;
   } // create_primary_box
@@ -672,6 +821,10 @@ struct simple_box_colorer_t : public box_colorer_t<D> {
     }
   } // get_indices
 
+private:
+  // Per-cell weights of each axis, see set_weights.
+  std::array<std::vector<double>, D> weights_;
+
 }; // class simple_box_colorer_t
 
 } // namespace coloring
@@ -0,0 +1,149 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include <flecsi/coloring/entity_order.h>
+#include <flecsi/io/simple_definition.h>
+
+using namespace flecsi;
+
+// Return the grid graph of an n x n mesh of cells, with the cells
+// numbered through the given permutation.
+coloring::crs_t
+grid_graph(size_t n, const std::vector<size_t> & label) {
+  std::vector<std::vector<size_t>> adjacency(n * n);
+
+  for(size_t j(0); j < n; ++j) {
+    for(size_t i(0); i < n; ++i) {
+      const size_t c = label[j * n + i];
+      if(i > 0)
+        adjacency[c].push_back(label[j * n + i - 1]);
+      if(i + 1 < n)
+        adjacency[c].push_back(label[j * n + i + 1]);
+      if(j > 0)
+        adjacency[c].push_back(label[(j - 1) * n + i]);
+      if(j + 1 < n)
+        adjacency[c].push_back(label[(j + 1) * n + i]);
+    } // for
+  } // for
+
+  coloring::crs_t graph;
+  graph.offsets.push_back(0);
+
+  for(auto & a : adjacency) {
+    std::sort(a.begin(), a.end());
+    graph.indices.insert(graph.indices.end(), a.begin(), a.end());
+    graph.offsets.push_back(graph.indices.size());
+  } // for
+
+  return graph;
+} // grid_graph
+
+// Return the bandwidth of a graph after reordering.
+size_t
+bandwidth(const coloring::crs_t & graph, const std::vector<size_t> & order) {
+  std::vector<size_t> position(order.size());
+  for(size_t k(0); k < order.size(); ++k) {
+    position[order[k]] = k;
+  } // for
+
+  size_t result(0);
+  for(size_t i(0); i < graph.size(); ++i) {
+    for(size_t k(graph.offsets[i]); k < graph.offsets[i + 1]; ++k) {
+      const size_t a = position[i], b = position[graph.indices[k]];
+      result = std::max(result, a > b ? a - b : b - a);
+    } // for
+  } // for
+
+  return result;
+} // bandwidth
+
+bool
+is_permutation(std::vector<size_t> order, size_t n) {
+  std::sort(order.begin(), order.end());
+  for(size_t k(0); k < order.size(); ++k) {
+    if(order[k] != k)
+      return false;
+  } // for
+  return order.size() == n;
+} // is_permutation
+
+TEST(entity_order, rcm) {
+  const size_t n = 32;
+
+  std::vector<size_t> label(n * n);
+  std::iota(label.begin(), label.end(), 0);
+  std::shuffle(label.begin(), label.end(), std::mt19937(42));
+
+  auto graph = grid_graph(n, label);
+
+  std::vector<size_t> identity(n * n);
+  std::iota(identity.begin(), identity.end(), 0);
+
+  auto order = coloring::rcm_order(graph);
+
+  CINCH_ASSERT(TRUE, is_permutation(order, n * n));
+  CINCH_ASSERT(LE, bandwidth(graph, order), 2 * n);
+  CINCH_ASSERT(LT, bandwidth(graph, order), bandwidth(graph, identity) / 4);
+} // TEST
+
+TEST(entity_order, hilbert) {
+  const size_t n = 32;
+
+  // The cell centers of a grid, in shuffled order.
+  std::vector<size_t> label(n * n);
+  std::iota(label.begin(), label.end(), 0);
+  std::shuffle(label.begin(), label.end(), std::mt19937(7));
+
+  std::vector<point_u<double, 2>> points(n * n);
+  for(size_t c(0); c < n * n; ++c) {
+    points[label[c]] = {double(c % n) + 0.5, double(c / n) + 0.5};
+  } // for
+
+  auto order = coloring::hilbert_order(points);
+
+  CINCH_ASSERT(TRUE, is_permutation(order, n * n));
+
+  // Consecutive cells along the curve are neighbors.
+  for(size_t k(1); k < order.size(); ++k) {
+    auto & a = points[order[k - 1]];
+    auto & b = points[order[k]];
+    CINCH_ASSERT(EQ, std::abs(a[0] - b[0]) + std::abs(a[1] - b[1]), 1.0);
+  } // for
+} // TEST
+
+TEST(entity_order, exclusive_graph) {
+  io::simple_definition_t sd("simple2d-8x8.msh");
+
+  // Make every other row of cells exclusive.
+  coloring::index_coloring_t ic;
+  for(size_t c(0); c < sd.num_entities(2); ++c) {
+    if((c / 8) % 2 == 0) {
+      ic.exclusive.insert(coloring::entity_info_t(c, 0, 0, {}));
+    } // if
+  } // for
+
+  auto graph = coloring::exclusive_graph(sd, ic, 2);
+
+  CINCH_ASSERT(EQ, graph.size(), 32);
+
+  // Rows are not connected, so each cell only sees its row neighbors.
+  for(size_t i(0); i < graph.size(); ++i) {
+    const size_t degree = graph.offsets[i + 1] - graph.offsets[i];
+    CINCH_ASSERT(EQ, degree, (i % 8 == 0 || i % 8 == 7) ? 1 : 2);
+  } // for
+
+  auto order = coloring::rcm_order(graph);
+  CINCH_ASSERT(TRUE, is_permutation(order, 32));
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,162 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/geometric_colorer.h>
+#include <flecsi/io/simple_definition.h>
+#include <flecsi/utils/mpi_comm.h>
+
+using namespace flecsi;
+using point_t = coloring::geometric_colorer_u<2>::point_t;
+
+// Return the centroids of the cells that are local to this rank in the
+// naive distribution.
+std::vector<point_t>
+local_centroids(const io::simple_definition_t & sd,
+  const coloring::dcrs_t & dcrs) {
+  int rank;
+  MPI_Comm_rank(utils::mpi_comm(), &rank);
+
+  std::vector<point_t> centroids;
+
+  for(size_t i(0); i < dcrs.size(); ++i) {
+    point_t c(0.0, 0.0);
+    auto vertices = sd.entities(2, 0, dcrs.distribution[rank] + i);
+
+    for(auto v : vertices) {
+      c += sd.vertex(v);
+    } // for
+
+    centroids.push_back(c / double(vertices.size()));
+  } // for
+
+  return centroids;
+} // local_centroids
+
+// Check that the parts cover every cell exactly once and that each part
+// has the expected weight.
+void
+check_partition(const std::set<size_t> & primary,
+  double weight,
+  double expected) {
+  size_t local = primary.size();
+  size_t total;
+  MPI_Allreduce(
+    &local, &total, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+  CINCH_ASSERT(EQ, total, 256);
+  CINCH_ASSERT(EQ, weight, expected);
+} // check_partition
+
+TEST(geometric_colorer, rcb) {
+  io::simple_definition_t sd("simple2d-16x16.msh");
+  auto dcrs = coloring::make_dcrs(sd);
+
+  coloring::rcb_colorer_u<2> colorer(local_centroids(sd, dcrs));
+  auto primary = colorer.color(dcrs);
+
+  check_partition(primary, primary.size(), 64.0);
+
+  // With four ranks, each part is one quadrant of the unit square.
+  double lower[2] = {1.0, 1.0}, upper[2] = {0.0, 0.0};
+
+  for(auto c : primary) {
+    for(auto v : sd.entities(2, 0, c)) {
+      auto p = sd.vertex(v);
+      for(size_t d(0); d < 2; ++d) {
+        lower[d] = std::min(lower[d], p[d]);
+        upper[d] = std::max(upper[d], p[d]);
+      } // for
+    } // for
+  } // for
+
+  CINCH_ASSERT(EQ, upper[0] - lower[0], 0.5);
+  CINCH_ASSERT(EQ, upper[1] - lower[1], 0.5);
+} // TEST
+
+TEST(geometric_colorer, hilbert) {
+  io::simple_definition_t sd("simple2d-16x16.msh");
+  auto dcrs = coloring::make_dcrs(sd);
+
+  coloring::hilbert_colorer_u<2> colorer(local_centroids(sd, dcrs));
+  auto primary = colorer.color(dcrs);
+
+  check_partition(primary, primary.size(), 64.0);
+} // TEST
+
+TEST(geometric_colorer, weighted) {
+  io::simple_definition_t sd("simple2d-16x16.msh");
+  auto dcrs = coloring::make_dcrs(sd);
+  auto centroids = local_centroids(sd, dcrs);
+
+  // Cells in the left half of the mesh are three times as expensive.
+  std::vector<double> weights;
+  for(auto & c : centroids) {
+    weights.push_back(c[0] < 0.5 ? 3.0 : 1.0);
+  } // for
+
+  const double total = 128 * 3.0 + 128 * 1.0;
+
+  // Cells are not split, so each part is within one cell weight of the
+  // average per bisection.
+  auto check = [&](coloring::colorer_t & colorer, double tolerance) {
+    auto part = colorer.new_color(dcrs);
+    std::vector<double> local(4, 0.0), global(4);
+
+    for(size_t i(0); i < part.size(); ++i) {
+      local[part[i]] += weights[i];
+    } // for
+
+    MPI_Allreduce(
+      local.data(), global.data(), 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+    for(auto w : global) {
+      CINCH_ASSERT(LE, std::abs(w - total / 4), tolerance);
+    } // for
+  };
+
+  coloring::rcb_colorer_u<2> rcb(centroids, weights);
+  check(rcb, 2 * 3.0);
+
+  coloring::hilbert_colorer_u<2> hilbert(centroids, weights);
+  check(hilbert, 3.0);
+} // TEST
+
+TEST(geometric_colorer, sub_communicator) {
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // Color the mesh independently on each half of the ranks.
+  MPI_Comm half;
+  MPI_Comm_split(MPI_COMM_WORLD, rank / 2, rank, &half);
+  utils::set_mpi_comm(half);
+
+  io::simple_definition_t sd("simple2d-16x16.msh");
+  auto dcrs = coloring::make_dcrs(sd);
+
+  CINCH_ASSERT(EQ, dcrs.distribution.size(), 3);
+  CINCH_ASSERT(EQ, dcrs.distribution.back(), 256);
+
+  coloring::rcb_colorer_u<2> colorer(local_centroids(sd, dcrs));
+  auto primary = colorer.color(dcrs);
+
+  size_t local = primary.size();
+  size_t total;
+  MPI_Allreduce(&local, &total, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, half);
+
+  CINCH_ASSERT(EQ, total, 256);
+  CINCH_ASSERT(EQ, primary.size(), 128);
+
+  utils::set_mpi_comm(MPI_COMM_WORLD);
+  MPI_Comm_free(&half);
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,225 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <cstring>
+
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/geometric_colorer.h>
+#include <flecsi/coloring/repartition.h>
+#include <flecsi/io/simple_definition.h>
+
+using namespace flecsi;
+using point_t = coloring::geometric_colorer_u<2>::point_t;
+
+// Return the centroids of the given cells.
+std::vector<point_t>
+centroids(const io::simple_definition_t & sd, const std::set<size_t> & cells) {
+  std::vector<point_t> result;
+
+  for(auto c : cells) {
+    point_t p(0.0, 0.0);
+    auto vertices = sd.entities(2, 0, c);
+
+    for(auto v : vertices) {
+      p += sd.vertex(v);
+    } // for
+
+    result.push_back(p / double(vertices.size()));
+  } // for
+
+  return result;
+} // centroids
+
+// Build the index coloring of a primary cell coloring with one layer of
+// vertex-connected ghosts. The owners of all cells are gathered on every
+// rank, which is fine for a small mesh.
+coloring::index_coloring_t
+make_coloring(const io::simple_definition_t & sd,
+  const std::set<size_t> & primary) {
+  int size, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t ncells = sd.num_entities(2);
+  std::vector<size_t> local(ncells, 0), owner(ncells);
+
+  for(auto c : primary) {
+    local[c] = rank;
+  } // for
+
+  MPI_Allreduce(local.data(), owner.data(), ncells, MPI_UNSIGNED_LONG_LONG,
+    MPI_SUM, MPI_COMM_WORLD);
+
+  std::map<size_t, std::set<size_t>> vertex_cells;
+
+  for(size_t c(0); c < ncells; ++c) {
+    for(auto v : sd.entities(2, 0, c)) {
+      vertex_cells[v].insert(c);
+    } // for
+  } // for
+
+  auto neighbors = [&](size_t c) {
+    std::set<size_t> result;
+    for(auto v : sd.entities(2, 0, c)) {
+      result.insert(vertex_cells[v].begin(), vertex_cells[v].end());
+    } // for
+    result.erase(c);
+    return result;
+  };
+
+  coloring::index_coloring_t ic;
+  ic.primary = primary;
+
+  size_t offset(0);
+
+  for(auto c : primary) {
+    std::set<size_t> users;
+
+    for(auto n : neighbors(c)) {
+      if(owner[n] != size_t(rank)) {
+        users.insert(owner[n]);
+        ic.ghost.insert(coloring::entity_info_t(n, owner[n], 0, {}));
+      } // if
+    } // for
+
+    auto & entities = users.empty() ? ic.exclusive : ic.shared;
+    entities.insert(coloring::entity_info_t(c, rank, offset++, users));
+  } // for
+
+  return ic;
+} // make_coloring
+
+TEST(repartition, recolor) {
+  io::simple_definition_t sd("simple2d-16x16.msh");
+  auto dcrs = coloring::make_dcrs(sd);
+
+  // Start from the naive distribution.
+  int size, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  std::set<size_t> primary;
+  for(size_t i(dcrs.distribution[rank]); i < dcrs.distribution[rank + 1];
+      ++i) {
+    primary.insert(i);
+  } // for
+
+  // Cells in the left half of the mesh are three times as expensive.
+  auto c = centroids(sd, primary);
+  std::vector<double> weights;
+  for(auto & p : c) {
+    weights.push_back(p[0] < 0.5 ? 3.0 : 1.0);
+  } // for
+
+  coloring::hilbert_colorer_u<2> colorer(c, weights);
+  auto new_primary = colorer.recolor(primary);
+
+  double local = 0.0;
+  for(auto & p : centroids(sd, new_primary)) {
+    local += p[0] < 0.5 ? 3.0 : 1.0;
+  } // for
+
+  size_t count = new_primary.size(), total;
+  MPI_Allreduce(
+    &count, &total, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+  CINCH_ASSERT(EQ, total, 256);
+  CINCH_ASSERT(LE, std::abs(local - 512.0 / size), 3.0);
+} // TEST
+
+TEST(repartition, migrate) {
+  int size, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  io::simple_definition_t sd("simple2d-16x16.msh");
+
+  // The old coloring is the naive distribution, and the new coloring is
+  // a weighted Hilbert partition.
+  std::set<size_t> primary;
+  for(size_t c(rank); c < sd.num_entities(2); c += size) {
+    primary.insert(c);
+  } // for
+
+  auto c = centroids(sd, primary);
+  std::vector<double> weights;
+  for(auto & p : c) {
+    weights.push_back(p[1] < 0.25 ? 4.0 : 1.0);
+  } // for
+
+  auto from = make_coloring(sd, primary);
+  coloring::hilbert_colorer_u<2> colorer(c, weights);
+  auto to = make_coloring(sd, colorer.recolor(primary));
+
+  auto plan = coloring::make_migration_plan(from, to);
+
+  auto old_ids = coloring::storage_ids(from);
+  auto new_ids = coloring::storage_ids(to);
+
+  CINCH_ASSERT(EQ, plan.old_size, old_ids.size());
+  CINCH_ASSERT(EQ, plan.new_size, new_ids.size());
+
+  // A dense field and a ragged field. Only the exclusive and shared
+  // entities of the old coloring hold valid data.
+  const size_t owned = from.exclusive.size() + from.shared.size();
+  std::vector<double> old_dense(old_ids.size(), -1.0);
+  std::vector<std::vector<size_t>> old_ragged(old_ids.size());
+
+  for(size_t i(0); i < owned; ++i) {
+    old_dense[i] = 2.0 * old_ids[i] + 1.0;
+    for(size_t k(0); k < old_ids[i] % 4; ++k) {
+      old_ragged[i].push_back(old_ids[i] + k);
+    } // for
+  } // for
+
+  std::vector<double> new_dense(new_ids.size(), -1.0);
+  std::vector<std::vector<size_t>> new_ragged(new_ids.size());
+
+  coloring::migrate(plan,
+    [&](size_t position, std::vector<uint8_t> & buffer) {
+      CINCH_ASSERT(LT, position, owned);
+
+      auto d = reinterpret_cast<const uint8_t *>(&old_dense[position]);
+      buffer.insert(buffer.end(), d, d + sizeof(double));
+
+      size_t n = old_ragged[position].size();
+      auto b = reinterpret_cast<const uint8_t *>(&n);
+      buffer.insert(buffer.end(), b, b + sizeof(size_t));
+
+      auto r = reinterpret_cast<const uint8_t *>(old_ragged[position].data());
+      buffer.insert(buffer.end(), r, r + n * sizeof(size_t));
+    },
+    [&](size_t position, const uint8_t *& buffer) {
+      std::memcpy(&new_dense[position], buffer, sizeof(double));
+      buffer += sizeof(double);
+
+      size_t n;
+      std::memcpy(&n, buffer, sizeof(size_t));
+      buffer += sizeof(size_t);
+
+      new_ragged[position].resize(n);
+      std::memcpy(new_ragged[position].data(), buffer, n * sizeof(size_t));
+      buffer += n * sizeof(size_t);
+    });
+
+  // Every entity of the new coloring, including the ghosts, has the data
+  // of its old owner.
+  for(size_t i(0); i < new_ids.size(); ++i) {
+    CINCH_ASSERT(EQ, new_dense[i], 2.0 * new_ids[i] + 1.0);
+    CINCH_ASSERT(EQ, new_ragged[i].size(), new_ids[i] % 4);
+
+    for(size_t k(0); k < new_ragged[i].size(); ++k) {
+      CINCH_ASSERT(EQ, new_ragged[i][k], new_ids[i] + k);
+    } // for
+  } // for
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -89,3 +89,92 @@ TEST(simple_colorer, simpletest2d) {
          << ", " << d.upperbnd[1] << " } " << endl;
   }
 }
+
+TEST(simple_colorer, factor2d) {
+  using colorer_t = flecsi::coloring::simple_box_colorer_t<2>;
+
+  // A long grid is only cut across its long axis.
+  size_t long_grid[2] = {100, 10};
+  size_t ncolors[2] = {0, 0};
+  colorer_t::factor_colors(long_grid, 1, 4, ncolors);
+  ASSERT_EQ(ncolors[0], 4);
+  ASSERT_EQ(ncolors[1], 1);
+
+  // A square grid on a prime number of ranks.
+  size_t square_grid[2] = {64, 64};
+  ncolors[0] = ncolors[1] = 0;
+  colorer_t::factor_colors(square_grid, 1, 7, ncolors);
+  ASSERT_EQ(ncolors[0] * ncolors[1], 7);
+
+  // A square grid on six ranks gives a 2x3 or 3x2 grid.
+  ncolors[0] = ncolors[1] = 0;
+  colorer_t::factor_colors(square_grid, 1, 6, ncolors);
+  ASSERT_EQ(ncolors[0] + ncolors[1], 5);
+
+  // Fixed axes are kept.
+  ncolors[0] = 6;
+  ncolors[1] = 0;
+  colorer_t::factor_colors(square_grid, 1, 12, ncolors);
+  ASSERT_EQ(ncolors[0], 6);
+  ASSERT_EQ(ncolors[1], 2);
+
+  // Colors narrower than the halo are avoided.
+  size_t thin_grid[2] = {12, 10};
+  ncolors[0] = ncolors[1] = 0;
+  colorer_t::factor_colors(thin_grid, 2, 4, ncolors);
+  ASSERT_EQ(ncolors[0], 2);
+  ASSERT_EQ(ncolors[1], 2);
+}
+
+TEST(simple_colorer, split2d) {
+  flecsi::coloring::simple_box_colorer_t<2> sbc;
+
+  // The remainder is spread over the colors.
+  auto even = sbc.split_axis(0, 10, 3, 1);
+  ASSERT_EQ(even, std::vector<size_t>({0, 3, 6, 10}));
+
+  // The first half of the cells is three times as expensive.
+  std::vector<double> weights(12, 1.0);
+  std::fill(weights.begin(), weights.begin() + 6, 3.0);
+  sbc.set_weights(1, weights);
+
+  auto weighted = sbc.split_axis(1, 12, 2, 1);
+  ASSERT_EQ(weighted, std::vector<size_t>({0, 4, 12}));
+
+  // Colors are kept at the minimum width.
+  std::fill(weights.begin(), weights.end(), 1.0);
+  weights[0] = 100.0;
+  sbc.set_weights(1, weights);
+
+  auto clamped = sbc.split_axis(1, 12, 3, 2);
+  ASSERT_EQ(clamped, std::vector<size_t>({0, 2, 4, 12}));
+}
+
+TEST(simple_colorer, weighted2d) {
+  int size, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  if(size != 4)
+    return;
+
+  size_t grid_size[2] = {12, 8};
+  size_t ncolors[2] = {4, 1};
+  size_t nhalo = 1;
+  size_t nhalo_domain = 2;
+
+  // One weight per grid cell of the axis, without the domain halo. The
+  // first half of the cells is three times as expensive.
+  std::vector<double> weights(grid_size[0], 1.0);
+  std::fill(weights.begin(), weights.begin() + 6, 3.0);
+
+  flecsi::coloring::simple_box_colorer_t<2> sbc;
+  sbc.set_weights(0, weights);
+  auto col = sbc.color(grid_size, nhalo, nhalo_domain, 0, ncolors);
+
+  // The splits are at cells 2, 4 and 6 of the grid, which starts after
+  // the domain halo.
+  const size_t offsets[5] = {0, 2, 4, 6, 12};
+  ASSERT_EQ(col.primary.box.lowerbnd[0], nhalo_domain + offsets[rank]);
+  ASSERT_EQ(col.primary.box.upperbnd[0], nhalo_domain + offsets[rank + 1] - 1);
+}
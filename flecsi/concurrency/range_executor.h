@@ -0,0 +1,272 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <flecsi/concurrency/thread_pool.h>
+
+namespace flecsi {
+
+//----------------------------------------------------------------------------//
+//! The range_executor class partitions a contiguous range [0, n) over the
+//! workers of a thread_pool and the calling thread. It is used by the
+//! native (non-Kokkos) kernel interface to execute forall and reduce_all
+//! loops.
+//!
+//! Two schedules are supported: \em blocked, which gives each thread one
+//! contiguous block of roughly n / concurrency() iterations, and
+//! \em chunked, in which threads repeatedly claim fixed-size chunks from a
+//! shared counter until the range is exhausted. The latter balances loops
+//! with irregular per-iteration cost.
+//!
+//! The number of worker threads may be set with the FLECSI_KERNEL_THREADS
+//! environment variable (the calling thread is not counted). The default
+//! schedule may be set with FLECSI_KERNEL_SCHEDULE=blocked|chunked.
+//!
+//! @ingroup concurrency
+//----------------------------------------------------------------------------//
+
+class range_executor
+{
+public:
+  /*!
+    Work partitioning strategies.
+   */
+
+  enum class schedule_t : size_t { blocked, chunked }; // enum schedule_t
+
+  //--------------------------------------------------------------------------//
+  //! Meyer's singleton instance.
+  //--------------------------------------------------------------------------//
+
+  static range_executor & instance() {
+    static range_executor executor;
+    return executor;
+  } // instance
+
+  range_executor(const range_executor &) = delete;
+  range_executor & operator=(const range_executor &) = delete;
+
+  //--------------------------------------------------------------------------//
+  //! Return the number of threads that participate in a range execution,
+  //! including the calling thread.
+  //--------------------------------------------------------------------------//
+
+  size_t concurrency() const {
+    return pool_.num_threads() + 1;
+  } // concurrency
+
+  schedule_t schedule() const {
+    return schedule_;
+  } // schedule
+
+  void set_schedule(schedule_t schedule) {
+    schedule_ = schedule;
+  } // set_schedule
+
+  size_t chunk_size() const {
+    return chunk_size_;
+  } // chunk_size
+
+  void set_chunk_size(size_t chunk_size) {
+    chunk_size_ = std::max(chunk_size, size_t{1});
+  } // set_chunk_size
+
+  //--------------------------------------------------------------------------//
+  //! Ranges smaller than this are executed serially on the calling thread.
+  //--------------------------------------------------------------------------//
+
+  size_t serial_threshold() const {
+    return serial_threshold_;
+  } // serial_threshold
+
+  void set_serial_threshold(size_t threshold) {
+    serial_threshold_ = threshold;
+  } // set_serial_threshold
+
+  //--------------------------------------------------------------------------//
+  //! Return true if the calling thread is executing a range, in which case
+  //! a nested execute runs serially on it.
+  //--------------------------------------------------------------------------//
+
+  bool in_range() const {
+    return in_range_();
+  } // in_range
+
+  //--------------------------------------------------------------------------//
+  //! Return a scratch buffer of at least \em bytes bytes, suitably aligned
+  //! for any scalar type, for kernels that need temporary storage. Each
+  //! calling thread has its own buffer, which only grows and is reused by
+  //! later calls, so its contents are undefined and it is invalidated by
+  //! the next call on the same thread.
+  //--------------------------------------------------------------------------//
+
+  void * scratch(size_t bytes) {
+    thread_local std::vector<std::max_align_t> buffer;
+
+    const size_t words =
+      (bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+
+    if(buffer.size() < words) {
+      buffer.resize(words);
+    } // if
+
+    return buffer.data();
+  } // scratch
+
+  //--------------------------------------------------------------------------//
+  //! Execute \em body over [0, n) using the default schedule.
+  //!
+  //! @param n    The number of iterations.
+  //! @param body A callable object with signature void(size_t begin,
+  //!             size_t end, size_t thread) that executes the sub-range
+  //!             [begin, end). The thread argument is a dense id in
+  //!             [0, concurrency()) that may be used to index
+  //!             thread-private data.
+  //--------------------------------------------------------------------------//
+
+  template<typename BODY>
+  void execute(size_t n, BODY && body) {
+    execute(n, schedule_, std::forward<BODY>(body));
+  } // execute
+
+  //--------------------------------------------------------------------------//
+  //! Execute \em body over [0, n) using the given schedule.
+  //--------------------------------------------------------------------------//
+
+  template<typename BODY>
+  void execute(size_t n, schedule_t schedule, BODY && body) {
+
+    if(n == 0) {
+      return;
+    } // if
+
+    // Nested kernels, e.g., a forall inside of a forall, and small ranges
+    // run on the calling thread. Queueing nested work onto the pool could
+    // deadlock if every worker blocked waiting for its children.
+    if(in_range_() || pool_.num_threads() == 0 || n < serial_threshold_) {
+      body(size_t{0}, n, size_t{0});
+      return;
+    } // if
+
+    const size_t nthreads = concurrency();
+    std::atomic<size_t> pending(nthreads - 1);
+    std::mutex mutex;
+    std::condition_variable done;
+
+    auto finish = [&]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(--pending == 0) {
+        done.notify_one();
+      } // if
+    };
+
+    // The workers reference the locals of the schedule branches, so each
+    // branch waits for them before its locals go out of scope.
+    auto wait = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      done.wait(lock, [&]() { return pending == 0; });
+    };
+
+    if(schedule == schedule_t::blocked) {
+      const size_t block = (n + nthreads - 1) / nthreads;
+
+      auto run_block = [&, block](size_t t) {
+        const size_t begin = std::min(t * block, n);
+        const size_t end = std::min(begin + block, n);
+
+        if(begin < end) {
+          in_range_() = true;
+          body(begin, end, t);
+          in_range_() = false;
+        } // if
+      };
+
+      for(size_t t{1}; t < nthreads; ++t) {
+        pool_.queue([&, t]() {
+          run_block(t);
+          finish();
+        });
+      } // for
+
+      run_block(0);
+      wait();
+    }
+    else {
+      std::atomic<size_t> next(0);
+      const size_t chunk = chunk_size_;
+
+      auto run_chunks = [&, chunk](size_t t) {
+        in_range_() = true;
+        for(size_t begin = next.fetch_add(chunk); begin < n;
+            begin = next.fetch_add(chunk)) {
+          body(begin, std::min(begin + chunk, n), t);
+        } // for
+        in_range_() = false;
+      };
+
+      for(size_t t{1}; t < nthreads; ++t) {
+        pool_.queue([&, t]() {
+          run_chunks(t);
+          finish();
+        });
+      } // for
+
+      run_chunks(0);
+      wait();
+    } // if
+  } // execute
+
+private:
+  range_executor() {
+    size_t nthreads = std::thread::hardware_concurrency();
+    nthreads = nthreads > 1 ? nthreads - 1 : 0;
+
+    if(const char * env = std::getenv("FLECSI_KERNEL_THREADS")) {
+      nthreads = std::strtoul(env, nullptr, 10);
+    } // if
+
+    if(const char * env = std::getenv("FLECSI_KERNEL_SCHEDULE")) {
+      if(std::strcmp(env, "chunked") == 0) {
+        schedule_ = schedule_t::chunked;
+      } // if
+    } // if
+
+    pool_.start(nthreads);
+  } // range_executor
+
+  static bool & in_range_() {
+    thread_local bool in_range = false;
+    return in_range;
+  } // in_range_
+
+  thread_pool pool_;
+  schedule_t schedule_ = schedule_t::blocked;
+  size_t chunk_size_ = 1024;
+  size_t serial_threshold_ = 256;
+
+}; // class range_executor
+
+} // namespace flecsi
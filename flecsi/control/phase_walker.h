@@ -16,6 +16,7 @@
 /*! @file */
 
 #include <flecsi/utils/const_string.h>
+#include <flecsi/utils/trace.h>
 #include <flecsi/utils/tuple_walker.h>
 #include <flecsi/utils/typeify.h>
 
@@ -91,6 +92,7 @@ struct phase_walker_u
         CONTROL_POLICY::instance().sorted_phase_map(PHASE_TYPE::value);
 
       for(auto & node : sorted) {
+        flecsi_trace_region("control", node.label().c_str());
         node.action()(argc_, argv_);
       } // for
     }
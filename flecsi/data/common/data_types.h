@@ -16,7 +16,10 @@
 /*! @file */
 
 #include <bitset>
+#include <cstdint>
+#include <limits>
 #include <ostream>
+#include <type_traits>
 
 #include <flecsi/utils/target.h>
 
@@ -26,6 +29,7 @@ namespace data {
 template<typename T>
 struct sparse_entry_value_u {
   using index_t = uint64_t;
+  using value_t = T;
 
   FLECSI_INLINE_TARGET
   sparse_entry_value_u(index_t entry) : entry(entry) {}
@@ -52,6 +56,122 @@ operator<<(std::ostream & ostr,
   return ostr << "(" << ev.entry << ", " << ev.value << ")";
 } // operator<<
 
+/*!
+  The soa_u type selects the structure-of-arrays layout for a sparse field
+  when it is used as the data type of the field, e.g.,
+
+  \code
+  using fraction_t = flecsi::data::soa_u<double, uint16_t>;
+  flecsi_register_field(mesh_t, hydro, fraction, fraction_t, sparse, 1, cells);
+  \endcode
+
+  Accessors and mutators of the field reference values of type \em T. Each
+  row stores its entries, as \em INDEX, and its values in separate arrays,
+  so that a lookup only reads the entries, and a row of n values takes
+  n * (sizeof(INDEX) + sizeof(T)) bytes instead of
+  n * sizeof(sparse_entry_value_u<T>).
+
+  @tparam T     The value type.
+  @tparam INDEX The entry type, an unsigned integer of 8, 16, 32 or 64 bits.
+                Entries must be representable as \em INDEX.
+ */
+
+template<typename T, typename INDEX>
+struct soa_u {}; // struct soa_u
+
+/*!
+  The element type of the rows of a structure-of-arrays sparse field. Rows
+  are not arrays of this type: it only gives the size of an element, which
+  is the number of bytes that an entry and its value take in a row.
+ */
+
+template<typename T, typename INDEX>
+struct soa_entry_value_u {
+  static_assert(
+    std::is_integral<INDEX>::value && std::is_unsigned<INDEX>::value,
+    "sparse entry index must be an unsigned integer");
+  static_assert(std::is_trivially_copyable<T>::value,
+    "structure-of-arrays sparse values must be trivially copyable");
+
+  using index_t = INDEX;
+  using value_t = T;
+
+  unsigned char bytes[sizeof(INDEX) + sizeof(T)];
+}; // struct soa_entry_value_u
+
+template<typename T>
+struct is_soa_entry_value_u : std::false_type {};
+
+template<typename T, typename INDEX>
+struct is_soa_entry_value_u<soa_entry_value_u<T, INDEX>> : std::true_type {};
+
+/*!
+  The padded_u type selects the padded layout for a sparse field when it
+  is used as the data type of the field, e.g.,
+
+  \code
+  using fraction_t = flecsi::data::padded_u<double, 4>;
+  flecsi_register_field(mesh_t, hydro, fraction, fraction_t, sparse, 1, cells);
+  \endcode
+
+  Accessors and mutators of the field reference values of type \em T. The
+  runtime may store the rows in one buffer of \em MAX_ENTRIES elements per
+  index, so that rows are contiguous and need no allocation. A row that
+  grows beyond \em MAX_ENTRIES elements moves to its own allocation.
+
+  @tparam T           The value type.
+  @tparam MAX_ENTRIES The number of elements reserved per index.
+ */
+
+template<typename T, std::size_t MAX_ENTRIES>
+struct padded_u {}; // struct padded_u
+
+/*!
+  The element type of the rows of a padded sparse field.
+ */
+
+template<typename T, std::size_t MAX_ENTRIES>
+struct padded_entry_value_u : sparse_entry_value_u<T> {
+  static_assert(MAX_ENTRIES > 0, "padded rows must reserve an entry");
+
+  static constexpr std::size_t max_entries = MAX_ENTRIES;
+
+  using sparse_entry_value_u<T>::sparse_entry_value_u;
+
+  FLECSI_INLINE_TARGET
+  padded_entry_value_u() {}
+}; // struct padded_entry_value_u
+
+template<typename T>
+struct is_padded_entry_value_u : std::false_type {};
+
+template<typename T, std::size_t MAX_ENTRIES>
+struct is_padded_entry_value_u<padded_entry_value_u<T, MAX_ENTRIES>>
+  : std::true_type {};
+
+/*!
+  The sparse_traits_u type maps the data type of a sparse field to the type
+  of its values and to the element type of its rows.
+ */
+
+template<typename T>
+struct sparse_traits_u {
+  using value_t = T;
+  using entry_value_t = sparse_entry_value_u<T>;
+}; // struct sparse_traits_u
+
+template<typename T, typename INDEX>
+struct sparse_traits_u<soa_u<T, INDEX>> {
+  using value_t = T;
+  using entry_value_t = soa_entry_value_u<T, INDEX>;
+}; // struct sparse_traits_u
+
+template<typename T, std::size_t MAX_ENTRIES>
+struct sparse_traits_u<padded_u<T, MAX_ENTRIES>> {
+  using value_t = T;
+  using entry_value_t = padded_entry_value_u<T, MAX_ENTRIES>;
+}; // struct sparse_traits_u
+
 // Generic bitfield type
 using bitset_t = std::bitset<8>;
 
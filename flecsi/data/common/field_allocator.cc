@@ -0,0 +1,87 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+
+/*! @file */
+
+#include <flecsi/data/common/field_allocator.h>
+
+#include <cinchlog.h>
+
+#include <flecsi/concurrency/range_executor.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace flecsi {
+namespace data {
+
+namespace {
+
+bool
+huge_pages() {
+  static const bool enabled = []() {
+    const char * env = std::getenv("FLECSI_HUGE_PAGES");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  return enabled;
+} // huge_pages
+
+/*
+  Zero-fill a new slab using the same blocked partition of the kernel
+  threads that is used to execute forall loops.
+ */
+
+void
+first_touch(uint8_t * data, size_t bytes) {
+  constexpr size_t page = 4096;
+  const size_t pages = (bytes + page - 1) / page;
+
+  range_executor::instance().execute(pages,
+    range_executor::schedule_t::blocked,
+    [data, bytes](size_t begin, size_t end, size_t) {
+      const size_t first = begin * page;
+      const size_t last = std::min(end * page, bytes);
+      std::memset(data + first, 0, last - first);
+    });
+} // first_touch
+
+} // namespace
+
+//----------------------------------------------------------------------------//
+// Implementation of field_allocator_t::allocate_slab.
+//----------------------------------------------------------------------------//
+
+uint8_t *
+field_allocator_t::allocate_slab(size_t bytes) {
+  const bool huge = huge_pages() && bytes >= HUGE_PAGE_SIZE;
+  const size_t alignment = huge ? HUGE_PAGE_SIZE : FIELD_ALIGNMENT;
+  bytes = round_up(bytes, alignment);
+
+  void * p = nullptr;
+  const int error = posix_memalign(&p, alignment, bytes);
+  clog_assert(error == 0, "failed to allocate " << bytes << " bytes");
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if(huge) {
+    madvise(p, bytes, MADV_HUGEPAGE);
+  } // if
+#endif
+
+  first_touch(static_cast<uint8_t *>(p), bytes);
+  return static_cast<uint8_t *>(p);
+} // field_allocator_t::allocate_slab
+
+} // namespace data
+} // namespace flecsi
@@ -0,0 +1,298 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <utility>
+#include <stdint.h>
+#include <vector>
+
+#include <flecsi/runtime/types.h>
+
+namespace flecsi {
+namespace data {
+
+//----------------------------------------------------------------------------//
+//! The field_allocator_t type manages the raw storage of registered fields.
+//!
+//! Fields are carved out of large slabs that are pooled by index space, so
+//! that the fields of one index space are adjacent in memory. The first
+//! slab of a pool holds the fields that have been reserved for it, and the
+//! storage that a field leaves behind when it grows is reused by the pool.
+//! Every field starts on a cache line boundary (FIELD_ALIGNMENT bytes),
+//! which allows aligned vector loads of the field base. Slabs are zero-filled
+//! in parallel by the kernel threads of range_executor, so that pages are
+//! first touched by the threads that later iterate over them with the
+//! blocked schedule.
+//!
+//! Slabs of at least HUGE_PAGE_SIZE bytes are aligned to and advised as
+//! transparent huge pages if the FLECSI_HUGE_PAGES environment variable is
+//! set to a non-zero value.
+//!
+//! Field lookups are direct indexed by field id.
+//!
+//! @ingroup data
+//----------------------------------------------------------------------------//
+
+class field_allocator_t
+{
+public:
+  static constexpr size_t FIELD_ALIGNMENT = 64;
+  static constexpr size_t HUGE_PAGE_SIZE = 2 << 20;
+  static constexpr size_t SLAB_SIZE = 4 << 20;
+
+  /*!
+    The pool used by fields that are not associated with an index space.
+   */
+
+  static constexpr size_t DEFAULT_POOL = size_t(-1);
+
+  field_allocator_t() = default;
+  field_allocator_t(field_allocator_t &&) = default;
+  field_allocator_t & operator=(field_allocator_t &&) = default;
+
+  field_allocator_t(const field_allocator_t &) = delete;
+  field_allocator_t & operator=(const field_allocator_t &) = delete;
+
+  /*!
+    Allocate \em size bytes of zero-initialized storage for a field. If the
+    field is already allocated, it is resized and its contents are preserved
+    up to the smaller of the old and new sizes.
+
+    @param fid   The field id.
+    @param size  The size of the field in bytes.
+    @param pool  The pool from which to allocate, usually the index space
+                 of the field.
+
+    @return A pointer to the field storage.
+   */
+
+  uint8_t * allocate(field_id_t fid, size_t size, size_t pool = DEFAULT_POOL) {
+
+    if(fid >= fields_.size()) {
+      fields_.resize(fid + 1);
+    } // if
+
+    field_t & field = fields_[fid];
+
+    if(field.data != nullptr && size <= field.capacity) {
+      if(size > field.size) {
+        std::memset(field.data + field.size, 0, size - field.size);
+      } // if
+      field.size = size;
+      return field.data;
+    } // if
+
+    const size_t capacity = round_up(std::max(size, size_t{1}));
+
+    // A field that is the last carve of its pool's current slab grows in
+    // place if the slab has room for the new size.
+    if(field.data != nullptr &&
+       pools_[field.pool].extend(field.data, field.capacity, capacity)) {
+      std::memset(field.data + field.size, 0, size - field.size);
+      field.size = size;
+      field.capacity = capacity;
+      return field.data;
+    } // if
+
+    auto [data, carved] = pools_[pool].carve(capacity);
+
+    if(field.data != nullptr) {
+      std::memcpy(data, field.data, field.size);
+      pools_[field.pool].release(field.data, field.capacity);
+    }
+    else {
+      ++registered_;
+    } // if
+
+    field = {data, size, carved, pool};
+    return data;
+  } // allocate
+
+  /*!
+    Reserve \em size bytes for a field in the first slab of a pool. The
+    first slab of a pool holds exactly the fields that have been reserved
+    before it is allocated, rather than SLAB_SIZE bytes. Reservations made
+    after the first allocation from the pool are ignored.
+
+    @param size  The size of the field in bytes.
+    @param pool  The pool of the field.
+   */
+
+  void reserve(size_t size, size_t pool = DEFAULT_POOL) {
+    pools_[pool].reserve(round_up(std::max(size, size_t{1})));
+  } // reserve
+
+  /*!
+    Return true if the field has been allocated.
+   */
+
+  bool contains(field_id_t fid) const {
+    return fid < fields_.size() && fields_[fid].data != nullptr;
+  } // contains
+
+  /*!
+    Return a pointer to the storage of a field, or nullptr if the field
+    has not been allocated.
+   */
+
+  uint8_t * data(field_id_t fid) const {
+    return fid < fields_.size() ? fields_[fid].data : nullptr;
+  } // data
+
+  /*!
+    Return the size in bytes of a field.
+   */
+
+  size_t size(field_id_t fid) const {
+    return fid < fields_.size() ? fields_[fid].size : 0;
+  } // size
+
+  /*!
+    Return the number of allocated fields.
+   */
+
+  size_t fields() const {
+    return registered_;
+  } // fields
+
+  /*!
+    Invoke \em f(fid, data, size) for each allocated field in id order.
+   */
+
+  template<typename FUNCTION>
+  void for_each(FUNCTION && f) const {
+    for(size_t fid{0}; fid < fields_.size(); ++fid) {
+      if(fields_[fid].data != nullptr) {
+        f(field_id_t(fid), fields_[fid].data, fields_[fid].size);
+      } // if
+    } // for
+  } // for_each
+
+private:
+  struct field_t {
+    uint8_t * data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    size_t pool = DEFAULT_POOL;
+  }; // struct field_t
+
+  struct slab_deleter_t {
+    void operator()(uint8_t * p) const {
+      std::free(p);
+    }
+  }; // struct slab_deleter_t
+
+  using slab_t = std::unique_ptr<uint8_t[], slab_deleter_t>;
+
+  /*!
+    A bump allocator over a list of slabs. The storage of fields that have
+    been moved by a resize is kept in a free list and reused by later
+    allocations from the pool. Storage is released when the allocator is
+    destroyed.
+   */
+
+  struct pool_t {
+
+    /*!
+      Return zero-filled storage of at least \em bytes bytes and its
+      actual size.
+     */
+
+    std::pair<uint8_t *, size_t> carve(size_t bytes) {
+      auto f = free_.lower_bound(bytes);
+
+      if(f != free_.end()) {
+        const auto block = *f;
+        free_.erase(f);
+        std::memset(block.second, 0, block.first);
+        return {block.second, block.first};
+      } // if
+
+      if(bytes > remaining_) {
+        const size_t size = slabs_.empty() && reserved_ >= bytes
+                              ? reserved_
+                              : std::max(bytes, SLAB_SIZE);
+        slabs_.emplace_back(allocate_slab(size));
+        next_ = slabs_.back().get();
+        remaining_ = size;
+      } // if
+
+      uint8_t * data = next_;
+      next_ += bytes;
+      remaining_ -= bytes;
+      return {data, bytes};
+    } // carve
+
+    /*!
+      Grow the storage at \em data from \em bytes to \em size bytes if it
+      is the last carve of the current slab and the slab has room for it.
+     */
+
+    bool extend(uint8_t * data, size_t bytes, size_t size) {
+      if(data + bytes != next_ || size - bytes > remaining_) {
+        return false;
+      } // if
+
+      next_ += size - bytes;
+      remaining_ -= size - bytes;
+      return true;
+    } // extend
+
+    /*!
+      Return the storage of a field that has been moved to the free list.
+     */
+
+    void release(uint8_t * data, size_t bytes) {
+      free_.emplace(bytes, data);
+    } // release
+
+    void reserve(size_t bytes) {
+      if(slabs_.empty()) {
+        reserved_ += bytes;
+      } // if
+    } // reserve
+
+  private:
+    std::vector<slab_t> slabs_;
+    std::multimap<size_t, uint8_t *> free_;
+    uint8_t * next_ = nullptr;
+    size_t remaining_ = 0;
+    size_t reserved_ = 0;
+  }; // struct pool_t
+
+  static size_t round_up(size_t bytes, size_t alignment = FIELD_ALIGNMENT) {
+    return (bytes + alignment - 1) / alignment * alignment;
+  } // round_up
+
+  /*!
+    Allocate and first-touch a new slab of at least \em bytes bytes.
+   */
+
+  static uint8_t * allocate_slab(size_t bytes);
+
+  std::vector<field_t> fields_;
+  std::map<size_t, pool_t> pools_;
+  size_t registered_ = 0;
+
+}; // class field_allocator_t
+
+} // namespace data
+} // namespace flecsi
@@ -15,6 +15,8 @@
 
 /*! @file */
 
+#include <cstddef>
+
 namespace flecsi {
 
 enum privilege_t : size_t {
@@ -66,8 +66,14 @@ struct field_registration_wrapper_u {
       typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code();
 
     fi.storage_class = STORAGE_CLASS;
-    fi.size = (STORAGE_CLASS == sparse ? sizeof(DATA_TYPE) + sizeof(size_t)
-                                       : sizeof(DATA_TYPE));
+
+    if constexpr(STORAGE_CLASS == sparse) {
+      fi.size = sizeof(typename sparse_traits_u<DATA_TYPE>::entry_value_t);
+    }
+    else {
+      fi.size = sizeof(DATA_TYPE);
+    } // if
+
     fi.namespace_hash = NAMESPACE_HASH;
     fi.name_hash = NAME_HASH;
     fi.versions = VERSIONS;
@@ -83,7 +89,8 @@ struct field_registration_wrapper_u {
       execution::context_t::instance().register_serdez<serdez_t>(fid);
     } // if
     else if constexpr(STORAGE_CLASS == sparse) {
-      using serdez_t = serdez_u<row_vector_u<sparse_entry_value_u<DATA_TYPE>>>;
+      using serdez_t = serdez_u<
+        row_vector_u<typename sparse_traits_u<DATA_TYPE>::entry_value_t>>;
       execution::context_t::instance().register_serdez<serdez_t>(fid);
     }
   } // register_callback
@@ -16,8 +16,14 @@
 /*! @file */
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
 #include <stdint.h>
 
+#include <flecsi/data/common/data_types.h>
+
 namespace flecsi {
 namespace data {
 
@@ -114,8 +120,10 @@ struct row_vector_u {
   } // resize
 
   void push_back(const T & value) {
+    // Grow geometrically, so that building a row element by element takes
+    // amortized constant time per element.
     if(count == capacity) {
-      reserve(count + 5);
+      reserve(std::max<uint32_t>(4, 2 * count));
     }
     datap[count] = value;
     count += 1;
@@ -134,7 +142,7 @@ struct row_vector_u {
     assert(idx >= 0);
     assert(idx <= count);
     if(count == capacity) {
-      reserve(count + 5);
+      reserve(std::max<uint32_t>(4, 2 * count));
     }
     auto newpos = datap + idx;
     std::copy_backward(newpos, end(), end() + 1);
@@ -149,5 +157,391 @@ struct row_vector_u {
 
 }; // row_vector_u
 
+/*!
+  The rows of structure-of-arrays sparse fields. A row stores its entries
+  and its values as two arrays in one buffer. The arrays are packed by the
+  number of elements, the one with the stricter alignment first, so that
+  the first count * sizeof(soa_entry_value_u<T, INDEX>) bytes of the buffer
+  hold the whole row. The runtimes copy, exchange and serialize these bytes
+  as they do for the other rows, and the members have the same layout as
+  those of the primary template.
+
+  Inserting or erasing an element moves the tail of both arrays, and the
+  start of the second one.
+ */
+
+template<typename T, typename INDEX>
+struct row_vector_u<soa_entry_value_u<T, INDEX>> {
+
+  using element_t = soa_entry_value_u<T, INDEX>;
+  using iterator = element_t *;
+  using const_iterator = const element_t *;
+
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+    "over-aligned sparse values are not supported");
+
+  row_vector_u() = default;
+
+  row_vector_u(const row_vector_u & rhs) {
+    *this = rhs;
+  }
+
+  ~row_vector_u() {
+    delete[] datap;
+  }
+
+  row_vector_u & operator=(const row_vector_u & rhs) {
+    if(&rhs != this) {
+      // The layout only depends on the count, so the bytes are the row.
+      if(rhs.count > capacity) {
+        delete[] datap;
+        datap = new unsigned char[rhs.count * sizeof(element_t)];
+        capacity = rhs.count;
+      } // if
+
+      count = rhs.count;
+      std::memcpy(datap, rhs.datap, count * sizeof(element_t));
+    } // if
+
+    return *this;
+  } // operator =
+
+  iterator begin() {
+    return reinterpret_cast<iterator>(datap);
+  }
+  iterator end() {
+    return begin() + count;
+  }
+  const_iterator begin() const {
+    return reinterpret_cast<const_iterator>(datap);
+  }
+  const_iterator end() const {
+    return begin() + count;
+  }
+
+  uint32_t size() const {
+    return count;
+  }
+
+  element_t * data() {
+    return begin();
+  }
+
+  const element_t * data() const {
+    return begin();
+  }
+
+  INDEX * entries() {
+    return reinterpret_cast<INDEX *>(
+      entries_first ? datap : datap + count * sizeof(T));
+  }
+
+  const INDEX * entries() const {
+    return const_cast<row_vector_u &>(*this).entries();
+  }
+
+  T * values() {
+    return reinterpret_cast<T *>(
+      entries_first ? datap + count * sizeof(INDEX) : datap);
+  }
+
+  const T * values() const {
+    return const_cast<row_vector_u &>(*this).values();
+  }
+
+  /*!
+    Return the position of the first entry not less than \em entry. Short
+    rows are searched by counting the smaller entries, which compiles to
+    vector compares, and longer ones by bisection.
+   */
+
+  uint32_t lower_bound(std::size_t entry) const {
+    if(entry > std::numeric_limits<INDEX>::max()) {
+      return count;
+    } // if
+
+    const INDEX e = static_cast<INDEX>(entry);
+    const INDEX * first = entries();
+
+    if(count <= linear_search_max) {
+      uint32_t position = 0;
+
+      for(uint32_t i = 0; i < count; ++i) {
+        position += first[i] < e;
+      } // for
+
+      return position;
+    } // if
+
+    return std::lower_bound(first, first + count, e) - first;
+  } // lower_bound
+
+  void clear() {
+    count = 0;
+    capacity = 0;
+    delete[] datap;
+    datap = nullptr;
+  }
+
+  void reserve(uint32_t new_cap) {
+    if(new_cap <= capacity) {
+      return;
+    }
+
+    auto new_data = new unsigned char[new_cap * sizeof(element_t)];
+
+    if(count) {
+      std::memcpy(new_data, datap, count * sizeof(element_t));
+    } // if
+
+    delete[] datap;
+    capacity = new_cap;
+    datap = new_data;
+  } // reserve
+
+  void resize(uint32_t new_count) {
+    reserve(new_count);
+
+    const uint32_t kept = std::min(count, new_count);
+
+    if(kept) {
+      std::memmove(datap + new_count * first_size,
+        datap + count * first_size, kept * second_size);
+    } // if
+
+    count = new_count;
+  } // resize
+
+  /*!
+    Insert an entry and its value before position \em pos.
+   */
+
+  void insert(uint32_t pos, INDEX entry, const T & value) {
+    assert(pos <= count);
+
+    if(count == capacity) {
+      reserve(std::max<uint32_t>(4, 2 * count));
+    }
+
+    const uint32_t n = count;
+    unsigned char * second = datap + n * first_size;
+    unsigned char * new_second = second + first_size;
+
+    // Move from the end of the buffer, so that nothing is overwritten
+    // before it has moved.
+    std::memmove(new_second + (pos + 1) * second_size,
+      second + pos * second_size, (n - pos) * second_size);
+    std::memmove(new_second, second, pos * second_size);
+    std::memmove(datap + (pos + 1) * first_size, datap + pos * first_size,
+      (n - pos) * first_size);
+
+    count = n + 1;
+    entries()[pos] = entry;
+    values()[pos] = value;
+  } // insert
+
+  void erase(uint32_t pos) {
+    assert(pos < count);
+
+    const uint32_t n = count;
+    unsigned char * second = datap + n * first_size;
+    unsigned char * new_second = second - first_size;
+
+    // Move from the start of the buffer.
+    std::memmove(datap + pos * first_size, datap + (pos + 1) * first_size,
+      (n - pos - 1) * first_size);
+    std::memmove(new_second, second, pos * second_size);
+    std::memmove(new_second + pos * second_size,
+      second + (pos + 1) * second_size, (n - pos - 1) * second_size);
+
+    count = n - 1;
+  } // erase
+
+  uint32_t count = 0;
+  uint32_t capacity = 0;
+  unsigned char * datap = nullptr;
+
+private:
+  static constexpr bool entries_first = alignof(INDEX) >= alignof(T);
+  static constexpr std::size_t first_size =
+    entries_first ? sizeof(INDEX) : sizeof(T);
+  static constexpr std::size_t second_size =
+    entries_first ? sizeof(T) : sizeof(INDEX);
+  static constexpr uint32_t linear_search_max = 64;
+
+}; // row_vector_u
+
+/*!
+  The rows of padded sparse fields. A row may borrow \em MAX_ENTRIES
+  elements of a buffer that the runtime owns, which it uses until it
+  grows beyond them. It then moves to its own allocation, as the rows of
+  the primary template do. A row that does not borrow storage reserves
+  at least \em MAX_ENTRIES elements when it first allocates.
+
+  Borrowed storage is marked by the high bit of the capacity, so that the
+  members have the same layout as those of the primary template.
+ */
+
+template<typename T, std::size_t MAX_ENTRIES>
+struct row_vector_u<padded_entry_value_u<T, MAX_ENTRIES>> {
+
+  using element_t = padded_entry_value_u<T, MAX_ENTRIES>;
+  using iterator = element_t *;
+  using const_iterator = const element_t *;
+
+  static constexpr uint32_t max_entries = MAX_ENTRIES;
+
+  row_vector_u() = default;
+
+  row_vector_u(const row_vector_u & rhs) {
+    assign(rhs.begin(), rhs.end());
+  }
+
+  ~row_vector_u() {
+    release();
+  }
+
+  row_vector_u & operator=(const row_vector_u & rhs) {
+    if(&rhs != this)
+      assign(rhs.begin(), rhs.end());
+    return *this;
+  }
+
+  iterator begin() {
+    return datap;
+  }
+  iterator end() {
+    return datap + count;
+  }
+  const_iterator begin() const {
+    return datap;
+  }
+  const_iterator end() const {
+    return datap + count;
+  }
+
+  element_t & operator[](uint32_t index) {
+    assert(index < count);
+    return datap[index];
+  } // operator ()
+
+  const element_t & operator[](uint32_t index) const {
+    assert(index < count);
+    return datap[index];
+  } // operator ()
+
+  uint32_t size() const {
+    return count;
+  }
+
+  element_t * data() {
+    return datap;
+  }
+
+  const element_t * data() const {
+    return datap;
+  }
+
+  /*!
+    Return true if the row uses borrowed storage.
+   */
+
+  bool padded() const {
+    return capacity & borrowed;
+  }
+
+  /*!
+    Use the \em MAX_ENTRIES elements at \em storage, which must outlive
+    the row, if they can hold the row. Return true if the row uses them.
+   */
+
+  bool borrow(element_t * storage) {
+    if(count > max_entries) {
+      return false;
+    } // if
+
+    std::copy_n(datap, count, storage);
+    release();
+    capacity = max_entries | borrowed;
+    datap = storage;
+    return true;
+  } // borrow
+
+  void clear() {
+    count = 0;
+    release();
+    capacity = 0;
+    datap = nullptr;
+  }
+
+  void assign(const_iterator first, const_iterator last) {
+    resize(last - first);
+    std::copy(first, last, datap);
+  }
+
+  void reserve(uint32_t new_cap) {
+    if(new_cap <= (capacity & ~borrowed)) {
+      return;
+    }
+
+    // Rows that overflow their padding move to their own allocation.
+    new_cap = std::max(new_cap, max_entries);
+    auto new_data = new element_t[new_cap];
+    std::copy_n(datap, count, new_data);
+    release();
+    capacity = new_cap;
+    datap = new_data;
+  } // reserve
+
+  void resize(uint32_t new_count) {
+    reserve(new_count);
+    count = new_count;
+  } // resize
+
+  void push_back(const element_t & value) {
+    if(count == (capacity & ~borrowed)) {
+      reserve(std::max<uint32_t>(4, 2 * count));
+    }
+    datap[count] = value;
+    count += 1;
+  } // push_back
+
+  void erase(const_iterator pos) {
+    auto idx = pos - datap;
+    assert(idx >= 0);
+    assert(idx < count);
+    std::copy(datap + idx + 1, end(), datap + idx);
+    count -= 1;
+  } // erase
+
+  iterator insert(const_iterator pos, const element_t & value) {
+    auto idx = pos - datap;
+    assert(idx >= 0);
+    assert(idx <= count);
+    if(count == (capacity & ~borrowed)) {
+      reserve(std::max<uint32_t>(4, 2 * count));
+    }
+    auto newpos = datap + idx;
+    std::copy_backward(newpos, end(), end() + 1);
+    *newpos = value;
+    count += 1;
+    return newpos;
+  } // insert
+
+  uint32_t count = 0;
+  uint32_t capacity = 0;
+  element_t * datap = nullptr;
+
+private:
+  static constexpr uint32_t borrowed = uint32_t(1) << 31;
+
+  void release() {
+    if(!padded()) {
+      delete[] datap;
+    } // if
+  } // release
+
+}; // row_vector_u
+
 } // namespace data
 } // namespace flecsi
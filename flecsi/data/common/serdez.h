@@ -115,6 +115,7 @@ public:
   virtual size_t deserialize(void * field_ptr, std::istream & is) const = 0;
 
   virtual size_t deep_copy(const void * ptr_in, void * ptr_out) const = 0;
+  virtual void destroy(void * field_ptr) const = 0;
 
 }; // class serdez_untyped_t
 
@@ -144,6 +145,11 @@ public:
     auto out = static_cast<TYPE *>(ptr_out);
     return SERDEZ::deep_copy(*in, *out);
   }
+  virtual void destroy(void * field_ptr) const {
+    using TYPE = typename SERDEZ::FIELD_TYPE;
+    auto item_ptr = static_cast<TYPE *>(field_ptr);
+    SERDEZ::destroy(*item_ptr);
+  }
 }; // class serdez_wrapper_u
 
 } // namespace data
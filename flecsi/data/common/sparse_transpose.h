@@ -0,0 +1,167 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <cstddef>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace flecsi {
+namespace data {
+
+//----------------------------------------------------------------------------//
+//! The sparse_transpose_t type is the entry-major view of a sparse field,
+//! in compressed sparse row form: for each entry present in the field, it
+//! lists the indices whose row holds the entry, and the position (slot) of
+//! the entry in the row. The indices of an entry are in increasing order,
+//! so that the exclusive and shared indices come first, and the ghost
+//! indices last.
+//!
+//! The view only depends on the structure of the field, not on its
+//! values, so it stays valid until the field is mutated.
+//!
+//! @ingroup data
+//----------------------------------------------------------------------------//
+
+struct sparse_transpose_t {
+
+  //--------------------------------------------------------------------------//
+  //! Build the view.
+  //!
+  //! @param num_owned The number of exclusive and shared indices.
+  //! @param num_total The number of indices, including the ghosts.
+  //! @param row_size  A callable that returns the size of the row of an
+  //!                  index.
+  //! @param entry_at  A callable that returns the entry of an index at a
+  //!                  position of its row.
+  //--------------------------------------------------------------------------//
+
+  template<typename ROW_SIZE, typename ENTRY_AT>
+  void build(size_t num_owned,
+    size_t num_total,
+    ROW_SIZE && row_size,
+    ENTRY_AT && entry_at) {
+    entries.clear();
+
+    for(size_t index = 0; index < num_total; ++index) {
+      const size_t size = row_size(index);
+
+      for(size_t slot = 0; slot < size; ++slot) {
+        entries.push_back(entry_at(index, slot));
+      } // for
+    } // for
+
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+    // Count the owned and the ghost items of each entry.
+    offsets.assign(entries.size() + 1, 0);
+    ghost_offsets.assign(entries.size(), 0);
+
+    for(size_t index = 0; index < num_total; ++index) {
+      const size_t size = row_size(index);
+
+      for(size_t slot = 0; slot < size; ++slot) {
+        const size_t k = find(entry_at(index, slot));
+        ++offsets[k + 1];
+
+        if(index < num_owned) {
+          ++ghost_offsets[k];
+        } // if
+      } // for
+    } // for
+
+    for(size_t k = 0; k < entries.size(); ++k) {
+      offsets[k + 1] += offsets[k];
+      ghost_offsets[k] += offsets[k];
+    } // for
+
+    // Fill the items in index order, which puts the ghosts last.
+    indices.resize(offsets.back());
+    slots.resize(offsets.back());
+
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+
+    for(size_t index = 0; index < num_total; ++index) {
+      const size_t size = row_size(index);
+
+      for(size_t slot = 0; slot < size; ++slot) {
+        const size_t item = next[find(entry_at(index, slot))]++;
+        indices[item] = index;
+        slots[item] = slot;
+      } // for
+    } // for
+
+    valid = true;
+  } // build
+
+  //--------------------------------------------------------------------------//
+  //! Mark the view as out of date, e.g., after the field was mutated.
+  //--------------------------------------------------------------------------//
+
+  void invalidate() {
+    valid = false;
+  } // invalidate
+
+  //--------------------------------------------------------------------------//
+  //! Return the position of \em entry in the entries of the view, or the
+  //! number of entries if the entry is not present.
+  //--------------------------------------------------------------------------//
+
+  size_t find(size_t entry) const {
+    const auto itr = std::lower_bound(entries.begin(), entries.end(), entry);
+    return itr != entries.end() && *itr == entry ? itr - entries.begin()
+                                                 : entries.size();
+  } // find
+
+  //--------------------------------------------------------------------------//
+  //! Return the range [begin, end) of the items of \em entry in the
+  //! indices and slots, optionally including those of the ghost indices.
+  //--------------------------------------------------------------------------//
+
+  std::pair<size_t, size_t> items(size_t entry, bool ghosts = false) const {
+    const size_t k = find(entry);
+
+    if(k == entries.size()) {
+      return {0, 0};
+    } // if
+
+    return {offsets[k], ghosts ? offsets[k + 1] : ghost_offsets[k]};
+  } // items
+
+  //! The entries present in the field, in increasing order.
+  std::vector<size_t> entries;
+
+  //! The items of entries[k] are [offsets[k], offsets[k + 1]).
+  std::vector<size_t> offsets;
+
+  //! The ghost items of entries[k] are [ghost_offsets[k], offsets[k + 1]).
+  std::vector<size_t> ghost_offsets;
+
+  //! The index of each item.
+  std::vector<size_t> indices;
+
+  //! The position of the entry in the row of the index of each item.
+  std::vector<uint32_t> slots;
+
+  bool valid = false;
+
+}; // struct sparse_transpose_t
+
+} // namespace data
+} // namespace flecsi
@@ -101,8 +101,9 @@ struct field_interface_u {
       // CRF hack - for now, use lowest bits of name_hash as serdez id
       int sid = NAME_HASH & 0x7FFFFFFF;
       if constexpr(STORAGE_CLASS == sparse) {
-        Runtime::register_custom_serdez_op<
-          serdez_u<row_vector_u<sparse_entry_value_u<DATA_TYPE>>>>(sid);
+        Runtime::register_custom_serdez_op<serdez_u<
+          row_vector_u<typename sparse_traits_u<DATA_TYPE>::entry_value_t>>>(
+          sid);
       }
       else {
         Runtime::register_custom_serdez_op<serdez_u<row_vector_u<DATA_TYPE>>>(
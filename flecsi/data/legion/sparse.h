@@ -140,7 +140,7 @@ struct storage_class_u<sparse> {
   //--------------------------------------------------------------------------//
 
   template<typename T>
-  using entry_value_u = data::sparse_entry_value_u<T>;
+  using entry_value_u = typename data::sparse_traits_u<T>::entry_value_t;
 
   template<typename DATA_CLIENT_TYPE,
     typename DATA_TYPE,
@@ -165,15 +165,12 @@ struct storage_class_u<color> {
       typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code(),
       utils::hash::field_hash<NAMESPACE, NAME>(VERSION));
 
-    auto & registered_field_data = context.registered_field_data();
-    auto fieldDataIter = registered_field_data.find(field_info.fid);
-    if(fieldDataIter == registered_field_data.end()) {
+    auto data = context.field_data(field_info.fid);
+    if(data == nullptr) {
       // TODO: deal with VERSION
-      context.register_field_data(field_info.fid, field_info.size);
+      data = context.register_field_data(field_info.fid, field_info.size);
     }
 
-    auto data = registered_field_data[field_info.fid].data();
-
     h.fid = field_info.fid;
     h.index_space = field_info.index_space;
     h.data_client_hash = field_info.data_client_hash;
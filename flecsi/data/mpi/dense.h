@@ -147,22 +147,24 @@ struct storage_class_u<dense> {
       (context.coloring_info(field_info.index_space)).at(context.color());
     auto & index_coloring = context.coloring(field_info.index_space);
 
-    auto & registered_field_data = context.registered_field_data();
-    auto fieldDataIter = registered_field_data.find(field_info.fid);
-    if(fieldDataIter == registered_field_data.end()) {
+    auto data = context.field_data(field_info.fid);
+    if(data == nullptr) {
       size_t size = field_info.size * (color_info.exclusive +
                                         color_info.shared + color_info.ghost);
       // TODO: deal with VERSION
-      context.register_field_data(field_info.fid, size);
+      data = context.register_field_data(
+        field_info.fid, size, field_info.index_space);
     }
+    // The one-sided ghost windows are only used with one color per rank.
+    // Otherwise, ghosts are exchanged by context_t::exchange_dense_ghosts.
     auto fieldMetaDataIter =
       context.registered_field_metadata().find(field_info.fid);
-    if(fieldMetaDataIter == context.registered_field_metadata().end()) {
+    if(context.colors_per_rank() == 1 &&
+       fieldMetaDataIter == context.registered_field_metadata().end()) {
       context.register_field_metadata<DATA_TYPE>(
         field_info.fid, color_info, index_coloring);
     }
 
-    auto data = registered_field_data[field_info.fid].data();
     // populate data member of data_handle_t
     auto & hb = dynamic_cast<dense_data_handle_u<DATA_TYPE, 0, 0, 0> &>(h);
 
@@ -121,6 +121,24 @@ struct storage_class_u<ragged> {
 
     using vector_t = typename ragged_data_handle_u<DATA_TYPE>::vector_t;
     hb.rows = reinterpret_cast<vector_t *>(&fd.rows[0]);
+    hb.transpose = fd.transpose.get();
+
+    if constexpr(data::is_padded_entry_value_u<DATA_TYPE>::value) {
+      // Move the rows into the buffer of the field on first use. Rows
+      // that are too long stay in their own allocation.
+      constexpr size_t max_entries = DATA_TYPE::max_entries;
+
+      if(fd.padding.empty()) {
+        fd.padding.resize(fd.num_total * max_entries * sizeof(DATA_TYPE));
+        auto padding = reinterpret_cast<DATA_TYPE *>(fd.padding.data());
+
+        for(size_t r = 0; r < fd.num_total; ++r) {
+          hb.rows[r].borrow(padding + r * max_entries);
+        } // for
+      } // if
+
+      hb.padding = reinterpret_cast<DATA_TYPE *>(fd.padding.data());
+    } // if
 
     return h;
   }
@@ -145,7 +163,7 @@ struct storage_class_u<sparse> {
   //--------------------------------------------------------------------------//
 
   template<typename T>
-  using entry_value_u = data::sparse_entry_value_u<T>;
+  using entry_value_u = typename data::sparse_traits_u<T>::entry_value_t;
 
   template<typename DATA_CLIENT_TYPE,
     typename DATA_TYPE,
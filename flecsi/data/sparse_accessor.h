@@ -17,12 +17,14 @@
 
 #include <algorithm>
 #include <iostream>
-#include <unordered_set>
+#include <limits>
+#include <vector>
 
 #include <cinchlog.h>
 
 #include <flecsi/data/accessor.h>
 #include <flecsi/data/common/data_types.h>
+#include <flecsi/data/common/sparse_transpose.h>
 #include <flecsi/data/ragged_accessor.h>
 #include <flecsi/data/sparse_data_handle.h>
 #include <flecsi/topology/index_space.h>
@@ -34,7 +36,11 @@ struct sparse_access { // shared between accessor and mutator
 protected:
   using ragged_t = R;
   using entry_value_t = typename ragged_t::value_type;
+  using value_t = typename entry_value_t::value_t;
   using vector_t = typename ragged_t::handle_t::vector_t;
+
+  static constexpr bool soa = data::is_soa_entry_value_u<entry_value_t>::value;
+
   vector_t & row(std::size_t i) {
     return ragged.handle[i];
   }
@@ -42,39 +48,114 @@ protected:
     return ragged.handle[i];
   }
 
-public:
-  using index_space_t =
-    topology::index_space_u<topology::simple_entry_u<size_t>, true>;
-
-  // for row 'index', return pointer to first entry not less
+  // for 'row', return the position of the first entry not less
   // than 'entry'
-  static typename vector_t::iterator lower_bound(vector_t & row, size_t entry) {
-    auto start = row.begin();
-    auto end = row.end();
+  FLECSI_INLINE_TARGET
+  static std::size_t lower_bound(const vector_t & row, size_t entry) {
+    if constexpr(soa) {
+      return row.lower_bound(entry);
+    }
+    else {
+      const auto itr = std::lower_bound(row.begin(), row.end(),
+        entry_value_t(entry),
+        [](const entry_value_t & k1, const entry_value_t & k2) -> bool {
+          return k1.entry < k2.entry;
+        });
+      return itr - row.begin();
+    } // if
+  } // lower_bound
 
-    // find where entry should be
-    auto itr = std::lower_bound(start, end, entry_value_t(entry),
-      [](const entry_value_t & k1, const entry_value_t & k2) -> bool {
-        return k1.entry < k2.entry;
-      });
+  // for 'row', return the position of 'entry', or the size of the
+  // row if it is not present
+  FLECSI_INLINE_TARGET
+  static std::size_t find(const vector_t & row, size_t entry) {
+    const std::size_t position = lower_bound(row, entry);
+    return position != row.size() && entry_at(row, position) == entry
+             ? position
+             : row.size();
+  } // find
 
-    return itr;
+  FLECSI_INLINE_TARGET
+  static std::size_t entry_at(const vector_t & row, std::size_t position) {
+    if constexpr(soa) {
+      return row.entries()[position];
+    }
+    else {
+      return row.begin()[position].entry;
+    } // if
+  } // entry_at
 
-  } // lower_bound
+  FLECSI_INLINE_TARGET
+  static value_t & value_at(vector_t & row, std::size_t position) {
+    if constexpr(soa) {
+      return row.values()[position];
+    }
+    else {
+      return row.begin()[position].value;
+    } // if
+  } // value_at
 
-  // for row 'index', return pointer to first entry not less
-  // than 'entry'
-  static typename vector_t::const_iterator lower_bound(const vector_t & row,
-    size_t entry) {
-    return lower_bound(const_cast<vector_t &>(row), entry);
-  } // lower_bound
+  FLECSI_INLINE_TARGET
+  static const value_t & value_at(const vector_t & row,
+    std::size_t position) {
+    return value_at(const_cast<vector_t &>(row), position);
+  } // value_at
+
+  // convert 'entry' to the entry type of the rows
+  static auto to_entry(size_t entry) {
+    if constexpr(soa) {
+      using index_t = typename entry_value_t::index_t;
+      clog_assert(entry <= std::numeric_limits<index_t>::max(),
+        "sparse entry " << entry << " does not fit the entry index type");
+      return static_cast<index_t>(entry);
+    }
+    else {
+      return entry;
+    } // if
+  } // to_entry
+
+  // insert 'entry' before 'position'
+  static value_t &
+  insert_at(vector_t & row, std::size_t position, size_t entry, value_t value) {
+    if constexpr(soa) {
+      row.insert(position, to_entry(entry), value);
+    }
+    else {
+      row.insert(row.begin() + position, entry_value_t(entry, value));
+    } // if
+
+    return value_at(row, position);
+  } // insert_at
+
+  static void
+  set_at(vector_t & row, std::size_t position, size_t entry, value_t value) {
+    if constexpr(soa) {
+      row.entries()[position] = to_entry(entry);
+      row.values()[position] = value;
+    }
+    else {
+      row.begin()[position] = entry_value_t(entry, value);
+    } // if
+  } // set_at
+
+  static void erase_at(vector_t & row, std::size_t position) {
+    if constexpr(soa) {
+      row.erase(position);
+    }
+    else {
+      row.erase(row.begin() + position);
+    } // if
+  } // erase_at
+
+public:
+  using index_space_t =
+    topology::index_space_u<topology::simple_entry_u<size_t>, true>;
 
   // for row 'index', test whether entry 'entry' is present
   FLECSI_INLINE_TARGET
   bool contains(size_t index, size_t entry) const {
     auto & r = row(index);
-    const auto itr = lower_bound(r, entry);
-    return itr != r.end() && itr->entry == entry;
+    return find(r, entry) != r.size();
   } // contains
 
   void dump() {
@@ -85,39 +166,44 @@ public:
 
       for(std::size_t end = i + n; i < end; ++i) {
         std::cout << "  index: " << i << std::endl;
-        const auto & row = h_.rows[i];
-        for(const auto & ev : row) {
-          std::cout << "    +" << ev.entry << " = " << ev.value << std::endl;
+        const auto & r = h_.rows[i];
+        for(std::size_t p = 0; p < r.size(); ++p) {
+          std::cout << "    +" << entry_at(r, p) << " = " << value_at(r, p)
+                    << std::endl;
         }
       }
     };
-    f("exclusive", h_.num_exclusive);
-    f("shared", h_.num_shared);
-    f("ghost", h_.num_ghost);
+    f("exclusive", h_.num_exclusive());
+    f("shared", h_.num_shared());
+    f("ghost", h_.num_ghost());
   } // dump
 
   //-------------------------------------------------------------------------//
-  //! Return all entries used over all indices.
+  //! Return all entries used over all indices, in increasing order.
   //-------------------------------------------------------------------------//
   FLECSI_INLINE_TARGET
   index_space_t entries() const {
     auto & handle = ragged.handle;
-    size_t id = 0;
-    index_space_t is;
-    std::unordered_set<size_t> found;
+    std::vector<size_t> found;
 
     for(size_t index = 0; index < handle.num_total_; ++index) {
       const auto & row = handle.rows[index];
 
-      for(const auto & ev : row) {
-        size_t entry = ev.entry;
-        if(found.find(entry) == found.end()) {
-          is.push_back({id++, entry});
-          found.insert(entry);
-        }
+      for(size_t position = 0; position < row.size(); ++position) {
+        found.push_back(entry_at(row, position));
       }
     }
 
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+
+    index_space_t is;
+    size_t id = 0;
+
+    for(size_t entry : found) {
+      is.push_back({id++, entry});
+    }
+
     return is;
   }
 
@@ -137,8 +223,8 @@ public:
 
     size_t id = 0;
     const auto & row = handle.rows[index];
-    for(const auto & ev : row) {
-      is.push_back({id++, ev.entry});
+    for(size_t position = 0; position < row.size(); ++position) {
+      is.push_back({id++, entry_at(row, position)});
     }
 
     return is;
@@ -174,8 +260,7 @@ public:
 
     for(size_t index = 0; index < handle.num_total_; ++index) {
       const auto & r = row(index);
-      const auto itr = lower_bound(r, entry);
-      if(itr != r.end() && itr->entry == entry) {
+      if(find(r, entry) != r.size()) {
         is.push_back({id++, index});
       }
     }
@@ -227,17 +312,20 @@ struct accessor_u<data::sparse,
       EXCLUSIVE_PERMISSIONS,
       SHARED_PERMISSIONS,
       GHOST_PERMISSIONS>,
-    sparse_access<ragged_accessor<data::sparse_entry_value_u<T>,
+    sparse_access<ragged_accessor<
+      typename data::sparse_traits_u<T>::entry_value_t,
       EXCLUSIVE_PERMISSIONS,
       SHARED_PERMISSIONS,
       GHOST_PERMISSIONS>>,
     public sparse_accessor_base_t {
 private:
-  using base = sparse_access<ragged_accessor<data::sparse_entry_value_u<T>,
-    EXCLUSIVE_PERMISSIONS,
-    SHARED_PERMISSIONS,
-    GHOST_PERMISSIONS>>;
+  using base = sparse_access<
+    ragged_accessor<typename data::sparse_traits_u<T>::entry_value_t,
+      EXCLUSIVE_PERMISSIONS,
+      SHARED_PERMISSIONS,
+      GHOST_PERMISSIONS>>;
   using typename base::entry_value_t; // factor usage?
+  using typename base::value_t;
 
 public:
   using typename base::index_space_t; // unless we can factor the usage?
@@ -251,23 +339,22 @@ public:
   //! return a reference to it.
   //-------------------------------------------------------------------------//
   FLECSI_INLINE_TARGET
-  T & operator()(size_t index, size_t entry) {
+  value_t & operator()(size_t index, size_t entry) {
     auto & r = this->row(index);
-    const auto itr = base::lower_bound(r, entry);
-    assert(itr != r.end() && itr->entry == entry &&
-           "sparse accessor: unmapped entry");
+    const auto position = base::find(r, entry);
+    assert(position != r.size() && "sparse accessor: unmapped entry");
 
-    return itr->value;
+    return base::value_at(r, position);
   } // operator ()
 
   FLECSI_INLINE_TARGET
-  const T & operator()(size_t index, size_t entry) const {
+  const value_t & operator()(size_t index, size_t entry) const {
     return const_cast<accessor_u &>(*this)(index, entry);
   } // operator ()
 
   //! a struct used for accessing elements.
   struct result_t {
-    const T * value_ptr = nullptr; //!< a pointer to the element
+    const value_t * value_ptr = nullptr; //!< a pointer to the element
     bool exists = false; //!< a boolean, true if element exists
   };
 
@@ -279,19 +366,98 @@ public:
   //-------------------------------------------------------------------------//
   result_t at(size_t index, size_t entry) const {
     const auto & r = this->row(index);
-    const auto itr = base::lower_bound(r, entry);
+    const auto position = base::find(r, entry);
 
-    if(itr != r.end() && itr->entry == entry)
-      return result_t{&itr->value, true};
+    if(position != r.size())
+      return result_t{&base::value_at(r, position), true};
     else
       return result_t{nullptr, false};
   } // at()
 
   template<typename E>
-  FLECSI_INLINE_TARGET T & operator()(E * e, size_t entry) {
+  FLECSI_INLINE_TARGET value_t & operator()(E * e, size_t entry) {
     return this->operator()(e->id(), entry);
   } // operator ()
 
+  //-------------------------------------------------------------------------//
+  //! Return the entry-major view of the field, which lists the indices
+  //! that hold each entry. The view is cached with the field data, and
+  //! rebuilt by the first call after the field was mutated, so it must not
+  //! be called concurrently, e.g., from within a parallel loop. If the
+  //! runtime does not cache the view, it is rebuilt on each call and valid
+  //! until the next call on the same thread.
+  //-------------------------------------------------------------------------//
+  const data::sparse_transpose_t & transpose() const {
+    auto & handle = this->ragged.handle;
+    data::sparse_transpose_t * t = handle.transpose;
+
+    if(t == nullptr) {
+      thread_local data::sparse_transpose_t local;
+      local.invalidate();
+      t = &local;
+    } // if
+
+    if(!t->valid) {
+      t->build(handle.num_exclusive() + handle.num_shared(), handle.num_total_,
+        [&](size_t index) { return size_t(handle.rows[index].size()); },
+        [&](size_t index, size_t slot) {
+          return base::entry_at(handle.rows[index], slot);
+        });
+    } // if
+
+    return *t;
+  } // transpose
+
+  //-------------------------------------------------------------------------//
+  //! Call f(index, value) for each index that holds \em entry, in
+  //! increasing order, and for the ghost indices only if \em ghosts is
+  //! true. This reads the indices and the positions of the entry
+  //! contiguously from the entry-major view.
+  //-------------------------------------------------------------------------//
+  template<typename FUNCTION>
+  void for_each_index(size_t entry, FUNCTION && f, bool ghosts = false) {
+    const auto & t = transpose();
+    const auto items = t.items(entry, ghosts);
+
+    for(size_t item = items.first; item < items.second; ++item) {
+      const size_t index = t.indices[item];
+      f(index, base::value_at(this->row(index), t.slots[item]));
+    } // for
+  } // for_each_index
+
+  using base::entries;
+  using base::indices;
+
+  //-------------------------------------------------------------------------//
+  //! Return all entries used over all indices, in increasing order.
+  //-------------------------------------------------------------------------//
+  index_space_t entries() const {
+    index_space_t is;
+    size_t id = 0;
+
+    for(size_t entry : transpose().entries) {
+      is.push_back({id++, entry});
+    } // for
+
+    return is;
+  } // entries
+
+  //-------------------------------------------------------------------------//
+  //! Return all indices allocated for a given entry, including the ghosts.
+  //-------------------------------------------------------------------------//
+  index_space_t indices(size_t entry) const {
+    const auto & t = transpose();
+    const auto items = t.items(entry, true);
+    index_space_t is;
+    size_t id = 0;
+
+    for(size_t item = items.first; item < items.second; ++item) {
+      is.push_back({id++, t.indices[item]});
+    } // for
+
+    return is;
+  } // indices
+
   //-------------------------------------------------------------------------//
   //! Return the maximum possible entries
   //-------------------------------------------------------------------------//
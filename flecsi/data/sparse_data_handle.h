@@ -17,6 +17,7 @@
 
 #include <flecsi/data/common/data_types.h>
 #include <flecsi/data/common/row_vector.h>
+#include <flecsi/data/common/sparse_transpose.h>
 
 namespace flecsi {
 
@@ -67,6 +68,32 @@ struct ragged_data_handle_base_u : public DATA_POLICY {
     return rows[i];
   }
 
+  /*!
+    Return the storage of the \em n rows from row \em first in the buffer
+    of a padded sparse field, if they all use it and it holds
+    max_entries_per_index elements per row, so that the rows are laid out
+    as one array. Return nullptr otherwise.
+   */
+
+  T * padded_block(size_t first, size_t n) const {
+    if constexpr(data::is_padded_entry_value_u<T>::value) {
+      if(padding == nullptr || T::max_entries != max_entries_per_index) {
+        return nullptr;
+      } // if
+
+      for(size_t r = first; r < first + n; ++r) {
+        if(!rows[r].padded() || rows[r].datap != padding + r * T::max_entries) {
+          return nullptr;
+        } // if
+      } // for
+
+      return padding + first * T::max_entries;
+    }
+    else {
+      return nullptr;
+    } // if
+  } // padded_block
+
   size_t num_exclusive_;
   size_t num_shared_;
   size_t num_ghost_;
@@ -78,6 +105,14 @@ struct ragged_data_handle_base_u : public DATA_POLICY {
 
   vector_t * rows = nullptr;
 
+  // The cached entry-major view of a sparse field, if the runtime keeps
+  // one with the field data.
+  data::sparse_transpose_t * transpose = nullptr;
+
+  // The buffer of the rows of a padded sparse field, if the runtime keeps
+  // one with the field data.
+  T * padding = nullptr;
+
 }; // ragged_data_handle_base_u
 
 } // namespace flecsi
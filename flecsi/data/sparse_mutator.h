@@ -17,9 +17,14 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <tuple>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <flecsi/data/mutator.h>
+#include <flecsi/data/ragged_mutator.h>
 #include <flecsi/data/sparse_accessor.h>
 #include <flecsi/topology/index_space.h>
 
@@ -41,6 +46,14 @@ struct sparse_mutator_base_t {};
 //! index into these buffers, and keeps entries in sorted order per index.
 //! Entries may also be deleted with erase().
 //!
+//! Rows that are rebuilt, e.g., by a remap, should use the batched
+//! operations instead: append() and assign() add entries in any order, and
+//! erase_if() removes the entries that match a predicate. The rows are
+//! sorted, and duplicate entries removed, once per row by commit(), which
+//! is called when the task ends. Until then, operator(), erase() and
+//! contains() must not be used on the rows changed by append() or
+//! assign().
+//!
 //! @tparam T                     The data type referenced by the handle.
 //!
 //! @ingroup data
@@ -49,48 +62,158 @@ struct sparse_mutator_base_t {};
 template<typename T>
 struct mutator_u<data::sparse, T>
   : public mutator_u<data::base, T>,
-    sparse_access<mutator_u<data::ragged, data::sparse_entry_value_u<T>>>,
+    sparse_access<mutator_u<data::ragged,
+      typename data::sparse_traits_u<T>::entry_value_t>>,
     public sparse_mutator_base_t {
 private:
-  using base =
-    sparse_access<mutator_u<data::ragged, data::sparse_entry_value_u<T>>>;
+  using base = sparse_access<
+    mutator_u<data::ragged, typename data::sparse_traits_u<T>::entry_value_t>>;
   using typename base::entry_value_t;
+  using typename base::value_t;
 
 public:
   using typename base::index_space_t;
 
   mutator_u(const typename base::ragged_t::handle_t & h) : base{h} {}
 
-  T & operator()(size_t index, size_t entry) {
+  value_t & operator()(size_t index, size_t entry) {
     auto & r = this->row(index);
-    const auto itr = base::lower_bound(r, entry);
+    const auto position = base::lower_bound(r, entry);
 
     // if we are attempting to create an entry that already exists
     // just over-write the value and exit.
-    if(itr != r.end() && itr->entry == entry) {
-      return itr->value;
+    if(position != r.size() && base::entry_at(r, position) == entry) {
+      return base::value_at(r, position);
     }
 
     // otherwise, create a new entry
-    auto ritr = r.insert(itr, {entry, T()});
-    return ritr->value;
+    return base::insert_at(r, position, entry, value_t());
 
   } // operator ()
 
   void erase(size_t index, size_t entry) {
     auto & r = this->row(index);
-    const auto itr = base::lower_bound(r, entry);
+    const auto position = base::find(r, entry);
 
     // if we are attempting to erase an entry that doesn't exist,
     // then just return
-    if(itr == r.end() || itr->entry != entry) {
+    if(position == r.size()) {
       return;
     }
 
     // otherwise, erase
-    r.erase(itr);
+    base::erase_at(r, position);
 
   } // erase
+
+  //-------------------------------------------------------------------------//
+  //! Add an entry to the end of a row, in any order. If the entry is
+  //! already present, or is appended again, the last value wins at commit.
+  //-------------------------------------------------------------------------//
+
+  void append(size_t index, size_t entry, const value_t & value) {
+    auto & r = this->row(index);
+    base::insert_at(r, r.size(), entry, value);
+  } // append
+
+  //-------------------------------------------------------------------------//
+  //! Replace a row with a range of (entry, value) pairs, in any order.
+  //-------------------------------------------------------------------------//
+
+  template<typename ITERATOR>
+  void assign(size_t index, ITERATOR first, ITERATOR last) {
+    auto & r = this->row(index);
+    r.resize(std::distance(first, last));
+
+    for(size_t position = 0; first != last; ++first, ++position) {
+      base::set_at(r, position, std::get<0>(*first), std::get<1>(*first));
+    } // for
+  } // assign
+
+  //-------------------------------------------------------------------------//
+  //! Erase the entries of a row for which predicate(entry, value) is true,
+  //! in a single pass over the row. The order of the other entries is
+  //! kept. Return the number of erased entries.
+  //-------------------------------------------------------------------------//
+
+  template<typename PREDICATE>
+  size_t erase_if(size_t index, PREDICATE && predicate) {
+    auto & r = this->row(index);
+    const size_t size = r.size();
+    size_t kept = 0;
+
+    for(size_t position = 0; position < size; ++position) {
+      const size_t entry = base::entry_at(r, position);
+      const value_t & value = base::value_at(r, position);
+
+      if(!predicate(entry, value)) {
+        if(kept != position) {
+          base::set_at(r, kept, entry, value);
+        } // if
+
+        ++kept;
+      } // if
+    } // for
+
+    r.resize(kept);
+    return size - kept;
+  } // erase_if
+
+  //-------------------------------------------------------------------------//
+  //! Sort the rows changed by append() and assign(), and remove their
+  //! duplicate entries, keeping the value that was added last. A sorted row
+  //! is only checked. Otherwise the unsorted tail of the row is sorted and
+  //! merged with its sorted head.
+  //-------------------------------------------------------------------------//
+
+  void commit() {
+    auto & h = this->ragged.handle;
+    std::vector<std::pair<size_t, value_t>> scratch;
+
+    const auto less = [](const auto & a, const auto & b) {
+      return a.first < b.first;
+    };
+
+    for(size_t index = 0; index < h.num_total_; ++index) {
+      auto & r = this->row(index);
+      const size_t size = r.size();
+
+      size_t sorted = 1;
+      while(sorted < size &&
+            base::entry_at(r, sorted - 1) < base::entry_at(r, sorted)) {
+        ++sorted;
+      } // while
+
+      if(sorted >= size) {
+        continue;
+      } // if
+
+      scratch.clear();
+
+      for(size_t position = 0; position < size; ++position) {
+        scratch.emplace_back(
+          base::entry_at(r, position), base::value_at(r, position));
+      } // for
+
+      // Both steps are stable, so equal entries stay in the order in which
+      // they were added.
+      std::stable_sort(scratch.begin() + sorted, scratch.end(), less);
+      std::inplace_merge(
+        scratch.begin(), scratch.begin() + sorted, scratch.end(), less);
+
+      size_t kept = 0;
+
+      for(size_t i = 0; i < size; ++i) {
+        if(i + 1 < size && scratch[i + 1].first == scratch[i].first) {
+          continue;
+        } // if
+
+        base::set_at(r, kept++, scratch[i].first, scratch[i].second);
+      } // for
+
+      r.resize(kept);
+    } // for
+  } // commit
 }; // mutator_u
 
 template<typename T>
@@ -0,0 +1,119 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Tests related to the storage of registered fields.
+////////////////////////////////////////////////////////////////////////////////
+
+// user includes
+#include <flecsi/data/common/field_allocator.h>
+
+// system includes
+#include <cinchtest.h>
+#include <cstdint>
+#include <cstring>
+
+// explicitly use some stuff
+using flecsi::data::field_allocator_t;
+
+namespace {
+
+constexpr size_t alignment = field_allocator_t::FIELD_ALIGNMENT;
+
+void
+fill(uint8_t * data, size_t size, uint8_t value) {
+  std::memset(data, value, size);
+} // fill
+
+void
+check(const uint8_t * data, size_t begin, size_t end, uint8_t value) {
+  for(size_t i(begin); i < end; ++i) {
+    ASSERT_EQ(data[i], value);
+  } // for
+} // check
+
+} // namespace
+
+//=============================================================================
+//! \brief The reserved fields of an index space share its first slab.
+//=============================================================================
+TEST(field_allocator, reserve) {
+  field_allocator_t fields;
+
+  fields.reserve(100, 0);
+  fields.reserve(3 * alignment, 0);
+
+  auto a = fields.allocate(0, 100, 0);
+  auto b = fields.allocate(1, 3 * alignment, 0);
+
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(a) % alignment, 0);
+  ASSERT_EQ(b, a + 2 * alignment);
+  ASSERT_EQ(fields.fields(), 2);
+
+  check(a, 0, 100, 0);
+  check(b, 0, 3 * alignment, 0);
+} // TEST
+
+//=============================================================================
+//! \brief The last field of a slab grows in place.
+//=============================================================================
+TEST(field_allocator, extend) {
+  field_allocator_t fields;
+
+  auto a = fields.allocate(0, 10, 0);
+  fill(a, 10, 7);
+
+  auto b = fields.allocate(0, 4 * alignment, 0);
+
+  ASSERT_EQ(a, b);
+  ASSERT_EQ(fields.size(0), 4 * alignment);
+  ASSERT_EQ(fields.fields(), 1);
+  check(b, 0, 10, 7);
+  check(b, 10, 4 * alignment, 0);
+
+  // The next field follows the grown one.
+  auto c = fields.allocate(1, 1, 0);
+  ASSERT_EQ(c, b + 4 * alignment);
+} // TEST
+
+//=============================================================================
+//! \brief The storage of a field that moves is reused by the pool.
+//=============================================================================
+TEST(field_allocator, reuse) {
+  field_allocator_t fields;
+
+  auto a = fields.allocate(0, 2 * alignment, 0);
+  fill(a, 2 * alignment, 3);
+
+  auto b = fields.allocate(1, alignment, 0);
+  fill(b, alignment, 5);
+
+  // Field 0 can not grow in place, since field 1 follows it.
+  auto moved = fields.allocate(0, 3 * alignment, 0);
+
+  ASSERT_NE(moved, a);
+  check(moved, 0, 2 * alignment, 3);
+  check(moved, 2 * alignment, 3 * alignment, 0);
+  check(b, 0, alignment, 5);
+
+  // The storage that field 0 left behind is zero-filled and handed out to
+  // the next field that fits in it.
+  auto c = fields.allocate(2, alignment + 1, 0);
+
+  ASSERT_EQ(c, a);
+  ASSERT_EQ(fields.data(2), a);
+  check(c, 0, alignment + 1, 0);
+
+  // It is not reused by another pool.
+  auto d = fields.allocate(3, 1, 1);
+  ASSERT_NE(d, a);
+
+  ASSERT_EQ(fields.fields(), 4);
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
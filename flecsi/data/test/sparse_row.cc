@@ -0,0 +1,347 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Tests related to the rows of sparse fields.
+////////////////////////////////////////////////////////////////////////////////
+
+// user includes
+#include <flecsi/data/common/privilege.h>
+#include <flecsi/data/common/row_vector.h>
+#include <flecsi/data/common/serdez.h>
+#include <flecsi/data/sparse_accessor.h>
+#include <flecsi/data/sparse_mutator.h>
+
+// system includes
+#include <cinchtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// explicitly use some stuff
+using flecsi::data::row_vector_u;
+using flecsi::data::soa_entry_value_u;
+using flecsi::data::soa_u;
+
+using fraction_t = soa_u<double, uint16_t>;
+using entry_value_t = soa_entry_value_u<double, uint16_t>;
+using row_t = row_vector_u<entry_value_t>;
+
+namespace {
+
+void
+check_row(const row_t & row, const std::vector<uint16_t> & entries) {
+  ASSERT_EQ(row.size(), entries.size());
+
+  for(size_t i(0); i < entries.size(); ++i) {
+    ASSERT_EQ(row.entries()[i], entries[i]);
+    ASSERT_EQ(row.values()[i], 0.5 * entries[i]);
+  } // for
+} // check_row
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the packed layout of structure-of-arrays rows.
+///////////////////////////////////////////////////////////////////////////////
+TEST(sparse_row, soa) {
+  ASSERT_EQ(sizeof(entry_value_t), sizeof(uint16_t) + sizeof(double));
+  ASSERT_EQ(sizeof(row_t), sizeof(row_vector_u<uint8_t>));
+
+  row_t row;
+
+  for(uint16_t e : {7, 3, 9, 1, 5}) {
+    row.insert(row.lower_bound(e), e, 0.5 * e);
+  } // for
+
+  check_row(row, {1, 3, 5, 7, 9});
+
+  // The values come first, and the entries follow them.
+  auto bytes = reinterpret_cast<const unsigned char *>(row.data());
+  ASSERT_EQ(reinterpret_cast<const unsigned char *>(row.values()), bytes);
+  ASSERT_EQ(reinterpret_cast<const unsigned char *>(row.entries()),
+    bytes + 5 * sizeof(double));
+
+  ASSERT_EQ(row.lower_bound(4), 2);
+  ASSERT_EQ(row.lower_bound(10), 5);
+  ASSERT_EQ(row.lower_bound(1 << 20), 5);
+
+  row.erase(0);
+  row.erase(2);
+  check_row(row, {3, 5, 9});
+
+  row.resize(5);
+  ASSERT_EQ(row.entries()[2], 9);
+  row.resize(2);
+  check_row(row, {3, 5});
+
+  row_t copy(row);
+  copy.insert(2, 11, 5.5);
+  check_row(copy, {3, 5, 11});
+  check_row(row, {3, 5});
+
+  // Rows are serialized as bytes.
+  using serdez_t = flecsi::data::serdez_u<row_t>;
+  std::vector<char> buffer(serdez_t::serialized_size(copy));
+  ASSERT_EQ(serdez_t::serialize(copy, buffer.data()), buffer.size());
+
+  row_t result;
+  serdez_t::deserialize(result, buffer.data());
+  check_row(result, {3, 5, 11});
+
+  // Search long rows by bisection.
+  row_t row2;
+
+  for(uint16_t e(0); e < 200; ++e) {
+    row2.insert(row2.size(), 2 * e, e);
+  } // for
+
+  ASSERT_EQ(row2.lower_bound(101), 51);
+  ASSERT_EQ(row2.lower_bound(398), 199);
+  ASSERT_EQ(row2.lower_bound(399), 200);
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test accessors and mutators of structure-of-arrays fields.
+///////////////////////////////////////////////////////////////////////////////
+TEST(sparse_row, access) {
+  std::vector<row_t> rows(3);
+
+  flecsi::ragged_data_handle_u<entry_value_t> h(8);
+  h.init(3, 0, 0);
+  h.rows = rows.data();
+
+  flecsi::sparse_mutator<fraction_t> m(h);
+
+  m(0, 4) = 2.0;
+  m(0, 2) = 1.0;
+  m(2, 4) = 2.0;
+  m(2, 4) = 3.0;
+  m(1, 65535) = 4.0;
+  m.erase(0, 3);
+
+  ASSERT_EQ(rows[0].size(), 2);
+  ASSERT_EQ(rows[2].size(), 1);
+  ASSERT_TRUE(m.contains(0, 2));
+  ASSERT_FALSE(m.contains(0, 3));
+  ASSERT_FALSE(m.contains(1, 65536 + 65535));
+
+  flecsi::sparse_accessor<fraction_t, flecsi::rw, flecsi::rw, flecsi::ro> a(
+    h);
+
+  ASSERT_EQ(a(0, 2), 1.0);
+  ASSERT_EQ(a(0, 4), 2.0);
+  ASSERT_EQ(a(2, 4), 3.0);
+  ASSERT_EQ(a(1, 65535), 4.0);
+  ASSERT_FALSE(a.at(1, 0).exists);
+
+  a(0, 4) += 1.0;
+  ASSERT_EQ(*a.at(0, 4).value_ptr, 3.0);
+
+  ASSERT_EQ(a.entries().size(), 3);
+  ASSERT_EQ(a.indices(4).size(), 2);
+
+  m.erase(0, 2);
+  m.erase(0, 4);
+  ASSERT_EQ(a.indices().size(), 2);
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the batched operations of mutators.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void
+check_batched() {
+  using entry_value_t =
+    typename flecsi::data::sparse_traits_u<T>::entry_value_t;
+  std::vector<row_vector_u<entry_value_t>> rows(3);
+
+  flecsi::ragged_data_handle_u<entry_value_t> h(8);
+  h.init(3, 0, 0);
+  h.rows = rows.data();
+
+  flecsi::sparse_mutator<T> m(h);
+
+  m(0, 2) = 1.0;
+  m(0, 6) = 3.0;
+
+  // Appended entries may repeat, and the last value wins.
+  for(size_t e : {9, 4, 2, 7, 4, 0}) {
+    m.append(0, e, 10.0 + e);
+  } // for
+  m.append(0, 4, 1.5);
+
+  const std::vector<std::pair<size_t, double>> row1{{5, 0.5}, {1, 0.1},
+    {3, 0.3}};
+  m.assign(1, row1.begin(), row1.end());
+
+  m(2, 1) = 1.0;
+  m(2, 2) = 2.0;
+  m(2, 3) = 3.0;
+  ASSERT_EQ(m.erase_if(2, [](size_t e, double) { return e != 2; }), 2);
+
+  m.commit();
+
+  flecsi::sparse_accessor<T, flecsi::ro, flecsi::ro, flecsi::ro> a(h);
+
+  ASSERT_EQ(rows[0].size(), 6);
+  ASSERT_EQ(a(0, 0), 10.0);
+  ASSERT_EQ(a(0, 2), 12.0);
+  ASSERT_EQ(a(0, 4), 1.5);
+  ASSERT_EQ(a(0, 6), 3.0);
+  ASSERT_EQ(a(0, 7), 17.0);
+  ASSERT_EQ(a(0, 9), 19.0);
+
+  ASSERT_EQ(rows[1].size(), 3);
+  ASSERT_EQ(a(1, 1), 0.1);
+  ASSERT_EQ(a(1, 3), 0.3);
+  ASSERT_EQ(a(1, 5), 0.5);
+
+  ASSERT_EQ(rows[2].size(), 1);
+  ASSERT_EQ(a(2, 2), 2.0);
+
+  // A sorted row is left as is.
+  m.commit();
+  ASSERT_EQ(rows[0].size(), 6);
+} // check_batched
+
+TEST(sparse_row, batched) {
+  check_batched<double>();
+  check_batched<fraction_t>();
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the entry-major view of sparse fields.
+///////////////////////////////////////////////////////////////////////////////
+TEST(sparse_row, transpose) {
+  std::vector<row_t> rows(4);
+  flecsi::data::sparse_transpose_t cache;
+
+  // Index 3 is a ghost.
+  flecsi::ragged_data_handle_u<entry_value_t> h(8);
+  h.init(2, 1, 1);
+  h.rows = rows.data();
+
+  flecsi::sparse_mutator<fraction_t> m(h);
+
+  m(0, 4) = 0.4;
+  m(1, 2) = 1.2;
+  m(1, 4) = 1.4;
+  m(2, 4) = 2.4;
+  m(3, 4) = 3.4;
+  m(3, 7) = 3.7;
+
+  for(auto transpose : {&cache, (flecsi::data::sparse_transpose_t *)nullptr}) {
+    h.transpose = transpose;
+    flecsi::sparse_accessor<fraction_t, flecsi::rw, flecsi::rw, flecsi::ro> a(
+      h);
+
+    const auto & t = a.transpose();
+    ASSERT_EQ(t.entries, (std::vector<size_t>{2, 4, 7}));
+    ASSERT_EQ(t.items(4), std::make_pair(size_t(1), size_t(4)));
+    ASSERT_EQ(t.items(4, true), std::make_pair(size_t(1), size_t(5)));
+    ASSERT_EQ(t.items(7), std::make_pair(size_t(5), size_t(5)));
+    ASSERT_EQ(t.items(5).first, t.items(5).second);
+
+    std::vector<size_t> indices;
+    a.for_each_index(4, [&](size_t index, double & value) {
+      indices.push_back(index);
+      value = 10.0 + index;
+    });
+    ASSERT_EQ(indices, (std::vector<size_t>{0, 1, 2}));
+    ASSERT_EQ(a(1, 4), 11.0);
+    ASSERT_EQ(a(3, 4), 3.4);
+
+    indices.clear();
+    a.for_each_index(
+      7, [&](size_t index, double &) { indices.push_back(index); }, true);
+    ASSERT_EQ(indices, (std::vector<size_t>{3}));
+
+    ASSERT_EQ(a.entries().size(), 3);
+    ASSERT_EQ(a.indices(4).size(), 4);
+    ASSERT_EQ(a.indices(2).size(), 1);
+  } // for
+
+  // The cached view is rebuilt after it was invalidated.
+  h.transpose = &cache;
+  m(0, 9) = 0.9;
+  ASSERT_EQ(cache.entries.size(), 3);
+  cache.invalidate();
+
+  flecsi::sparse_accessor<fraction_t, flecsi::ro, flecsi::ro, flecsi::ro> a(h);
+  ASSERT_EQ(a.transpose().entries, (std::vector<size_t>{2, 4, 7, 9}));
+  ASSERT_EQ(&a.transpose(), &cache);
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test padded rows that borrow the buffer of the field.
+///////////////////////////////////////////////////////////////////////////////
+TEST(sparse_row, padded) {
+  using padded_t = flecsi::data::padded_u<double, 2>;
+  using padded_value_t =
+    typename flecsi::data::sparse_traits_u<padded_t>::entry_value_t;
+  using padded_row_t = row_vector_u<padded_value_t>;
+
+  ASSERT_EQ(sizeof(padded_row_t), sizeof(row_vector_u<uint8_t>));
+
+  std::vector<padded_row_t> rows(3);
+  std::vector<padded_value_t> padding(3 * 2);
+
+  flecsi::ragged_data_handle_u<padded_value_t> h(2);
+  h.init(1, 1, 1);
+  h.rows = rows.data();
+
+  flecsi::sparse_mutator<padded_t> m(h);
+  m(1, 3) = 1.3;
+
+  for(size_t r(0); r < 3; ++r) {
+    ASSERT_TRUE(rows[r].borrow(&padding[2 * r]));
+  } // for
+  h.padding = padding.data();
+
+  ASSERT_EQ(padding[2].entry, 3);
+  ASSERT_EQ(padding[2].value, 1.3);
+  ASSERT_EQ(h.padded_block(1, 2), &padding[2]);
+
+  m(1, 1) = 1.1;
+  m(2, 5) = 2.5;
+  ASSERT_TRUE(rows[1].padded());
+  ASSERT_EQ(padding[2].entry, 1);
+  ASSERT_EQ(padding[4].entry, 5);
+
+  // A row that outgrows its padding moves to its own allocation.
+  m(0, 0) = 0.0;
+  m(0, 1) = 0.1;
+  m(0, 2) = 0.2;
+  ASSERT_FALSE(rows[0].padded());
+  ASSERT_EQ(rows[0].size(), 3);
+  ASSERT_EQ(h.padded_block(0, 2), nullptr);
+  ASSERT_EQ(h.padded_block(1, 2), &padding[2]);
+
+  flecsi::sparse_accessor<padded_t, flecsi::ro, flecsi::ro, flecsi::ro> a(h);
+  ASSERT_EQ(a(0, 2), 0.2);
+  ASSERT_EQ(a(1, 1), 1.1);
+  ASSERT_EQ(a(1, 3), 1.3);
+  ASSERT_EQ(a(2, 5), 2.5);
+
+  // A row that is too long cannot borrow.
+  ASSERT_FALSE(rows[0].borrow(&padding[0]));
+
+  // Copies own their storage.
+  padded_row_t copy(rows[1]);
+  ASSERT_FALSE(copy.padded());
+  ASSERT_EQ(copy[1].entry, 3);
+
+  for(auto & row : rows) {
+    row.clear();
+  } // for
+
+  check_batched<padded_t>();
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
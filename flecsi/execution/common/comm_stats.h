@@ -0,0 +1,196 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <flecsi-config.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#if defined(FLECSI_ENABLE_MPI)
+#include <mpi.h>
+#endif
+
+#include <flecsi/runtime/types.h>
+
+namespace flecsi {
+namespace execution {
+
+/*!
+  The field_comm_stats_t type counts the ghost updates of one field on one
+  rank. Messages include one-sided gets. With the MPI runtime, the bytes
+  sent are the bytes of the shared entities that the ghost owners of other
+  ranks read, whether they are pushed or pulled.
+
+  @ingroup execution
+ */
+
+struct field_comm_stats_t {
+
+  /*!
+    Add one ghost update.
+
+    @param nmessages  The number of messages of the update.
+    @param sent       The number of bytes sent.
+    @param received   The number of bytes received.
+    @param nneighbors The number of ranks communicated with.
+    @param wait       The time in seconds spent waiting for completion.
+   */
+
+  void record(size_t nmessages,
+    size_t sent,
+    size_t received,
+    size_t nneighbors,
+    double wait) {
+    ++exchanges;
+    messages += nmessages;
+    bytes_sent += sent;
+    bytes_received += received;
+    neighbors = std::max(neighbors, nneighbors);
+    wait_time += wait;
+  } // record
+
+  /*!
+    Combine the counters of the same field on another rank. Messages and
+    bytes are summed, and the other counters keep their maximum, i.e., the
+    count and the wait time of the busiest rank.
+   */
+
+  void merge(const field_comm_stats_t & other) {
+    exchanges = std::max(exchanges, other.exchanges);
+    messages += other.messages;
+    bytes_sent += other.bytes_sent;
+    bytes_received += other.bytes_received;
+    neighbors = std::max(neighbors, other.neighbors);
+    wait_time = std::max(wait_time, other.wait_time);
+  } // merge
+
+  size_t index_space = 0;
+  size_t exchanges = 0;
+  size_t messages = 0;
+  size_t bytes_sent = 0;
+  size_t bytes_received = 0;
+  size_t neighbors = 0;
+  double wait_time = 0.0;
+}; // struct field_comm_stats_t
+
+using field_comm_stats_map_t = std::map<field_id_t, field_comm_stats_t>;
+
+/*!
+  Write a table of communication statistics, one line per field, ordered
+  by decreasing wait time.
+
+  @ingroup execution
+ */
+
+inline void
+write_comm_stats(std::ostream & stream, const field_comm_stats_map_t & stats) {
+  std::vector<field_comm_stats_map_t::const_iterator> rows;
+
+  for(auto it = stats.begin(); it != stats.end(); ++it) {
+    rows.push_back(it);
+  } // for
+
+  std::stable_sort(rows.begin(), rows.end(), [](auto a, auto b) {
+    return a->second.wait_time > b->second.wait_time;
+  });
+
+  stream << std::setw(8) << "field" << std::setw(8) << "space"
+         << std::setw(12) << "exchanges" << std::setw(12) << "messages"
+         << std::setw(16) << "bytes sent" << std::setw(16) << "bytes recv"
+         << std::setw(10) << "nbrs" << std::setw(12) << "wait (s)"
+         << std::endl;
+
+  for(auto it : rows) {
+    auto & s = it->second;
+    stream << std::setw(8) << it->first << std::setw(8) << s.index_space
+           << std::setw(12) << s.exchanges << std::setw(12) << s.messages
+           << std::setw(16) << s.bytes_sent << std::setw(16)
+           << s.bytes_received << std::setw(10) << s.neighbors
+           << std::setw(12) << std::fixed << std::setprecision(6)
+           << s.wait_time << std::endl;
+  } // for
+} // write_comm_stats
+
+#if defined(FLECSI_ENABLE_MPI)
+
+/*!
+  Gather the communication statistics of every rank and merge them on
+  \em root. Ranks may hold statistics for different fields. The result is
+  empty on the other ranks.
+
+  @ingroup execution
+ */
+
+inline field_comm_stats_map_t
+reduce_comm_stats(const field_comm_stats_map_t & stats,
+  MPI_Comm comm,
+  int root = 0) {
+  struct record_t {
+    std::uint64_t fid;
+    field_comm_stats_t stats;
+  }; // struct record_t
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  std::vector<record_t> local;
+
+  for(auto & s : stats) {
+    local.push_back({s.first, s.second});
+  } // for
+
+  int bytes = local.size() * sizeof(record_t);
+  std::vector<int> counts(size), displs(size + 1, 0);
+
+  MPI_Gather(&bytes, 1, MPI_INT, counts.data(), 1, MPI_INT, root, comm);
+
+  for(int r(0); r < size; ++r) {
+    displs[r + 1] = displs[r] + counts[r];
+  } // for
+
+  const size_t nrecords = rank == root ? displs[size] / sizeof(record_t) : 0;
+  std::vector<record_t> all(nrecords);
+
+  MPI_Gatherv(local.data(), bytes, MPI_BYTE, all.data(), counts.data(),
+    displs.data(), MPI_BYTE, root, comm);
+
+  field_comm_stats_map_t result;
+
+  for(auto & r : all) {
+    auto it = result.find(r.fid);
+
+    if(it == result.end()) {
+      result.emplace(r.fid, r.stats);
+    }
+    else {
+      it->second.merge(r.stats);
+    } // if
+  } // for
+
+  return result;
+} // reduce_comm_stats
+
+#endif // FLECSI_ENABLE_MPI
+
+} // namespace execution
+} // namespace flecsi
@@ -0,0 +1,182 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <flecsi-config.h>
+
+#if !defined(FLECSI_ENABLE_MPI)
+#error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include <cinchlog.h>
+#include <mpi.h>
+
+#include <flecsi/utils/mpi_type_traits.h>
+
+namespace flecsi {
+namespace execution {
+
+namespace reduction {
+
+template<typename T>
+struct min;
+
+template<typename T>
+struct max;
+
+template<typename T>
+struct sum;
+
+template<typename T>
+struct product;
+
+} // namespace reduction
+
+/*!
+  The mpi_reduction_value_u type describes how a reduced value is passed
+  to the predefined MPI operations. Arrays of MPI predefined types are
+  passed element-wise, so that the predefined operations apply to them.
+  Other values are passed as one element of their own datatype.
+
+  @tparam T The type of the reduced value.
+
+  @ingroup execution
+ */
+
+template<typename T, typename = void>
+struct mpi_reduction_value_u {
+  using element_t = T;
+  static constexpr int count = 1;
+}; // struct mpi_reduction_value_u
+
+template<typename T, std::size_t SIZE>
+struct mpi_reduction_value_u<std::array<T, SIZE>,
+  std::enable_if_t<utils::mpi_typetraits_u<T>::builtin>> {
+  using element_t = T;
+  static constexpr int count = SIZE;
+}; // struct mpi_reduction_value_u
+
+/*!
+  The mpi_reduction_op_u type maps the built-in reduction types, on scalars
+  or arrays of MPI predefined types, to the predefined MPI operations, which
+  MPI implementations optimize and may offload to the network. Other
+  reduction types are not native and must be registered with
+  MPI_Op_create.
+
+  @tparam OPERATION The reduction type.
+
+  @ingroup execution
+ */
+
+template<typename OPERATION>
+struct mpi_reduction_op_u {
+  static constexpr bool native = false;
+}; // struct mpi_reduction_op_u
+
+#define flecsi_mpi_native_reduction(operation, mpi_op)                        \
+  template<typename T>                                                         \
+  struct mpi_reduction_op_u<reduction::operation<T>> {                         \
+    static constexpr bool native = utils::mpi_typetraits_u<                    \
+      typename mpi_reduction_value_u<T>::element_t>::builtin;                  \
+                                                                               \
+    static MPI_Op op() {                                                       \
+      return mpi_op;                                                           \
+    }                                                                          \
+  }
+
+flecsi_mpi_native_reduction(min, MPI_MIN);
+flecsi_mpi_native_reduction(max, MPI_MAX);
+flecsi_mpi_native_reduction(sum, MPI_SUM);
+flecsi_mpi_native_reduction(product, MPI_PROD);
+
+#undef flecsi_mpi_native_reduction
+
+/*!
+  Return whether \em op is one of the predefined MPI operations of the
+  built-in reductions.
+ */
+
+inline bool
+mpi_reduction_native(MPI_Op op) {
+  return op == MPI_MIN || op == MPI_MAX || op == MPI_SUM || op == MPI_PROD;
+} // mpi_reduction_native
+
+/*!
+  Return the MPI datatype and count with which a value of type T is passed
+  to the reduction operation \em op. Only the predefined operations receive
+  arrays element-wise. User-defined operations receive one element of a
+  contiguous datatype of sizeof(T) bytes, so that MPI never splits a value
+  between two calls of the operation.
+
+  @param op    The registered MPI operation of the reduction.
+  @param types The registered datatypes of non-P.O.D. types, by type hash.
+ */
+
+template<typename T>
+std::pair<MPI_Datatype, int>
+mpi_reduction_datatype(MPI_Op op, std::map<size_t, MPI_Datatype> & types) {
+  using value_t = mpi_reduction_value_u<T>;
+  using element_t = typename value_t::element_t;
+
+  if constexpr(utils::mpi_typetraits_u<element_t>::builtin) {
+    if(mpi_reduction_native(op)) {
+      return {utils::mpi_typetraits_u<element_t>::type(), value_t::count};
+    } // if
+  } // if
+
+  if constexpr(!std::is_pod_v<T>) {
+    auto dtype = types.find(typeid(T).hash_code());
+
+    clog_assert(dtype != types.end(), "invalid reduction operation");
+
+    return {dtype->second, 1};
+  }
+  else {
+    return {utils::mpi_typetraits_u<T>::type(), 1};
+  } // if
+} // mpi_reduction_datatype
+
+/*!
+  Reduce the values of a user-defined reduction type in an MPI operation.
+  The buffers hold \em len values of the datatype that
+  mpi_reduction_datatype selects.
+
+  @ingroup execution
+ */
+
+template<typename OPERATION>
+void
+mpi_reduction_wrapper(void * in, void * inout, int * len, MPI_Datatype *) {
+  using lhs_t = typename OPERATION::LHS;
+  using rhs_t = typename OPERATION::RHS;
+
+  lhs_t * lhs = reinterpret_cast<lhs_t *>(inout);
+  rhs_t * rhs = reinterpret_cast<rhs_t *>(in);
+
+  for(int i{0}; i < *len; ++i) {
+    OPERATION::apply(lhs[i], rhs[i]);
+  } // for
+} // mpi_reduction_wrapper
+
+} // namespace execution
+} // namespace flecsi
@@ -21,6 +21,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <cinchlog.h>
 
@@ -30,6 +31,7 @@
 #include <flecsi/coloring/coloring_types.h>
 #include <flecsi/coloring/index_coloring.h>
 #include <flecsi/data/common/serdez.h>
+#include <flecsi/execution/common/comm_stats.h>
 #include <flecsi/execution/common/execution_state.h>
 #include <flecsi/execution/global_object_wrapper.h>
 #include <flecsi/runtime/types.h>
@@ -278,7 +280,8 @@ struct context_u : public CONTEXT_POLICY {
 
   /*!
     Add an index map. This map can be used to go between mesh and locally
-    compacted index spaces.
+    compacted index spaces. An existing map of the index space, and its
+    reverse map, are replaced.
 
     @param index_space The map key.
     @param index_map   The map to add.
@@ -286,6 +289,7 @@ struct context_u : public CONTEXT_POLICY {
 
   void add_index_map(size_t index_space, std::map<size_t, size_t> & index_map) {
     index_map_[index_space] = index_map;
+    reverse_index_map_[index_space].clear();
 
     for(auto i : index_map) {
       reverse_index_map_[index_space][i.second] = i.first;
@@ -659,6 +663,72 @@ struct context_u : public CONTEXT_POLICY {
     return coloring_info_;
   } // colorings
 
+  /*!
+    Set the order in which the exclusive entities of an index space are
+    stored locally, e.g., to improve cache locality. Entry \em i of
+    \em order is the position, in id order, of the exclusive entity that
+    is stored at local index \em i. Shared and ghost entities are not
+    affected, since their positions are part of the ghost exchange. An
+    empty order restores id order.
+
+    This must be called before the index maps are built, i.e., during the
+    specialization top-level initialization, so that the topology and the
+    field storage of the index space are created in this order. Only the
+    MPI runtime honors this order.
+
+    @param index_space The index space.
+    @param order       The permutation of the exclusive entities.
+   */
+
+  void set_exclusive_order(size_t index_space, std::vector<size_t> order) {
+    clog_assert(order.empty() ||
+                  order.size() == coloring(index_space).exclusive.size(),
+      "exclusive order does not match the coloring of index space "
+        << index_space);
+
+    exclusive_orders_[index_space] = std::move(order);
+  } // set_exclusive_order
+
+  /*!
+    Return the ids of the entities of an index space in local storage
+    order, i.e., the exclusive entities, in the order given to
+    set_exclusive_order, followed by the shared and ghost entities in id
+    order.
+
+    @param index_space The index space.
+   */
+
+  std::vector<size_t> storage_ids(size_t index_space) {
+    const auto & is = coloring(index_space);
+
+    std::vector<size_t> ids;
+    ids.reserve(is.exclusive.size() + is.shared.size() + is.ghost.size());
+
+    for(auto & e : is.exclusive) {
+      ids.push_back(e.id);
+    } // for
+
+    auto it = exclusive_orders_.find(index_space);
+
+    if(it != exclusive_orders_.end() && !it->second.empty()) {
+      std::vector<size_t> exclusive(ids);
+
+      for(size_t i(0); i < exclusive.size(); ++i) {
+        ids[i] = exclusive[it->second[i]];
+      } // for
+    } // if
+
+    for(auto & e : is.shared) {
+      ids.push_back(e.id);
+    } // for
+
+    for(auto & e : is.ghost) {
+      ids.push_back(e.id);
+    } // for
+
+    return ids;
+  } // storage_ids
+
   /*!
     Add an adjacency/connectivity from one index space to another.
 
@@ -852,6 +922,47 @@ struct context_u : public CONTEXT_POLICY {
     return execution_state_;
   } // execution_state
 
+  //--------------------------------------------------------------------------//
+  // Communication statistics interface.
+  //--------------------------------------------------------------------------//
+
+  /*!
+    Return the counters of the ghost updates of a field on this rank. The
+    reference stays valid for the rest of the run, so that it can be cached
+    by communication plans.
+
+    @param fid         The field id.
+    @param index_space The index space of the field.
+   */
+
+  field_comm_stats_t & comm_stats(field_id_t fid, size_t index_space) {
+    auto & stats = comm_stats_[fid];
+    stats.index_space = index_space;
+    return stats;
+  } // comm_stats
+
+  /*!
+    Return the counters of the ghost updates of every field that has
+    communicated on this rank.
+   */
+
+  const field_comm_stats_map_t & comm_stats() const {
+    return comm_stats_;
+  } // comm_stats
+
+  /*!
+    Reset the counters of the ghost updates, e.g., to exclude the
+    initialization from the statistics.
+   */
+
+  void reset_comm_stats() {
+    for(auto & s : comm_stats_) {
+      const size_t index_space = s.second.index_space;
+      s.second = field_comm_stats_t{};
+      s.second.index_space = index_space;
+    } // for
+  } // reset_comm_stats
+
 private:
   // Default constructor
   context_u() : CONTEXT_POLICY() {}
@@ -928,6 +1039,18 @@ private:
 
   std::map<size_t, index_coloring_t> colorings_;
 
+  //--------------------------------------------------------------------------//
+  // key: index space, value: local order of the exclusive entities
+  //--------------------------------------------------------------------------//
+
+  std::map<size_t, std::vector<size_t>> exclusive_orders_;
+
+  //--------------------------------------------------------------------------//
+  // key: field id, value: counters of the ghost updates of the field
+  //--------------------------------------------------------------------------//
+
+  field_comm_stats_map_t comm_stats_;
+
   //--------------------------------------------------------------------------//
   // key: mesh index space entity id
   //--------------------------------------------------------------------------//
@@ -1048,21 +1171,21 @@ public:
 
     std::ofstream file(filename, std::ios::out | std::ios::binary);
 
-    size_t nfields = CONTEXT_POLICY::field_data.size();
+    auto & field_data = CONTEXT_POLICY::registered_field_data();
+    size_t nfields = field_data.fields();
     file.write((char *)&nfields, sizeof(size_t));
 
-    for(const auto & [id, data] : CONTEXT_POLICY::field_data) {
-      size_t fid = id;
+    field_data.for_each([&file](size_t fid, const uint8_t * data, size_t len) {
       file.write((char *)&fid, sizeof(size_t));
-      size_t len = data.size();
       file.write((char *)&len, sizeof(size_t));
-      file.write((char *)data.data(), len);
-    }
+      file.write((const char *)data, len);
+    });
 
-    nfields = CONTEXT_POLICY::sparse_field_data.size();
+    auto & sparse_field_data = CONTEXT_POLICY::registered_sparse_field_data();
+    nfields = sparse_field_data.size();
     file.write((char *)&nfields, sizeof(size_t));
 
-    for(const auto & [id, data] : CONTEXT_POLICY::sparse_field_data) {
+    for(const auto & [id, data] : sparse_field_data) {
       size_t fid = id;
       file.write((char *)&fid, sizeof(size_t));
       auto serdez = get_serdez(fid);
@@ -1085,15 +1208,9 @@ public:
       size_t len;
       file.read((char *)&len, sizeof(size_t));
 
-      auto it = CONTEXT_POLICY::field_data.find(fid);
-      if(it == CONTEXT_POLICY::field_data.end()) {
-        CONTEXT_POLICY::register_field_data(fid, len);
-        it = CONTEXT_POLICY::field_data.find(fid);
-      }
-      assert(it != CONTEXT_POLICY::field_data.end() && "messed up");
-
-      it->second.resize(len);
-      file.read((char *)it->second.data(), len);
+      // Registering an existing field resizes it.
+      auto data = CONTEXT_POLICY::register_field_data(fid, len);
+      file.read((char *)data, len);
     }
 
     file.read((char *)&nfields, sizeof(size_t));
@@ -1102,16 +1219,17 @@ public:
       size_t fid;
       file.read((char *)&fid, sizeof(size_t));
 
-      auto it = CONTEXT_POLICY::sparse_field_data.find(fid);
-      if(it == CONTEXT_POLICY::sparse_field_data.end()) {
+      auto & sparse_field_data =
+        CONTEXT_POLICY::registered_sparse_field_data();
+      auto it = sparse_field_data.find(fid);
+      if(it == sparse_field_data.end()) {
         using map_type =
-          typename decltype(CONTEXT_POLICY::sparse_field_data)::value_type;
+          typename std::decay_t<decltype(sparse_field_data)>::value_type;
         using value_type = typename std::tuple_element<1, map_type>::type;
-        auto ret = CONTEXT_POLICY::sparse_field_data.emplace(fid, value_type{});
+        auto ret = sparse_field_data.emplace(fid, value_type{});
         it = ret.first;
       }
-      assert(
-        it != CONTEXT_POLICY::sparse_field_data.end() && "sparse messed up");
+      assert(it != sparse_field_data.end() && "sparse messed up");
 
       auto serdez = get_serdez(fid);
       it->second.read(file, serdez);
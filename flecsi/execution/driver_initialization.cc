@@ -23,5 +23,12 @@
 
 int
 driver_initialization(int argc, char ** argv) {
-  return flecsi::execution::context_t::instance().initialize(argc, argv);
+  auto & context_ = flecsi::execution::context_t::instance();
+  const int result = context_.initialize(argc, argv);
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+  context_.finalize();
+#endif
+
+  return result;
 } // driver_initialization
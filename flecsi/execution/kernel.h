@@ -92,6 +92,651 @@ private:
   forall_t{iterator, name} + KOKKOS_LAMBDA(auto it)
 
 } // namespace flecsi
+
+#else
+
+#include <flecsi/concurrency/range_executor.h>
+#include <flecsi/utils/trace.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace flecsi {
+
+namespace kernel_internal {
+
+/*!
+  Return true if the ids of the given index space map its offsets
+  [begin_offset(), end_offset()) onto a contiguous block of its storage.
+  In this case, the index indirection can be skipped and the inner loop
+  can be vectorized. The first storage offset is returned in \em base.
+ */
+
+template<typename ITERATOR>
+inline bool
+identity_range(ITERATOR const &, size_t &) {
+  return false;
+} // identity_range
+
+template<class T,
+  bool STORAGE,
+  bool OWNED,
+  bool SORTED,
+  template<typename, typename...>
+  class ID_STORAGE_TYPE,
+  template<typename, typename...>
+  class STORAGE_TYPE>
+inline bool
+identity_range(topology::index_space_u<T,
+                 STORAGE,
+                 OWNED,
+                 SORTED,
+                 void,
+                 ID_STORAGE_TYPE,
+                 STORAGE_TYPE> const & index_space,
+  size_t & base) {
+  return index_space.contiguous(base);
+} // identity_range
+
+/*!
+  Execute \em lambda over the sub-range [begin, end) of \em iterator.
+ */
+
+template<typename ITERATOR, typename LAMBDA>
+inline void
+execute_range(ITERATOR const & iterator,
+  LAMBDA & lambda,
+  bool identity,
+  size_t base,
+  size_t begin,
+  size_t end) {
+
+  if constexpr(std::is_integral_v<ITERATOR>) {
+    FLECSI_SIMD_LOOP
+    for(ITERATOR i = begin; i < ITERATOR(end); ++i) {
+      lambda(i);
+    } // for
+  }
+  else {
+    if(identity) {
+      using cast_t = typename ITERATOR::cast_t;
+      using storage_t = typename ITERATOR::storage_t;
+      auto & storage = *const_cast<storage_t *>(iterator.storage());
+
+      FLECSI_SIMD_LOOP
+      for(size_t i = begin; i < end; ++i) {
+        lambda(static_cast<cast_t>(storage[base + i]));
+      } // for
+    }
+    else {
+      for(size_t i = begin; i < end; ++i) {
+        lambda(iterator[i]);
+      } // for
+    } // if
+  } // if
+} // execute_range
+
+template<typename ITERATOR>
+inline size_t
+range_size(ITERATOR const & iterator) {
+  if constexpr(std::is_integral_v<ITERATOR>) {
+    return iterator;
+  }
+  else {
+    return iterator.size();
+  } // if
+} // range_size
+
+template<typename ITERATOR>
+inline bool
+range_identity(ITERATOR const & iterator, size_t & base) {
+  if constexpr(std::is_integral_v<ITERATOR>) {
+    return true;
+  }
+  else {
+    return identity_range(iterator, base);
+  } // if
+} // range_identity
+
+/*!
+  Return the element at position \em i of \em iterator.
+ */
+
+template<typename ITERATOR>
+inline decltype(auto)
+range_element(ITERATOR const & iterator, size_t i) {
+  if constexpr(std::is_integral_v<ITERATOR>) {
+    return ITERATOR(i);
+  }
+  else {
+    return iterator[i];
+  } // if
+} // range_element
+
+/*!
+  Return the storage index of a target of a scatter, which is either an
+  index or an entity.
+ */
+
+template<typename E>
+inline size_t
+target_index(E const & e) {
+  if constexpr(std::is_integral_v<E>) {
+    return e;
+  }
+  else {
+    return e->id();
+  } // if
+} // target_index
+
+#if defined(FLECSI_ENABLE_TRACE)
+
+/*!
+  Register a label with the trace recorder and return its id. This takes
+  the lock of the recorder, so it is not called by every kernel launch.
+ */
+
+inline size_t
+trace_register(std::string const & label) {
+  const size_t id = std::hash<std::string>{}(label);
+  flecsi_trace_register(id, label);
+  return id;
+} // trace_register
+
+inline constexpr char for_label[] = "parallel_for";
+inline constexpr char reduce_label[] = "parallel_reduce";
+inline constexpr char scatter_label[] = "parallel_scatter";
+
+/*!
+  Return the trace id of the label of a kernel, so that the trace region
+  of the kernel can be named by a string that does not outlive the trace.
+  Kernels without a label are named by \em KERNEL, e.g., "parallel_for",
+  which is registered once. Other labels are registered the first time a
+  thread uses them, and later launches only look up their id.
+ */
+
+template<const char * KERNEL>
+size_t
+trace_label(std::string const & name) {
+  if(name.empty()) {
+    static const size_t id = trace_register(KERNEL);
+    return id;
+  } // if
+
+  thread_local std::unordered_map<std::string, size_t> ids;
+  auto it = ids.find(name);
+
+  if(it == ids.end()) {
+    it = ids.emplace(name, trace_register(name)).first;
+  } // if
+
+  return it->second;
+} // trace_label
+
+#endif
+
+} // namespace kernel_internal
+
+/*!
+  This function is the native counterpart of the Kokkos parallel_for
+  wrapper. The iterations of \em iterator, which may be an index space or
+  an integral trip count, are partitioned over the threads of the
+  range_executor. Index spaces whose ids address a contiguous block of
+  storage are executed without indirection in a vectorizable loop.
+
+  @param iterator An index space or integral trip count.
+  @param lambda   The loop body, invoked as lambda(entity).
+  @param name     The label of the loop in traces.
+  @param schedule The partitioning of the iterations over the threads.
+ */
+
+template<typename ITERATOR, typename LAMBDA>
+void
+parallel_for(ITERATOR const & iterator,
+  LAMBDA lambda,
+  std::string const & name = "",
+  range_executor::schedule_t schedule =
+    range_executor::instance().schedule()) {
+
+  flecsi_trace_task_region("kernel",
+    kernel_internal::trace_label<kernel_internal::for_label>(name));
+
+  size_t base{0};
+  const bool identity = kernel_internal::range_identity(iterator, base);
+
+  range_executor::instance().execute(kernel_internal::range_size(iterator),
+    schedule, [&](size_t begin, size_t end, size_t) {
+      kernel_internal::execute_range(
+        iterator, lambda, identity, base, begin, end);
+    });
+} // parallel_for
+
+/*!
+  Native reduction over an index space or integral trip count. Each thread
+  accumulates into a private value initialized to REDUCTION::identity, and
+  the partial results are combined with REDUCTION::fold on the calling
+  thread. REDUCTION is one of the types from flecsi/execution/reduction.h
+  or a user type with the same interface. The lambda is invoked as
+  lambda(entity, partial). The loop is labeled \em name in traces.
+ */
+
+template<typename REDUCTION, typename ITERATOR, typename LAMBDA>
+typename REDUCTION::LHS
+parallel_reduce(ITERATOR const & iterator,
+  LAMBDA lambda,
+  std::string const & name = "",
+  range_executor::schedule_t schedule =
+    range_executor::instance().schedule()) {
+
+  flecsi_trace_task_region("kernel",
+    kernel_internal::trace_label<kernel_internal::reduce_label>(name));
+
+  using value_t = typename REDUCTION::LHS;
+
+  // Pad the partial results to avoid false sharing between threads.
+  struct alignas(64) partial_t {
+    value_t value;
+  }; // struct partial_t
+
+  auto & executor = range_executor::instance();
+  std::vector<partial_t> partials(
+    executor.concurrency(), partial_t{REDUCTION::identity});
+
+  size_t base{0};
+  const bool identity = kernel_internal::range_identity(iterator, base);
+
+  executor.execute(kernel_internal::range_size(iterator), schedule,
+    [&](size_t begin, size_t end, size_t thread) {
+      value_t & partial = partials[thread].value;
+      auto reduce = [&partial, &lambda](auto && entity) {
+        lambda(std::forward<decltype(entity)>(entity), partial);
+      };
+      kernel_internal::execute_range(
+        iterator, reduce, identity, base, begin, end);
+    });
+
+  value_t result = REDUCTION::identity;
+  for(auto & p : partials) {
+    REDUCTION::fold(result, p.value);
+  } // for
+
+  return result;
+} // parallel_reduce
+
+/*!
+  The scatter_accessor_u type is passed to the body of a parallel_scatter.
+  It gives reduction-only access to the target field, e.g., a face loop
+  adds its flux to the adjacent cells with
+
+  \code
+  r(c) <<= flux;
+  \endcode
+
+  where <<= combines the value with REDUCTION, i.e., it adds for
+  reduction::sum and keeps the minimum for reduction::min. Elements may be
+  addressed by index or by entity.
+ */
+
+template<typename REDUCTION>
+class scatter_accessor_u
+{
+public:
+  using value_t = typename REDUCTION::LHS;
+
+  class reference_t
+  {
+  public:
+    explicit reference_t(value_t & target) : target_(target) {}
+
+    reference_t & operator<<=(const value_t & value) {
+      REDUCTION::apply(target_, value);
+      return *this;
+    } // operator <<=
+
+  private:
+    value_t & target_;
+
+  }; // class reference_t
+
+  scatter_accessor_u(value_t * data, size_t size) : data_(data), size_(size) {}
+
+  reference_t operator()(size_t index) const {
+    assert(index < size_ && "index out of range");
+    return reference_t(data_[index]);
+  } // operator ()
+
+  template<typename E>
+  reference_t operator()(E * e) const {
+    return this->operator()(e->id());
+  } // operator ()
+
+  size_t size() const {
+    return size_;
+  } // size
+
+private:
+  value_t * data_;
+  size_t size_;
+
+}; // class scatter_accessor_u
+
+/*!
+  The scatter_schedule_t type partitions the iterations of a scatter into
+  colors, such that no two iterations of the same color update the same
+  target, e.g., an edge coloring of the face to cell connectivity. The
+  iterations of a color can then update their targets in parallel without
+  atomics or private copies. A schedule is built once for a connectivity
+  and reused by every parallel_scatter over it.
+ */
+
+class scatter_schedule_t
+{
+public:
+  scatter_schedule_t() = default;
+
+  /*!
+    Color the iterations greedily in order, so that each color lists its
+    iterations in increasing order.
+
+    @param iterator An index space or integral trip count.
+    @param targets  A callable object that returns the targets of an
+                    iteration as a range of indices or entities, e.g.,
+                    [&](auto f) { return m.cells(f); }.
+   */
+
+  template<typename ITERATOR, typename TARGETS>
+  scatter_schedule_t(ITERATOR const & iterator, TARGETS && targets) {
+    const size_t n = kernel_internal::range_size(iterator);
+
+    std::vector<size_t> colors(n);
+    std::vector<std::vector<size_t>> target_colors;
+    std::vector<size_t> forbidden;
+
+    for(size_t i{0}; i < n; ++i) {
+      auto range = targets(kernel_internal::range_element(iterator, i));
+
+      // Colors that are already used by a target of this iteration are
+      // marked with i + 1.
+      for(auto && t : range) {
+        const size_t index = kernel_internal::target_index(t);
+
+        if(index >= target_colors.size()) {
+          target_colors.resize(index + 1);
+        } // if
+
+        for(auto c : target_colors[index]) {
+          if(c >= forbidden.size()) {
+            forbidden.resize(c + 1, 0);
+          } // if
+
+          forbidden[c] = i + 1;
+        } // for
+      } // for
+
+      size_t color{0};
+      while(color < forbidden.size() && forbidden[color] == i + 1) {
+        ++color;
+      } // while
+
+      for(auto && t : range) {
+        target_colors[kernel_internal::target_index(t)].push_back(color);
+      } // for
+
+      colors[i] = color;
+      ncolors_ = std::max(ncolors_, color + 1);
+    } // for
+
+    offsets_.assign(ncolors_ + 1, 0);
+
+    for(auto c : colors) {
+      ++offsets_[c + 1];
+    } // for
+
+    for(size_t c{0}; c < ncolors_; ++c) {
+      offsets_[c + 1] += offsets_[c];
+    } // for
+
+    iterations_.resize(n);
+    std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+
+    for(size_t i{0}; i < n; ++i) {
+      iterations_[next[colors[i]]++] = i;
+    } // for
+  } // scatter_schedule_t
+
+  size_t colors() const {
+    return ncolors_;
+  } // colors
+
+  size_t size() const {
+    return iterations_.size();
+  } // size
+
+  /*!
+    Return the positions of the iterations of color \em c.
+   */
+
+  std::pair<const size_t *, const size_t *> color(size_t c) const {
+    return {iterations_.data() + offsets_[c],
+      iterations_.data() + offsets_[c + 1]};
+  } // color
+
+private:
+  size_t ncolors_ = 0;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> iterations_;
+
+}; // class scatter_schedule_t
+
+/*!
+  Scatter-accumulate loop, in which each iteration reduces values into
+  several elements of a target field, e.g., face fluxes into the residual
+  of the adjacent cells. The lambda is invoked as lambda(entity, scatter),
+  where scatter is a scatter_accessor_u.
+
+  This version privatizes the target: each thread reduces into its own
+  copy, initialized to REDUCTION::identity, and the copies are then folded
+  into the target in thread order. Iterations are partitioned with the
+  blocked schedule, so the result does not depend on the timing of the
+  threads. The copies take one target-sized buffer per thread in the
+  scratch area of the range_executor, so that repeated scatters do not
+  allocate.
+
+  @param iterator An index space or integral trip count.
+  @param target   A dense accessor or any type with operator()(size_t) and
+                  size() over contiguous storage.
+  @param lambda   The loop body.
+  @param name     The label of the loop in traces.
+ */
+
+template<typename REDUCTION,
+  typename ITERATOR,
+  typename ACCESSOR,
+  typename LAMBDA>
+void
+parallel_scatter(ITERATOR const & iterator,
+  ACCESSOR & target,
+  LAMBDA lambda,
+  std::string const & name = "") {
+
+  flecsi_trace_task_region("kernel",
+    kernel_internal::trace_label<kernel_internal::scatter_label>(name));
+
+  using value_t = typename REDUCTION::LHS;
+  using scatter_t = scatter_accessor_u<REDUCTION>;
+
+  auto & executor = range_executor::instance();
+
+  const size_t n = kernel_internal::range_size(iterator);
+  const size_t size = target.size();
+  value_t * data = size ? &target(0) : nullptr;
+
+  // A single thread reduces into the target directly. This includes
+  // nested scatters, whose ranges execute on the calling thread.
+  if(executor.concurrency() == 1 || n < executor.serial_threshold() ||
+     executor.in_range()) {
+    scatter_t scatter(data, size);
+    for(size_t i{0}; i < n; ++i) {
+      lambda(kernel_internal::range_element(iterator, i), scatter);
+    } // for
+    return;
+  } // if
+
+  static_assert(std::is_trivially_destructible_v<value_t> &&
+                  alignof(value_t) <= alignof(std::max_align_t),
+    "privatized scatter requires a trivial value type");
+
+  // The copies live in the scratch area of the calling thread, which is
+  // reused by later scatters.
+  const size_t nthreads = executor.concurrency();
+  value_t * buffers =
+    static_cast<value_t *>(executor.scratch(nthreads * size * sizeof(value_t)));
+  std::uninitialized_fill_n(buffers, nthreads * size, REDUCTION::identity);
+
+  size_t base{0};
+  const bool identity = kernel_internal::range_identity(iterator, base);
+
+  executor.execute(n, range_executor::schedule_t::blocked,
+    [&](size_t begin, size_t end, size_t thread) {
+      scatter_t scatter(buffers + thread * size, size);
+      auto body = [&scatter, &lambda](auto && entity) {
+        lambda(std::forward<decltype(entity)>(entity), scatter);
+      };
+      kernel_internal::execute_range(
+        iterator, body, identity, base, begin, end);
+    });
+
+  executor.execute(size, range_executor::schedule_t::blocked,
+    [&](size_t begin, size_t end, size_t) {
+      for(size_t t{0}; t < nthreads; ++t) {
+        const value_t * buffer = buffers + t * size;
+        for(size_t i = begin; i < end; ++i) {
+          REDUCTION::fold(data[i], buffer[i]);
+        } // for
+      } // for
+    });
+} // parallel_scatter
+
+/*!
+  Scatter-accumulate loop that executes the colors of \em schedule in
+  order and the iterations of each color in parallel. The iterations of a
+  color update disjoint targets, so they reduce into the target directly,
+  without extra memory, and each target receives its contributions in
+  color order. The schedule must have been built for \em iterator. The
+  loop is labeled \em name in traces.
+ */
+
+template<typename REDUCTION,
+  typename ITERATOR,
+  typename ACCESSOR,
+  typename LAMBDA>
+void
+parallel_scatter(ITERATOR const & iterator,
+  scatter_schedule_t const & schedule,
+  ACCESSOR & target,
+  LAMBDA lambda,
+  std::string const & name = "") {
+
+  assert(schedule.size() == kernel_internal::range_size(iterator) &&
+         "schedule does not match iterator");
+
+  flecsi_trace_task_region("kernel",
+    kernel_internal::trace_label<kernel_internal::scatter_label>(name));
+
+  const size_t size = target.size();
+  scatter_accessor_u<REDUCTION> scatter(size ? &target(0) : nullptr, size);
+
+  auto & executor = range_executor::instance();
+
+  for(size_t c{0}; c < schedule.colors(); ++c) {
+    auto iterations = schedule.color(c);
+
+    executor.execute(iterations.second - iterations.first,
+      range_executor::schedule_t::blocked,
+      [&](size_t begin, size_t end, size_t) {
+        for(size_t i = begin; i < end; ++i) {
+          lambda(kernel_internal::range_element(
+                   iterator, iterations.first[i]),
+            scatter);
+        } // for
+      });
+  } // for
+} // parallel_scatter
+
+/*
+  The forall_t and reduce_all_t helpers only live for the duration of the
+  full expression created by the forall and reduce_all macros, so they
+  may safely reference a temporary index space, e.g., m.cells(owned).
+ */
+
+template<typename ITERATOR>
+struct forall_t {
+
+  forall_t(ITERATOR const & iterator, std::string const & name = "")
+    : iterator_(iterator), name_(name) {}
+
+  template<typename LAMBDA>
+  void operator+(LAMBDA lambda) {
+    parallel_for(iterator_, lambda, name_);
+  } // operator+
+
+private:
+  ITERATOR const & iterator_;
+  std::string name_;
+
+}; // forall_t
+
+template<typename ITERATOR, typename REDUCTION>
+struct reduce_all_t {
+
+  reduce_all_t(ITERATOR const & iterator, std::string const & name = "")
+    : iterator_(iterator), name_(name) {}
+
+  template<typename LAMBDA>
+  typename REDUCTION::LHS operator+(LAMBDA lambda) {
+    return parallel_reduce<REDUCTION>(iterator_, lambda, name_);
+  } // operator+
+
+private:
+  ITERATOR const & iterator_;
+  std::string name_;
+
+}; // reduce_all_t
+
+template<typename REDUCTION, typename ITERATOR>
+reduce_all_t<ITERATOR, REDUCTION>
+make_reduce_all(ITERATOR const & iterator, std::string const & name = "") {
+  return reduce_all_t<ITERATOR, REDUCTION>(iterator, name);
+} // make_reduce_all
+
+#define forall(it, iterator, name)                                             \
+  flecsi::forall_t{iterator, name} + [&](auto it)
+
+/*!
+  Reduction counterpart of forall. The loop body updates \em value, the
+  thread-private partial result, e.g.:
+
+  \code
+  double mass = reduce_all(c, m, cells, reduction::sum<double>, "mass") {
+    m += c->mass();
+  };
+  \endcode
+ */
+
+#define reduce_all(it, value, iterator, REDUCTION, name)                       \
+  flecsi::make_reduce_all<REDUCTION>(iterator, name) +                         \
+    [&](auto it, typename REDUCTION::LHS & value)
+
+} // namespace flecsi
+
 #endif
 
 namespace flecsi {
@@ -189,6 +189,36 @@ legion_context_policy_t::unset_call_mpi(Legion::Context & ctx,
   fm.wait_all_results(true);
 } // legion_context_policy_t::unset_call_mpi
 
+//----------------------------------------------------------------------------//
+// Implementation of legion_context_policy_t::flush_mpi_tasks.
+//----------------------------------------------------------------------------//
+
+void
+legion_context_policy_t::flush_mpi_tasks(Legion::Context & ctx,
+  Legion::Runtime * runtime) {
+  if(deferred_mpi_launches_.empty()) {
+    return;
+  } // if
+
+  {
+    clog_tag_guard(context);
+    clog(info) << "Flushing " << deferred_mpi_launches_.size()
+               << " MPI tasks" << std::endl;
+  }
+
+  // Every wrapper task must have queued its user task before control
+  // is handed to MPI.
+  for(auto & fm : deferred_mpi_launches_) {
+    fm.wait_all_results(true);
+  } // for
+
+  deferred_mpi_launches_.clear();
+
+  handoff_to_mpi(ctx, runtime);
+  wait_on_mpi(ctx, runtime);
+  unset_call_mpi(ctx, runtime);
+} // legion_context_policy_t::flush_mpi_tasks
+
 //----------------------------------------------------------------------------//
 // Implementation of legion_context_policy_t::unset_call_mpi_index.
 //----------------------------------------------------------------------------//
@@ -15,10 +15,16 @@
 
 /*! @file */
 
+#include <cstdlib>
+#include <cstring>
 #include <functional>
+#include <map>
 #include <memory>
 #include <stack>
+#include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
+#include <vector>
 
 #include <cinchlog.h>
 #include <flecsi-config.h>
@@ -37,6 +43,7 @@
 #include <mpi.h>
 
 #include <flecsi/execution/common/launch.h>
+#include <flecsi/execution/common/mpi_reduction.h>
 #include <flecsi/execution/common/processor.h>
 #include <flecsi/execution/legion/future.h>
 #include <flecsi/execution/legion/internal_field.h>
@@ -44,6 +51,7 @@
 #include <flecsi/execution/legion/runtime_state.h>
 #include <flecsi/runtime/types.h>
 #include <flecsi/utils/common.h>
+#include <flecsi/utils/mpi_type_traits.h>
 
 namespace flecsi {
 namespace execution {
@@ -189,27 +197,147 @@ struct legion_context_policy_t {
   } // toggle_mpi_state
 
   /*!
-    Set the MPI user task. When control is given to the MPI runtime
-    it will execute whichever function is currently set.
+    Per-point arguments of an MPI task launch.
    */
 
-  void set_mpi_task(std::function<void()> & mpi_task) {
+  struct mpi_launch_args_t {
+    //! The launch sequence number of the task.
+    size_t sequence;
+    //! The hash of the reduction operation, or zero if the task result
+    //! is not reduced.
+    size_t reduction;
+  }; // struct mpi_launch_args_t
+
+  /*!
+    Queue an MPI user task. When control is given to the MPI runtime
+    it will execute every queued function in launch order.
+
+    @param mpi_task The bound user task.
+    @param sequence The launch sequence number of the task. Wrapper tasks
+                    may complete out of order on a rank, so the queue is
+                    ordered by this value rather than by arrival.
+   */
+
+  void set_mpi_task(std::function<void()> & mpi_task, size_t sequence = 0) {
     {
       clog_tag_guard(context);
-      clog(info) << "set_mpi_task" << std::endl;
+      clog(info) << "set_mpi_task " << sequence << std::endl;
     }
 
-    mpi_task_ = mpi_task;
+    mpi_tasks_[sequence] = mpi_task;
   }
 
   /*!
-    Invoke the current MPI task.
+    Invoke the queued MPI tasks.
    */
 
   void invoke_mpi_task() {
-    return mpi_task_();
+    for(auto & t : mpi_tasks_) {
+      t.second();
+    } // for
+
+    mpi_tasks_.clear();
   } // invoke_mpi_task
 
+  /*!
+    Reduce the result of an MPI task over all ranks with the registered
+    reduction operation and store it for retrieval with
+    mpi_reduction_result. This must be called from the MPI runtime.
+
+    @param sequence  The launch sequence number of the task.
+    @param reduction The hash of the reduction operation.
+    @param value     The local task result.
+   */
+
+  template<typename T>
+  void reduce_mpi_result(size_t sequence, size_t reduction, T value) {
+    auto op = mpi_reduction_ops_.find(reduction);
+
+    clog_assert(op != mpi_reduction_ops_.end(),
+      "invalid MPI reduction operation");
+
+    auto [datatype, count] =
+      mpi_reduction_datatype<T>(op->second, mpi_reduction_types_);
+
+    T result;
+    MPI_Allreduce(
+      &value, &result, count, datatype, op->second, MPI_COMM_WORLD);
+
+    auto & buffer = mpi_reduction_results_[sequence];
+    buffer.resize(sizeof(T));
+    std::memcpy(buffer.data(), &result, sizeof(T));
+  } // reduce_mpi_result
+
+  /*!
+    Return and remove the reduced result of an MPI task. Every rank holds
+    the same value after the reduction, so the result is available to a
+    Legion task running in any process.
+
+    @param sequence The launch sequence number of the task.
+   */
+
+  template<typename T>
+  T mpi_reduction_result(size_t sequence) {
+    auto buffer = mpi_reduction_results_.find(sequence);
+
+    clog_assert(buffer != mpi_reduction_results_.end() &&
+                  buffer->second.size() == sizeof(T),
+      "missing MPI task reduction result");
+
+    T result;
+    std::memcpy(&result, buffer->second.data(), sizeof(T));
+    mpi_reduction_results_.erase(buffer);
+
+    return result;
+  } // mpi_reduction_result
+
+  /*!
+    Return true if consecutive MPI task launches are batched into a single
+    Legion/MPI handoff. This is enabled by setting the
+    FLECSI_BATCH_MPI_TASKS environment variable.
+   */
+
+  bool batch_mpi_tasks() const {
+    return batch_mpi_tasks_;
+  } // batch_mpi_tasks
+
+  /*!
+    Return the launch sequence number for the next MPI task.
+   */
+
+  size_t next_mpi_sequence() {
+    return mpi_sequence_++;
+  } // next_mpi_sequence
+
+  /*!
+    Record the launch of an MPI wrapper task whose handoff has been
+    deferred. The handoff happens at the next call to flush_mpi_tasks.
+   */
+
+  void defer_mpi_launch(const Legion::FutureMap & launch) {
+    deferred_mpi_launches_.push_back(launch);
+  } // defer_mpi_launch
+
+  /*!
+    Return true if there are deferred MPI tasks that have not yet been
+    executed.
+   */
+
+  bool mpi_tasks_pending() const {
+    return !deferred_mpi_launches_.empty();
+  } // mpi_tasks_pending
+
+  /*!
+    Execute all deferred MPI tasks with one handoff to the MPI runtime.
+    This must be called before launching any Legion operation that may
+    depend on data written by an MPI task.
+
+    @param ctx The Legion runtime context.
+    @param runtime The Legion task runtime pointer.
+   */
+
+  void flush_mpi_tasks(Legion::Context & ctx, Legion::Runtime * runtime);
+
   /*!
     Set the distributed-memory domain.
    */
@@ -534,6 +662,23 @@ struct legion_context_policy_t {
     return reduction_ops_;
   } // reduction_operations
 
+  /*!
+    Return the map of MPI operations for registered reductions. These are
+    used to reduce the results of MPI tasks.
+   */
+
+  std::map<size_t, MPI_Op> & mpi_reduction_operations() {
+    return mpi_reduction_ops_;
+  } // mpi_reduction_operations
+
+  /*!
+    Return the map of MPI datatypes for non-P.O.D. reduction types.
+   */
+
+  std::map<size_t, MPI_Datatype> & mpi_reduction_types() {
+    return mpi_reduction_types_;
+  } // mpi_reduction_types
+
   /*!
     Compute internal field id for from/to index space pair for connectivity.
     @param from_index_space from index space
@@ -571,6 +716,8 @@ private:
   //--------------------------------------------------------------------------//
 
   std::map<size_t, size_t> reduction_ops_;
+  std::map<size_t, MPI_Op> mpi_reduction_ops_;
+  std::map<size_t, MPI_Datatype> mpi_reduction_types_;
 
   //--------------------------------------------------------------------------//
   // Legion data members.
@@ -583,8 +730,12 @@ private:
   // MPI data members.
   //--------------------------------------------------------------------------//
 
-  std::function<void()> mpi_task_;
+  std::map<size_t, std::function<void()>> mpi_tasks_;
   bool mpi_active_ = false;
+  bool batch_mpi_tasks_ = std::getenv("FLECSI_BATCH_MPI_TASKS") != nullptr;
+  size_t mpi_sequence_ = 0;
+  std::vector<Legion::FutureMap> deferred_mpi_launches_;
+  std::map<size_t, std::vector<char>> mpi_reduction_results_;
 
   //--------------------------------------------------------------------------//
   // Legion data members within SPMD task.
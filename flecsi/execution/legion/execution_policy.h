@@ -174,6 +174,12 @@ struct legion_execution_policy_t {
     auto legion_runtime = Legion::Runtime::get_runtime();
     auto legion_context = Legion::Runtime::get_context();
 
+    // Deferred MPI tasks write region data outside of Legion's dependence
+    // analysis, so they must complete before any Legion task is launched.
+    if(processor_type != processor_type_t::mpi) {
+      context_.flush_mpi_tasks(legion_context, legion_runtime);
+    } // if
+
     constexpr size_t ZERO =
       flecsi::utils::const_string_t{EXPAND_AND_STRINGIFY(0)}.hash();
 
@@ -372,7 +378,27 @@ struct legion_execution_policy_t {
             LegionRuntime::Arrays::Point<1>(context_.colors() - 1));
           Domain launch_domain = Domain::from_rect<1>(launch_bounds);
 
+          // Every point receives the launch sequence number so that the
+          // MPI runtime executes batched tasks in launch order, and the
+          // reduction operation, if any, that is applied on the MPI side.
+          typename context_t::mpi_launch_args_t launch_args{
+            context_.next_mpi_sequence(), 0};
+
+          if constexpr(REDUCTION != ZERO) {
+            clog_assert(context_.mpi_reduction_operations().find(REDUCTION) !=
+                          context_.mpi_reduction_operations().end(),
+              "invalid MPI reduction operation");
+            launch_args.reduction = REDUCTION;
+          } // if
+
           ArgumentMap arg_map;
+          for(int p = context_.all_processes().lo.x[0];
+              p <= context_.all_processes().hi.x[0]; ++p) {
+            arg_map.set_point(
+              DomainPoint::from_point<1>(LegionRuntime::Arrays::Point<1>(p)),
+              TaskArgument(&launch_args, sizeof(launch_args)));
+          } // for
+
           IndexLauncher launcher(context_.task_id<TASK>(),
             Legion::Domain::from_rect<1>(context_.all_processes()),
             TaskArgument(&task_args, sizeof(ARG_TUPLE)), arg_map);
@@ -397,6 +423,13 @@ struct legion_execution_policy_t {
               legion_runtime, legion_context, launch_domain);
             task_prolog.sparse = false;
             task_prolog.walk(task_args);
+
+            // Ghost copies read shared data that queued MPI tasks may not
+            // have written yet.
+            if(!task_prolog.ghost_owners_partitions.empty()) {
+              context_.flush_mpi_tasks(legion_context, legion_runtime);
+            } // if
+
             task_prolog.launch_copies();
           } // scope
 
@@ -405,23 +438,28 @@ struct legion_execution_policy_t {
               legion_runtime, legion_context, launch_domain);
             task_prolog.sparse = true;
             task_prolog.walk(task_args);
+
+            if(!task_prolog.ghost_owners_partitions.empty()) {
+              context_.flush_mpi_tasks(legion_context, legion_runtime);
+            } // if
+
             task_prolog.launch_copies();
           } // scope
 
           // Launch the MPI task
           auto future =
             legion_runtime->execute_index_space(legion_context, launcher);
-          // Force synchronization
-          future.wait_all_results(true);
-
-          // Handoff to the MPI runtime.
-          context_.handoff_to_mpi(legion_context, legion_runtime);
 
-          // Wait for MPI to finish execution (synchronous).
-          context_.wait_on_mpi(legion_context, legion_runtime);
+          // Queue the task. With batching enabled, the handoff to MPI is
+          // deferred until a Legion operation depends on the result, so
+          // consecutive MPI tasks share a single handoff.
+          context_.defer_mpi_launch(future);
 
-          // Reset the calling state to false.
-          context_.unset_call_mpi(legion_context, legion_runtime);
+          // The result of a reduction is needed by the caller, so the
+          // handoff cannot be deferred.
+          if(!context_.batch_mpi_tasks() || REDUCTION != ZERO) {
+            context_.flush_mpi_tasks(legion_context, legion_runtime);
+          } // if
 
           // Execute a tuple walker that applies the task epilog operations
           // on the mapped handles
@@ -429,8 +467,12 @@ struct legion_execution_policy_t {
           task_epilog.walk(task_args);
 
           if constexpr(REDUCTION != ZERO) {
-            clog_fatal("there is no implementation for the mpi"
-                       " reduction task");
+            // The MPI runtime has already reduced the result over all
+            // ranks, so return it as a completed future.
+            return legion_future_u<RETURN, launch_type_t::single>(
+              Legion::Future::from_value(legion_runtime,
+                context_.mpi_reduction_result<RETURN>(
+                  launch_args.sequence)));
           }
           else {
             return legion_future_u<RETURN, launch_type_t::index>(future);
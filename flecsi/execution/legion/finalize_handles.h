@@ -69,6 +69,8 @@ struct finalize_handles_t
 
   template<typename T>
   void handle(sparse_mutator<T> & m) {
+    // Sort the rows changed by batched operations.
+    m.commit();
     handle(m.ragged);
   }
 
@@ -17,10 +17,14 @@
 
 #include <cinchlog.h>
 
+#include <type_traits>
+
+#include <flecsi/execution/common/mpi_reduction.h>
 #include <flecsi/execution/context.h>
 #include <flecsi/utils/common.h>
 
 #include <legion.h>
+#include <mpi.h>
 
 clog_register_tag(reduction_wrapper);
 
@@ -62,6 +66,36 @@ struct reduction_wrapper_u {
     // Save the id for invocation
     reduction_ops[HASH] = id;
 
+    // MPI does not have support for mixed-type reductions, so only
+    // operations with LHS == RHS may be used by MPI tasks.
+    if constexpr(std::is_same_v<lhs_t, rhs_t>) {
+      auto & context_ = context_t::instance();
+
+      // Built-in reductions use the predefined MPI operations.
+      if constexpr(mpi_reduction_op_u<TYPE>::native) {
+        context_.mpi_reduction_operations()[HASH] =
+          mpi_reduction_op_u<TYPE>::op();
+        return;
+      } // if
+
+      // Create the MPI data type if it isn't P.O.D.
+      if constexpr(!std::is_pod_v<lhs_t>) {
+        auto & reduction_types = context_.mpi_reduction_types();
+        size_t typehash = typeid(lhs_t).hash_code();
+
+        if(reduction_types.find(typehash) == reduction_types.end()) {
+          MPI_Datatype datatype;
+          MPI_Type_contiguous(sizeof(lhs_t), MPI_BYTE, &datatype);
+          MPI_Type_commit(&datatype);
+          reduction_types[typehash] = datatype;
+        } // if
+      } // if
+
+      MPI_Op mpiop;
+      MPI_Op_create(mpi_reduction_wrapper<TYPE>, true, &mpiop);
+      context_.mpi_reduction_operations()[HASH] = mpiop;
+    } // if
+
   } // registration_callback
 
 }; // struct reduction_wrapper_u
@@ -565,6 +565,9 @@ runtime_driver(const Legion::Task * task,
   // Finish up Legion runtime and fall back out to MPI.
   // ----------------------------------------------------------------------//
 
+  // Execute any MPI tasks that are still deferred.
+  context_.flush_mpi_tasks(ctx, runtime);
+
   context_.unset_call_mpi(ctx, runtime);
   context_.handoff_to_mpi(ctx, runtime);
 
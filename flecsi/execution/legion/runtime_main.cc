@@ -19,9 +19,13 @@
 #error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
 #endif
 
+#include <cstdlib>
+#include <iostream>
+
 #include <mpi.h>
 
 #include <flecsi/execution/context.h>
+#include <flecsi/utils/trace.h>
 
 // Boost command-line options
 #if defined(FLECSI_ENABLE_BOOST)
@@ -129,6 +133,20 @@ main(int argc, char ** argv) {
     // Execute the flecsi runtime.
     result = flecsi::execution::context_t::instance().initialize(argc, argv);
 
+    // Write the timeline of this rank, if tracing is enabled. This covers
+    // the control actions and copy launches of the top-level task.
+    flecsi_trace_write(rank);
+
+    // Report the ghost traffic of each field, if requested.
+    if(std::getenv("FLECSI_COMM_STATS") != nullptr) {
+      auto stats = flecsi::execution::reduce_comm_stats(
+        flecsi::execution::context_t::instance().comm_stats(), MPI_COMM_WORLD);
+
+      if(rank == 0) {
+        std::cout << "Ghost communication by field:" << std::endl;
+        flecsi::execution::write_comm_stats(std::cout, stats);
+      } // if
+    } // if
   } // if
 
 #if defined(FLECSI_ENABLE_MPI)
@@ -31,6 +31,7 @@
 #include <flecsi/execution/legion/internal_field.h>
 
 #include <flecsi/utils/const_string.h>
+#include <flecsi/utils/trace.h>
 #include <flecsi/utils/tuple_walker.h>
 #include <flecsi/utils/type_traits.h>
 
@@ -148,6 +149,9 @@ struct task_prolog_t : public flecsi::utils::tuple_walker_u<task_prolog_t> {
   void launch_copies() {
     auto & flecsi_context = context_t::instance();
 
+    // Legion copies are deferred, so this records the time to issue them.
+    flecsi_trace_region("ghost", "copy launch");
+
     // group by ghost_owners_partition
     std::vector<std::set<size_t>> handle_groups;
     for(size_t handle{0}; handle < ghost_owners_partitions.size(); handle++) {
@@ -201,6 +205,11 @@ struct task_prolog_t : public flecsi::utils::tuple_walker_u<task_prolog_t> {
 
         rr_owners.add_field(fids[handle]);
         rr_ghost.add_field(fids[handle]);
+
+        // The copies are deferred and sized by Legion, so only the ghost
+        // updates and their copy launches are counted.
+        flecsi_context.comm_stats(fids[handle], args[handle].index_space)
+          .record(1, 0, 0, 0, 0.0);
       }
 
       ghost_launcher.add_region_requirement(rr_owners);
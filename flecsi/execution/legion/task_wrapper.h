@@ -279,11 +279,39 @@ struct task_wrapper_u {
     init_handles_t init_handles(runtime, context, regions, task->futures);
     init_handles.walk(mpi_task_args);
 
+    // The launch sequence number orders batched MPI tasks. The launch
+    // arguments also carry the reduction operation of the task result.
+    using launch_args_t = context_t::mpi_launch_args_t;
+    launch_args_t launch_args{0, 0};
+    if(task->local_arglen == sizeof(launch_args_t)) {
+      launch_args = *reinterpret_cast<const launch_args_t *>(task->local_args);
+    } // if
+
+    const size_t sequence = launch_args.sequence;
+
     // Create bound function to pass to MPI runtime.
-    std::function<void()> bound_mpi_task = std::bind(DELEGATE, mpi_task_args);
+    std::function<void()> bound_mpi_task;
+
+    if constexpr(std::is_same_v<RETURN, void>) {
+      bound_mpi_task = std::bind(DELEGATE, mpi_task_args);
+    }
+    else {
+      if(launch_args.reduction != 0) {
+        // Reduce the task result on the MPI side, so that the Legion
+        // runtime only has to wrap the final value in a future.
+        const size_t reduction = launch_args.reduction;
+        bound_mpi_task = [mpi_task_args, sequence, reduction]() {
+          context_t::instance().reduce_mpi_result(
+            sequence, reduction, (*DELEGATE)(mpi_task_args));
+        };
+      }
+      else {
+        bound_mpi_task = std::bind(DELEGATE, mpi_task_args);
+      } // if
+    } // if
 
-    // Set the MPI function and make the runtime active.
-    context_t::instance().set_mpi_task(bound_mpi_task);
+    // Queue the MPI function and make the runtime active.
+    context_t::instance().set_mpi_task(bound_mpi_task, sequence);
     context_t::instance().set_mpi_state(true);
 
     finalize_handles_t finalize_handles;
@@ -0,0 +1,199 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <cinchlog.h>
+
+#include <flecsi/data/common/data_reference.h>
+#include <flecsi/data/common/privilege.h>
+#include <flecsi/data/data_client_handle.h>
+#include <flecsi/data/dense_accessor.h>
+#include <flecsi/data/ragged_accessor.h>
+#include <flecsi/data/ragged_mutator.h>
+#include <flecsi/data/sparse_accessor.h>
+#include <flecsi/data/sparse_mutator.h>
+#include <flecsi/execution/context.h>
+#include <flecsi/utils/tuple_walker.h>
+#include <flecsi/utils/type_traits.h>
+
+namespace flecsi {
+namespace execution {
+
+/*!
+ The bind_handles_t type can be called to walk a copy of the task args
+ before a task executes on behalf of one of the local colors of this rank.
+ It re-points the buffers of dense handles, which are initialized for the
+ first local color when the task is launched, to the storage of the color
+ returned by context_t::color(). Client handles with read-only
+ permissions are bound to the color by the task_prolog_t, which also runs
+ once per color. Other handles can not be bound to more than one color,
+ and tasks with such arguments are rejected by local_colors_check_t.
+
+ @ingroup execution
+ */
+
+struct bind_handles_t : public flecsi::utils::tuple_walker_u<bind_handles_t> {
+
+  /*!
+   Construct a bind_handles_t instance.
+   */
+
+  bind_handles_t() = default;
+
+  template<typename T,
+    size_t EXCLUSIVE_PERMISSIONS,
+    size_t SHARED_PERMISSIONS,
+    size_t GHOST_PERMISSIONS>
+  void handle(dense_accessor<T,
+    EXCLUSIVE_PERMISSIONS,
+    SHARED_PERMISSIONS,
+    GHOST_PERMISSIONS> & a) {
+    auto & h = a.handle;
+    auto & context = context_t::instance();
+
+    auto & color_info =
+      context.coloring_info(h.index_space).at(context.color());
+
+    auto buffer = context.field_data(h.fid);
+    if(buffer == nullptr) {
+      buffer = context.register_field_data(h.fid,
+        sizeof(T) * (color_info.exclusive + color_info.shared +
+                      color_info.ghost),
+        h.index_space);
+    } // if
+
+    auto data = reinterpret_cast<T *>(buffer);
+
+    h.exclusive_size = color_info.exclusive;
+    h.combined_data = h.exclusive_buf = h.exclusive_data = data;
+
+    h.shared_size = color_info.shared;
+    h.shared_data = h.shared_buf = h.exclusive_data + h.exclusive_size;
+
+    h.ghost_size = color_info.ghost;
+    h.ghost_data = h.ghost_buf = h.shared_data + h.shared_size;
+
+    h.combined_size = h.exclusive_size + h.shared_size + h.ghost_size;
+  } // handle
+
+  /*!
+    This method is called on any task arguments that are not dense handles.
+   */
+
+  template<typename T>
+  void handle(T &) {} // handle
+
+}; // struct bind_handles_t
+
+/*!
+ The local_colors_check_t type walks the task args of an index launch on
+ the calling thread before the task executes for the local colors of this
+ rank. It rejects the arguments that bind_handles_t can not bind to each
+ color: sparse and ragged accessors and mutators, which are initialized
+ for the first local color only, and client handles with write
+ permissions, whose storage is finalized once per launch.
+
+ @ingroup execution
+ */
+
+struct local_colors_check_t
+  : public flecsi::utils::tuple_walker_u<local_colors_check_t> {
+
+  template<typename T,
+    size_t EXCLUSIVE_PERMISSIONS,
+    size_t SHARED_PERMISSIONS,
+    size_t GHOST_PERMISSIONS>
+  void handle(sparse_accessor<T,
+    EXCLUSIVE_PERMISSIONS,
+    SHARED_PERMISSIONS,
+    GHOST_PERMISSIONS> &) {
+    reject("sparse accessors");
+  } // handle
+
+  template<typename T,
+    size_t EXCLUSIVE_PERMISSIONS,
+    size_t SHARED_PERMISSIONS,
+    size_t GHOST_PERMISSIONS>
+  void handle(ragged_accessor<T,
+    EXCLUSIVE_PERMISSIONS,
+    SHARED_PERMISSIONS,
+    GHOST_PERMISSIONS> &) {
+    reject("ragged accessors");
+  } // handle
+
+  template<typename T>
+  void handle(sparse_mutator<T> &) {
+    reject("sparse mutators");
+  } // handle
+
+  template<typename T>
+  void handle(ragged_mutator<T> &) {
+    reject("ragged mutators");
+  } // handle
+
+  template<typename T, size_t PERMISSIONS>
+  void handle(data_client_handle_u<T, PERMISSIONS> &) {
+    if constexpr(PERMISSIONS != ro) {
+      reject("client handles with write permissions");
+    } // if
+  } // handle
+
+  /*!
+   Handle individual list items
+   */
+
+  template<typename T,
+    std::size_t N,
+    template<typename, std::size_t>
+    typename Container,
+    typename =
+      std::enable_if_t<std::is_base_of<data::data_reference_base_t, T>::value>>
+  void handle(Container<T, N> & list) {
+    for(auto & item : list) {
+      handle(item);
+    } // for
+  } // handle
+
+  /*!
+   Handle tuple of items
+   */
+
+  template<typename... Ts, size_t... I>
+  void handle_tuple_items(std::tuple<Ts...> & items,
+    std::index_sequence<I...>) {
+    (handle(std::get<I>(items)), ...);
+  } // handle_tuple_items
+
+  template<typename... Ts,
+    typename = std::enable_if_t<
+      utils::are_base_of_t<data::data_reference_base_t, Ts...>::value>>
+  void handle(std::tuple<Ts...> & items) {
+    handle_tuple_items(items, std::make_index_sequence<sizeof...(Ts)>{});
+  } // handle
+
+  template<typename T>
+  void handle(T &) {} // handle
+
+private:
+  static void reject(const char * what) {
+    clog_fatal(what << " are not supported in index launches with "
+                       "colors_per_rank > 1");
+  } // reject
+
+}; // struct local_colors_check_t
+
+} // namespace execution
+} // namespace flecsi
@@ -15,6 +15,12 @@
 /*! @file */
 
 #include <flecsi/execution/mpi/context_policy.h>
+#include <flecsi/utils/trace.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <vector>
 
 namespace flecsi {
 namespace execution {
@@ -24,13 +30,70 @@ namespace execution {
 //----------------------------------------------------------------------------//
 
 int
-mpi_context_policy_t::initialize(int argc, char ** argv) {
+mpi_context_policy_t::initialize(int argc, char ** argv, MPI_Comm comm) {
+  //--------------------------------------------------------------------------//
+  // Set the communicator of the runtime, which the colorers also use
+  //--------------------------------------------------------------------------//
+
+  comm_ = comm;
+  utils::set_mpi_comm(comm);
+
   //--------------------------------------------------------------------------//
   // Set color state data
   //--------------------------------------------------------------------------//
 
-  MPI_Comm_rank(MPI_COMM_WORLD, &color_);
-  MPI_Comm_size(MPI_COMM_WORLD, &colors_);
+  int size;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_size(comm_, &size);
+
+  if(const char * env = std::getenv("FLECSI_COLORS_PER_RANK")) {
+    colors_per_rank_ = std::strtoul(env, nullptr, 10);
+    clog_assert(colors_per_rank_ > 0, "FLECSI_COLORS_PER_RANK must be > 0");
+  } // if
+
+  color_ = rank * colors_per_rank_;
+  colors_ = size * colors_per_rank_;
+
+  color_data_.resize(colors_per_rank_);
+  color_pool_.start(colors_per_rank_ - 1);
+
+  //--------------------------------------------------------------------------//
+  // Split the ranks by node for shared-memory ghost copies
+  //--------------------------------------------------------------------------//
+
+  if(const char * env = std::getenv("FLECSI_NODE_GHOSTS")) {
+    node_ghosts_ = std::strtoul(env, nullptr, 10) != 0;
+  } // if
+
+  if(node_ghosts_) {
+    clog_assert(colors_per_rank_ == 1,
+      "FLECSI_NODE_GHOSTS requires one color per rank");
+
+    MPI_Comm_split_type(
+      comm_, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm_);
+
+    MPI_Group comm_grp, node_grp;
+    MPI_Comm_group(comm_, &comm_grp);
+    MPI_Comm_group(node_comm_, &node_grp);
+
+    std::vector<int> ranks(size);
+    for(int r(0); r < size; ++r) {
+      ranks[r] = r;
+    } // for
+
+    node_rank_.resize(size);
+    MPI_Group_translate_ranks(
+      comm_grp, size, ranks.data(), node_grp, node_rank_.data());
+
+    for(auto & r : node_rank_) {
+      if(r == MPI_UNDEFINED) {
+        r = -1;
+      } // if
+    } // for
+
+    MPI_Group_free(&comm_grp);
+    MPI_Group_free(&node_grp);
+  } // if
 
   //--------------------------------------------------------------------------//
   // Add pre-defined MPI ops to reduction map
@@ -83,5 +146,229 @@ mpi_context_policy_t::initialize(int argc, char ** argv) {
   return 0;
 } // mpi_context_policy_t::initialize
 
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::finalize.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::finalize() {
+  // Every rank releases the fields in id order, since the windows are
+  // freed collectively.
+  std::set<field_id_t> fids;
+
+  for(auto & md : color_data().field_metadata) {
+    fids.insert(md.first);
+  } // for
+
+  for(auto & md : color_data().sparse_field_metadata) {
+    fids.insert(md.first);
+  } // for
+
+  for(auto fid : fids) {
+    release_field_metadata(fid);
+  } // for
+
+  // The shared-memory windows of the node ghosts have been freed above.
+  if(node_comm_ != MPI_COMM_NULL) {
+    MPI_Comm_free(&node_comm_);
+  } // if
+} // mpi_context_policy_t::finalize
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::exchange_dense_ghosts.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::exchange_dense_ghosts(field_id_t fid,
+  size_t index_space,
+  size_t type_size,
+  const std::unordered_map<size_t, coloring::coloring_info_t> &
+    coloring_info,
+  field_comm_stats_t & stats) {
+
+  auto field_buffer = [&](size_t color) {
+    auto & field_data = color_data(local_color(color)).field_data;
+    clog_assert(field_data.contains(fid),
+      "field " << fid << " is not registered for color " << color);
+    return field_data.data(fid);
+  };
+
+  // Buffers are keyed by (source color, destination color). Both sides
+  // traverse the entity sets in id order, so the packed and unpacked
+  // orderings agree without any additional index exchange.
+  using color_pair_t = std::pair<size_t, size_t>;
+  std::map<color_pair_t, std::vector<uint8_t>> send_buffers;
+  std::map<color_pair_t, std::vector<uint8_t>> recv_buffers;
+
+  //--------------------------------------------------------------------------//
+  // Pack shared entities that are ghosts of remote colors.
+  //--------------------------------------------------------------------------//
+
+  for(size_t local{0}; local < colors_per_rank_; ++local) {
+    const size_t color = color_ + local;
+    const auto & info = coloring_info.at(color);
+    const auto & coloring = local_coloring(index_space, color);
+    const uint8_t * shared = field_buffer(color) + info.exclusive * type_size;
+
+    size_t offset{0};
+    for(auto & entity : coloring.shared) {
+      for(auto user : entity.shared) {
+        if(!is_local_color(user)) {
+          auto & buffer = send_buffers[{color, user}];
+          buffer.insert(buffer.end(), shared + offset * type_size,
+            shared + (offset + 1) * type_size);
+        } // if
+      } // for
+      ++offset;
+    } // for
+  } // for
+
+  //--------------------------------------------------------------------------//
+  // Size the receive buffers and copy ghosts that are owned locally.
+  //--------------------------------------------------------------------------//
+
+  for(size_t local{0}; local < colors_per_rank_; ++local) {
+    const size_t color = color_ + local;
+    const auto & info = coloring_info.at(color);
+    const auto & coloring = local_coloring(index_space, color);
+    uint8_t * ghost =
+      field_buffer(color) + (info.exclusive + info.shared) * type_size;
+
+    for(auto & entity : coloring.ghost) {
+      if(is_local_color(entity.rank)) {
+        const auto & owner_info = coloring_info.at(entity.rank);
+        const uint8_t * owner_shared =
+          field_buffer(entity.rank) + owner_info.exclusive * type_size;
+        std::memcpy(
+          ghost, owner_shared + entity.offset * type_size, type_size);
+      }
+      else {
+        recv_buffers[{entity.rank, color}].resize(
+          recv_buffers[{entity.rank, color}].size() + type_size);
+      } // if
+
+      ghost += type_size;
+    } // for
+  } // for
+
+  //--------------------------------------------------------------------------//
+  // Exchange remote ghosts.
+  //--------------------------------------------------------------------------//
+
+  flecsi_trace_region("ghost", "dense");
+
+  std::vector<MPI_Request> requests;
+  requests.reserve(send_buffers.size() + recv_buffers.size());
+
+  size_t bytes_sent{0}, bytes_received{0};
+  std::set<int> neighbors;
+
+  auto tag = [this](size_t src, size_t dst) {
+    return int((src % colors_per_rank_) * colors_per_rank_ +
+               dst % colors_per_rank_);
+  };
+
+  for(auto & r : recv_buffers) {
+    const size_t src = r.first.first;
+    const size_t dst = r.first.second;
+    requests.emplace_back();
+    MPI_Irecv(r.second.data(), r.second.size(), MPI_BYTE, color_rank(src),
+      tag(src, dst), comm_, &requests.back());
+    bytes_received += r.second.size();
+    neighbors.insert(color_rank(src));
+  } // for
+
+  for(auto & s : send_buffers) {
+    const size_t src = s.first.first;
+    const size_t dst = s.first.second;
+    requests.emplace_back();
+    MPI_Isend(s.second.data(), s.second.size(), MPI_BYTE, color_rank(dst),
+      tag(src, dst), comm_, &requests.back());
+    bytes_sent += s.second.size();
+    neighbors.insert(color_rank(dst));
+  } // for
+
+  flecsi_trace_bytes(bytes_received);
+
+  const double start = MPI_Wtime();
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  stats.record(requests.size(), bytes_sent, bytes_received, neighbors.size(),
+    MPI_Wtime() - start);
+
+  //--------------------------------------------------------------------------//
+  // Unpack remote ghosts.
+  //--------------------------------------------------------------------------//
+
+  for(size_t local{0}; local < colors_per_rank_; ++local) {
+    const size_t color = color_ + local;
+    const auto & info = coloring_info.at(color);
+    const auto & coloring = local_coloring(index_space, color);
+    uint8_t * ghost =
+      field_buffer(color) + (info.exclusive + info.shared) * type_size;
+
+    std::map<size_t, size_t> positions;
+
+    for(auto & entity : coloring.ghost) {
+      if(!is_local_color(entity.rank)) {
+        size_t & position = positions[entity.rank];
+        const auto & buffer = recv_buffers[{entity.rank, color}];
+        std::memcpy(ghost, buffer.data() + position, type_size);
+        position += type_size;
+      } // if
+
+      ghost += type_size;
+    } // for
+  } // for
+} // mpi_context_policy_t::exchange_dense_ghosts
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::release_field_metadata.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::release_field_metadata(field_id_t fid) {
+
+  auto free_group = [](MPI_Group & group) {
+    if(group != MPI_GROUP_NULL && group != MPI_GROUP_EMPTY) {
+      MPI_Group_free(&group);
+    } // if
+  };
+
+  auto free_types = [](std::map<int, MPI_Datatype> & types) {
+    for(auto & t : types) {
+      MPI_Type_free(&t.second);
+    } // for
+  };
+
+  auto & field_metadata = color_data().field_metadata;
+  auto dense = field_metadata.find(fid);
+
+  if(dense != field_metadata.end()) {
+    auto & md = dense->second;
+    free_types(md.origin_types);
+    free_types(md.target_types);
+    free_group(md.shared_users_grp);
+    free_group(md.ghost_owners_grp);
+    MPI_Win_free(&md.win);
+    md.node.release();
+    field_metadata.erase(dense);
+  } // if
+
+  // Sparse fields only keep the groups and datatypes. Their windows are
+  // created for each ghost update.
+  auto & sparse_field_metadata = color_data().sparse_field_metadata;
+  auto sparse = sparse_field_metadata.find(fid);
+
+  if(sparse != sparse_field_metadata.end()) {
+    auto & md = sparse->second;
+    free_types(md.origin_types);
+    free_types(md.target_types);
+    free_group(md.shared_users_grp);
+    free_group(md.ghost_owners_grp);
+    sparse_field_metadata.erase(sparse);
+  } // if
+} // mpi_context_policy_t::release_field_metadata
+
 } // namespace execution
 } // namespace flecsi
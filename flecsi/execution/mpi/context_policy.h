@@ -15,11 +15,18 @@
 
 /*! @file */
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <istream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <stdint.h>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <cinchlog.h>
@@ -34,15 +41,21 @@
 #include <flecsi/coloring/coloring_types.h>
 #include <flecsi/coloring/index_coloring.h>
 #include <flecsi/coloring/mpi_utils.h>
+#include <flecsi/concurrency/thread_pool.h>
 #include <flecsi/data/common/data_types.h>
+#include <flecsi/data/common/field_allocator.h>
 #include <flecsi/data/common/row_vector.h>
 #include <flecsi/data/common/serdez.h>
+#include <flecsi/data/common/sparse_transpose.h>
+#include <flecsi/execution/common/comm_stats.h>
 #include <flecsi/execution/common/launch.h>
 #include <flecsi/execution/common/processor.h>
 #include <flecsi/execution/mpi/future.h>
+#include <flecsi/execution/mpi/node_exchange.h>
 #include <flecsi/execution/mpi/runtime_driver.h>
 #include <flecsi/runtime/types.h>
 #include <flecsi/utils/common.h>
+#include <flecsi/utils/mpi_comm.h>
 #include <flecsi/utils/mpi_type_traits.h>
 
 #include <flecsi/utils/const_string.h>
@@ -106,6 +119,7 @@ struct mpi_context_policy_t {
         serdez->deserialize(row_ptr, is);
         row_ptr += sizeof(data::row_vector_u<uint8_t>);
       }
+      transpose->invalidate();
       return is;
     }
 
@@ -120,6 +134,15 @@ struct mpi_context_policy_t {
     size_t max_entries_per_index;
 
     std::vector<uint8_t> rows;
+
+    // The buffer of the rows of a padded sparse field, which holds the
+    // same number of elements for each index.
+    std::vector<uint8_t> padding;
+
+    // The entry-major view of the field, which is rebuilt by the first
+    // accessor that uses it after the field was mutated.
+    std::shared_ptr<data::sparse_transpose_t> transpose =
+      std::make_shared<data::sparse_transpose_t>();
   }; // sparse_field_data_t
 
   /*!
@@ -128,19 +151,44 @@ struct mpi_context_policy_t {
 
     @param argc The command-line argument count passed from main.
     @param argv The command-line argument values passed from main.
+    @param comm The communicator of the ranks on which the runtime
+                runs. Other ranks may run other codes, or other FleCSI
+                instances on disjoint communicators.
 
     @return An integer value with a non-zero error code upon failure,
             zero otherwise.
    */
 
-  int initialize(int argc, char ** argv);
+  int initialize(int argc, char ** argv, MPI_Comm comm = MPI_COMM_WORLD);
+
+  /*!
+    Release the MPI resources of the runtime, i.e., the windows, groups, and
+    datatypes of the ghost copies and the node communicator. This is
+    collective, and must be called after initialize has returned and before
+    MPI is finalized.
+   */
+
+  void finalize();
+
+  /*!
+    Return the communicator on which the runtime runs. Ranks and colors
+    are relative to it.
+   */
+
+  MPI_Comm comm() const {
+    return comm_;
+  } // comm
 
   /*!
-    Return the color for which the context was initialized.
+    Return the color of the calling thread. When a task is executing on
+    behalf of one of the local colors of this rank, this is that color.
+    Otherwise, it is the first color owned by this rank, which is the
+    same as the MPI rank when there is a single color per rank.
    */
 
   size_t color() const {
-    return color_;
+    const int current = current_color_();
+    return current < 0 ? color_ : current;
   } // color
 
   /*!
@@ -151,6 +199,179 @@ struct mpi_context_policy_t {
     return colors_;
   } // color
 
+  //--------------------------------------------------------------------------//
+  // Overdecomposition interface.
+  //
+  // The MPI runtime may own more than one color per rank. The number of
+  // colors per rank is set with the FLECSI_COLORS_PER_RANK environment
+  // variable, and colors are assigned to ranks in contiguous blocks, i.e.,
+  // rank r owns colors [r*K, (r+1)*K). Index launches execute once for each
+  // local color, each on its own thread. Ghost copies between colors on the
+  // same rank are performed as direct memory copies.
+  //--------------------------------------------------------------------------//
+
+  /*!
+    Return the number of colors owned by each rank.
+   */
+
+  size_t colors_per_rank() const {
+    return colors_per_rank_;
+  } // colors_per_rank
+
+  /*!
+    Return the rank that owns the given color.
+   */
+
+  int color_rank(size_t color) const {
+    return color / colors_per_rank_;
+  } // color_rank
+
+  /*!
+    Return the index of a color owned by this rank in [0, colors_per_rank()).
+   */
+
+  size_t local_color(size_t color) const {
+    return color - color_;
+  } // local_color
+
+  /*!
+    Return true if the given color is owned by this rank.
+   */
+
+  bool is_local_color(size_t color) const {
+    return color_rank(color) == rank;
+  } // is_local_color
+
+  /*!
+    Execute \em f(local) for each local color. Each invocation runs on its
+    own thread with color() returning the corresponding color. The calling
+    thread executes the first local color and waits for the others to
+    complete. MPI must not be called from within \em f.
+   */
+
+  template<typename FUNCTION>
+  void for_each_local_color(FUNCTION && f) {
+
+    if(colors_per_rank_ == 1) {
+      f(size_t{0});
+      return;
+    } // if
+
+    std::atomic<size_t> pending(colors_per_rank_ - 1);
+    std::mutex mutex;
+    std::condition_variable done;
+
+    auto run = [&](size_t local) {
+      current_color_() = color_ + local;
+      f(local);
+      current_color_() = -1;
+    };
+
+    for(size_t local{1}; local < colors_per_rank_; ++local) {
+      color_pool_.queue([&, local]() {
+        run(local);
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--pending == 0) {
+          done.notify_one();
+        } // if
+      });
+    } // for
+
+    run(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]() { return pending == 0; });
+  } // for_each_local_color
+
+  /*!
+    Add the index coloring of one of the local colors of this rank. This is
+    required for every local color when colors_per_rank() > 1. In this
+    case, the rank member of the ghost entity information and the shared
+    member of the shared entity information refer to colors, not ranks,
+    and the offset of a ghost entity is its position in the shared region
+    of its owner.
+
+    @param index_space The index space of the coloring.
+    @param color       A color owned by this rank.
+    @param coloring    The index coloring of \em color.
+   */
+
+  void add_local_coloring(size_t index_space,
+    size_t color,
+    const coloring::index_coloring_t & coloring) {
+    clog_assert(is_local_color(color), "color " << color << " is not local");
+    local_colorings_[index_space][color] = coloring;
+  } // add_local_coloring
+
+  /*!
+    Return the index coloring of a local color.
+   */
+
+  const coloring::index_coloring_t & local_coloring(size_t index_space,
+    size_t color) const {
+    auto it = local_colorings_.find(index_space);
+    clog_assert(it != local_colorings_.end(),
+      "no local colorings for index space " << index_space);
+    return it->second.at(color);
+  } // local_coloring
+
+  /*!
+    Update the ghost region of a dense field for every local color. Ghosts
+    owned by another local color are copied directly from the owner's
+    buffer, while ghosts owned by remote colors are exchanged with one
+    message per pair of colors. This must be called from the main thread
+    after all local colors have finished executing.
+
+    @param fid           The field id.
+    @param index_space   The index space of the field.
+    @param type_size     The size in bytes of one field entry.
+    @param coloring_info The coloring information of \em index_space.
+    @param stats         The counters to which the exchange is added.
+   */
+
+  void exchange_dense_ghosts(field_id_t fid,
+    size_t index_space,
+    size_t type_size,
+    const std::unordered_map<size_t, coloring::coloring_info_t> &
+      coloring_info,
+    field_comm_stats_t & stats);
+
+  //--------------------------------------------------------------------------//
+  // Node interface.
+  //
+  // When the FLECSI_NODE_GHOSTS environment variable is set to a nonzero
+  // value, the ranks are split by node, and the ghosts of dense fields that
+  // are owned by ranks on the same node are copied through an MPI
+  // shared-memory window. Only the ghosts owned by ranks on other nodes go
+  // through the RMA window of the field. This requires one color per rank.
+  //--------------------------------------------------------------------------//
+
+  /*!
+    Return true if node ghosts are enabled.
+   */
+
+  bool node_ghosts() const {
+    return node_ghosts_;
+  } // node_ghosts
+
+  /*!
+    Return the communicator of the ranks on the node of this rank, or
+    MPI_COMM_NULL if node ghosts are disabled.
+   */
+
+  MPI_Comm node_comm() const {
+    return node_comm_;
+  } // node_comm
+
+  /*!
+    Return the rank of \em rank in the node communicator, or -1 if it is
+    not on the node of this rank or node ghosts are disabled.
+   */
+
+  int node_rank(size_t rank) const {
+    return node_ghosts_ ? node_rank_[rank] : -1;
+  } // node_rank
+
   //--------------------------------------------------------------------------//
   // Task interface.
   //--------------------------------------------------------------------------//
@@ -239,6 +460,11 @@ struct mpi_context_policy_t {
     std::map<int, MPI_Datatype> target_types;
 
     MPI_Win win;
+
+    // The copies of the ghosts owned by ranks on the same node, if node
+    // ghosts are enabled. The datatypes and groups above then only cover
+    // the other ranks.
+    node_exchange_t node;
   };
 
   /*!
@@ -280,9 +506,31 @@ struct mpi_context_policy_t {
 
     register_field_metadata_<T>(metadata, fid, coloring_info, index_coloring,
       compact_origin_lengs, compact_origin_disps, compact_target_lengs,
-      compact_target_disps);
+      compact_target_disps, node_ghosts_);
+
+    // Ghosts owned by ranks on the node are copied from the owners'
+    // segments of a shared-memory window instead of the RMA window.
+    if(node_ghosts_) {
+      metadata.node.create(node_comm_, coloring_info.shared * sizeof(T));
+
+      size_t ghost = 0;
+      for(const auto & g : index_coloring.ghost) {
+        const int owner = node_rank(g.rank);
+
+        if(owner >= 0) {
+          metadata.node.add(
+            ghost * sizeof(T), owner, g.offset * sizeof(T), sizeof(T));
+        } // if
+
+        ++ghost;
+      } // for
+    } // if
 
     for(auto ghost_owner : coloring_info.ghost_owners) {
+      if(node_rank(ghost_owner) >= 0) {
+        continue;
+      } // if
+
       MPI_Datatype origin_type;
       MPI_Datatype target_type;
 
@@ -301,12 +549,12 @@ struct mpi_context_policy_t {
       metadata.target_types.insert({ghost_owner, target_type});
     }
 
-    auto data = field_data[fid].data();
+    auto data = color_data().field_data.data(fid);
     auto shared_data = data + coloring_info.exclusive * sizeof(T);
     MPI_Win_create(shared_data, coloring_info.shared * sizeof(T), sizeof(T),
-      MPI_INFO_NULL, MPI_COMM_WORLD, &metadata.win);
+      MPI_INFO_NULL, comm_, &metadata.win);
 
-    field_metadata.insert({fid, metadata});
+    color_data().field_metadata.insert({fid, metadata});
   }
 
   /*!
@@ -324,7 +572,7 @@ struct mpi_context_policy_t {
       metadata.compact_origin_lengs, metadata.compact_origin_disps,
       metadata.compact_target_lengs, metadata.compact_target_disps);
 
-    sparse_field_metadata.insert({fid, metadata});
+    color_data().sparse_field_metadata.insert({fid, metadata});
   }
 
   /*!
@@ -339,7 +587,8 @@ struct mpi_context_policy_t {
     std::map<int, std::vector<int>> & compact_origin_lengs,
     std::map<int, std::vector<int>> & compact_origin_disps,
     std::map<int, std::vector<int>> & compact_target_lengs,
-    std::map<int, std::vector<int>> & compact_target_disps) {
+    std::map<int, std::vector<int>> & compact_target_disps,
+    bool skip_node = false) {
     // The group for MPI_Win_post are the "origin" processes, i.e.
     // the peer processes calling MPI_Get to get our shared cells. Thus
     // granting access of local window to these processes. This is the set
@@ -347,15 +596,27 @@ struct mpi_context_policy_t {
     // On the other hand, the group for MPI_Win_start are the 'target'
     // processes, i.e. the peer processes this rank is going to get ghost
     // cells from. This is the set coloring_info_t::ghost_owners.
-    // Since both shared_users and ghost_owners are std::set, we have copy
-    // them to std::vector be passed to MPI.
+    // Both shared_users and ghost_owners hold size_t, so we have to copy
+    // them to std::vector<int> to be passed to MPI.
     std::vector<int> shared_users(
       coloring_info.shared_users.begin(), coloring_info.shared_users.end());
     std::vector<int> ghost_owners(
       coloring_info.ghost_owners.begin(), coloring_info.ghost_owners.end());
 
+    // The ranks on the node are left out of the groups when their ghosts
+    // are copied through shared memory.
+    if(skip_node) {
+      auto on_node = [this](int r) { return node_rank(r) >= 0; };
+      shared_users.erase(
+        std::remove_if(shared_users.begin(), shared_users.end(), on_node),
+        shared_users.end());
+      ghost_owners.erase(
+        std::remove_if(ghost_owners.begin(), ghost_owners.end(), on_node),
+        ghost_owners.end());
+    } // if
+
     MPI_Group comm_grp;
-    MPI_Comm_group(MPI_COMM_WORLD, &comm_grp);
+    MPI_Comm_group(comm_, &comm_grp);
 
     MPI_Group_incl(comm_grp, shared_users.size(), shared_users.data(),
       &metadata.shared_users_grp);
@@ -383,7 +644,7 @@ struct mpi_context_policy_t {
     }
 
     int my_color;
-    MPI_Comm_rank(MPI_COMM_WORLD, &my_color);
+    MPI_Comm_rank(comm_, &my_color);
 
 // This should only be uncommented for debugging (outputs info
 // during tutorial runs). Consider changing this to use clog
@@ -499,26 +760,156 @@ struct mpi_context_policy_t {
   } // register_field_metadata_
 
   std::map<field_id_t, field_metadata_t> & registered_field_metadata() {
-    return field_metadata;
+    return color_data().field_metadata;
   };
 
+  /*!
+   Release the MPI window, groups, and datatypes of the ghost copies of a
+   dense or sparse field, e.g., after the coloring of its index space has
+   changed. The metadata is registered again, with the current coloring,
+   when the next handle to the field is created. This is collective if the
+   field has a window.
+
+   @param fid The field id.
+   */
+
+  void release_field_metadata(field_id_t fid);
+
+  /*!
+   Return the coloring epoch. This is incremented whenever the coloring of
+   an index space changes during a run, and is used to invalidate cached
+   communication plans.
+   */
+
+  size_t coloring_epoch() const {
+    return coloring_epoch_;
+  } // coloring_epoch
+
+  void advance_coloring_epoch() {
+    ++coloring_epoch_;
+  } // advance_coloring_epoch
+
+  //--------------------------------------------------------------------------//
+  // Topology view interface.
+  //--------------------------------------------------------------------------//
+
+  /*!
+   The key of a topology view: the type, name and namespace hashes of the
+   data client, and the color.
+   */
+
+  using topology_view_key_t = std::tuple<size_t, size_t, size_t, size_t>;
+
+  /*!
+   Return the cached read-only topology storage of a data client, or
+   nullptr if there is none or the coloring has changed since it was
+   built. Views are built by the task prolog for read-only mesh handles and
+   are reused by later launches until they are invalidated.
+
+   @tparam STORAGE The storage type of the data client.
+   */
+
+  template<typename STORAGE>
+  STORAGE * topology_view(const topology_view_key_t & key) {
+    std::lock_guard<std::mutex> lock(topology_views_mutex_);
+    auto it = topology_views_.find(key);
+
+    if(it == topology_views_.end() || it->second.epoch != coloring_epoch_) {
+      return nullptr;
+    } // if
+
+    return static_cast<STORAGE *>(it->second.storage.get());
+  } // topology_view
+
+  /*!
+   Cache the read-only topology storage of a data client, replacing any
+   previous view, and return it.
+   */
+
+  template<typename STORAGE>
+  STORAGE * add_topology_view(const topology_view_key_t & key,
+    std::unique_ptr<STORAGE> storage) {
+    std::lock_guard<std::mutex> lock(topology_views_mutex_);
+    auto & view = topology_views_[key];
+    view.storage = std::move(storage);
+    view.epoch = coloring_epoch_;
+    return static_cast<STORAGE *>(view.storage.get());
+  } // add_topology_view
+
+  /*!
+   Release the topology views of a data client for every color. This is
+   called after a task with write permissions on the client.
+   */
+
+  void invalidate_topology_views(size_t type_hash,
+    size_t name_hash,
+    size_t namespace_hash) {
+    std::lock_guard<std::mutex> lock(topology_views_mutex_);
+    topology_views_.erase(
+      topology_views_.lower_bound({type_hash, name_hash, namespace_hash, 0}),
+      topology_views_.upper_bound(
+        {type_hash, name_hash, namespace_hash, size_t(-1)}));
+  } // invalidate_topology_views
+
+  /*!
+   Release the topology views of every data client.
+   */
+
+  void invalidate_topology_views() {
+    std::lock_guard<std::mutex> lock(topology_views_mutex_);
+    topology_views_.clear();
+  } // invalidate_topology_views
+
   /*!
    Register new field data, i.e. allocate a new buffer for the specified field
-   ID.
+   ID. If the field is already registered, its buffer is resized. Buffers
+   are aligned to data::field_allocator_t::FIELD_ALIGNMENT bytes.
+
+   @param fid         The field id.
+   @param size        The size of the buffer in bytes.
+   @param index_space The index space of the field. The fields of one index
+                      space are allocated from the same memory pool.
+
+   @return A pointer to the field buffer.
    */
-  void register_field_data(field_id_t fid, size_t size) {
+  uint8_t * register_field_data(field_id_t fid,
+    size_t size,
+    size_t index_space = data::field_allocator_t::DEFAULT_POOL) {
+    // Resizing a field may move it, so the topology views that may refer
+    // to it are rebuilt.
+    if(color_data().field_data.contains(fid)) {
+      invalidate_topology_views();
+    } // if
+
     // TODO: VERSIONS
-    auto it = field_data.find(fid);
-    if(it == field_data.end()) {
-      field_data.insert({fid, std::vector<uint8_t>(size)});
-    }
-    else {
-      it->second.resize(size);
-    }
+    return color_data().field_data.allocate(fid, size, index_space);
+  }
+
+  /*!
+   Reserve the storage of a field of a local color before it is
+   registered. The first slab of each index space holds exactly the fields
+   that have been reserved for it.
+
+   @param local       The local color.
+   @param size        The size of the field in bytes.
+   @param index_space The index space of the field.
+   */
+  void reserve_field_data(size_t local,
+    size_t size,
+    size_t index_space = data::field_allocator_t::DEFAULT_POOL) {
+    color_data(local).field_data.reserve(size, index_space);
+  } // reserve_field_data
+
+  /*!
+   Return the buffer of a registered field, or nullptr if the field has not
+   been registered.
+   */
+  uint8_t * field_data(field_id_t fid) {
+    return color_data().field_data.data(fid);
   }
 
-  std::map<field_id_t, std::vector<uint8_t>> & registered_field_data() {
-    return field_data;
+  data::field_allocator_t & registered_field_data() {
+    return color_data().field_data;
   }
 
   /*!
@@ -535,6 +926,7 @@ struct mpi_context_policy_t {
     // TODO: VERSIONS
     sparse_field_data_t new_field(type_size, coloring_info.exclusive,
       coloring_info.shared, coloring_info.ghost, max_entries_per_index);
+    auto & sparse_field_data = color_data().sparse_field_data;
     auto it = sparse_field_data.find(fid);
     if(it == sparse_field_data.end()) {
       sparse_field_data.emplace(fid, std::move(new_field));
@@ -545,12 +937,12 @@ struct mpi_context_policy_t {
   }
 
   std::map<field_id_t, sparse_field_data_t> & registered_sparse_field_data() {
-    return sparse_field_data;
+    return color_data().sparse_field_data;
   }
 
   std::map<field_id_t, sparse_field_metadata_t> &
   registered_sparse_field_metadata() {
-    return sparse_field_metadata;
+    return color_data().sparse_field_metadata;
   };
 
   std::map<size_t, MPI_Datatype> & reduction_types() {
@@ -561,11 +953,44 @@ struct mpi_context_policy_t {
     return reduction_ops_;
   } // reduction_types
 
-  int rank;
+  int rank = 0;
 
   // private:
+
+  /*!
+    Field storage of one color. There is one instance per local color.
+   */
+
+  struct color_data_t {
+    data::field_allocator_t field_data;
+    std::map<field_id_t, field_metadata_t> field_metadata;
+    std::map<field_id_t, sparse_field_data_t> sparse_field_data;
+    std::map<field_id_t, sparse_field_metadata_t> sparse_field_metadata;
+  }; // struct color_data_t
+
+  color_data_t & color_data() {
+    return color_data_[local_color(color())];
+  } // color_data
+
+  color_data_t & color_data(size_t local) {
+    return color_data_[local];
+  } // color_data
+
+  static int & current_color_() {
+    thread_local int current = -1;
+    return current;
+  } // current_color_
+
+  MPI_Comm comm_ = MPI_COMM_WORLD;
+
+  // First local color
   int color_ = 0;
   int colors_ = 0;
+  size_t colors_per_rank_ = 1;
+
+  bool node_ghosts_ = false;
+  MPI_Comm node_comm_ = MPI_COMM_NULL;
+  std::vector<int> node_rank_;
 
   // Define the map type using the task_hash_t hash function.
   //  std::unordered_map<
@@ -581,18 +1006,28 @@ struct mpi_context_policy_t {
   //    task_info_t
   //  > task_registry_;
 
-  std::map<field_id_t, std::vector<uint8_t>> field_data;
-  std::map<field_id_t, field_metadata_t> field_metadata;
+  std::vector<color_data_t> color_data_ = std::vector<color_data_t>(1);
+  thread_pool color_pool_;
+
+  // key: index space, value: map of local color to coloring
+  std::map<size_t, std::map<size_t, index_coloring_t>> local_colorings_;
 
   std::map<size_t, index_space_data_t> index_space_data_map_;
   std::map<size_t, index_subspace_data_t> index_subspace_data_map_;
 
-  std::map<field_id_t, sparse_field_data_t> sparse_field_data;
-  std::map<field_id_t, sparse_field_metadata_t> sparse_field_metadata;
-
   std::map<size_t, MPI_Datatype> reduction_types_;
   std::map<size_t, MPI_Op> reduction_ops_;
 
+  size_t coloring_epoch_ = 0;
+
+  struct topology_view_t {
+    std::shared_ptr<void> storage;
+    size_t epoch = 0;
+  }; // struct topology_view_t
+
+  std::map<topology_view_key_t, topology_view_t> topology_views_;
+  std::mutex topology_views_mutex_;
+
 }; // class mpi_context_policy_t
 
 } // namespace execution
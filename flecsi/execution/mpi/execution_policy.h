@@ -20,15 +20,19 @@
 #include <future>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <flecsi/execution/common/processor.h>
 #include <flecsi/execution/context.h>
+#include <flecsi/execution/mpi/bind_handles.h>
 #include <flecsi/execution/mpi/finalize_handles.h>
 #include <flecsi/execution/mpi/future.h>
+#include <flecsi/execution/mpi/launch_plan.h>
 #include <flecsi/execution/mpi/reduction_wrapper.h>
 #include <flecsi/execution/mpi/task_epilog.h>
+#include <flecsi/execution/mpi/task_finish.h>
 #include <flecsi/execution/mpi/task_prolog.h>
-
+#include <flecsi/utils/trace.h>
 
 #if defined(ENABLE_CALIPER)
 #include<caliper/Annotation.h>
@@ -45,9 +49,13 @@ template<typename RETURN, typename ARG_TUPLE>
 struct executor_u {
   /*!
    FIXME documentation
+
+   @param task The hash of the task, which names the task in the trace.
    */
   template<typename T, typename A>
-  static decltype(auto) execute(T function, A && targs) {
+  static decltype(auto) execute(T function, A && targs, size_t task = 0) {
+
+    flecsi_trace_task_region("task", task);
 
 #if defined(ENABLE_CALIPER)
     cali::Annotation ep("FleCSI-Execution");
@@ -74,9 +82,13 @@ template<typename ARG_TUPLE>
 struct executor_u<void, ARG_TUPLE> {
   /*!
    FIXME documentation
+
+   @param task The hash of the task, which names the task in the trace.
    */
   template<typename T, typename A>
-  static decltype(auto) execute(T function, A && targs) {
+  static decltype(auto) execute(T function, A && targs, size_t task = 0) {
+
+    flecsi_trace_task_region("task", task);
 
 #if defined(ENABLE_CALIPER)
     cali::Annotation ep("FleCSI-Execution");
@@ -148,6 +160,7 @@ struct mpi_execution_policy_t {
     RETURN (*DELEGATE)(ARG_TUPLE)>
   static bool
   register_task(processor_type_t processor, launch_t launch, std::string name) {
+    flecsi_trace_register(TASK, name);
     return context_t::instance()
       .template register_function<TASK, RETURN, ARG_TUPLE, DELEGATE>();
   } // register_task
@@ -172,58 +185,161 @@ struct mpi_execution_policy_t {
     // Make a tuple from the task arguments.
     ARG_TUPLE task_args = std::make_tuple(std::forward<ARGS>(args)...);
 
-    // run task_prolog to copy ghost cells.
-    task_prolog_t task_prolog;
-    task_prolog.walk(task_args);
+    // Index launches execute once for each local color.
+    if(launch == launch_type_t::index && context_.colors_per_rank() > 1) {
+      return execute_local_colors<TASK, REDUCTION, RETURN>(
+        function, task_args);
+    } // if
 
-    auto future = executor_u<RETURN, ARG_TUPLE>::execute(function, task_args);
+    // The launch phases that the task arguments require are known at
+    // compile time, so that tasks without handles skip the walks entirely.
+    using traits_t = handle_traits_u<ARG_TUPLE>;
 
-    task_epilog_t task_epilog;
-    task_epilog.walk(task_args);
+    if constexpr(traits_t::prolog) {
+      task_prolog_t task_prolog;
+      task_prolog.walk(task_args);
+    } // if
 
-    finalize_handles_t finalize_handles;
-    finalize_handles.walk(task_args);
+    auto future =
+      executor_u<RETURN, ARG_TUPLE>::execute(function, task_args, TASK);
+
+    // Run the epilog, which copies ghost cells, and the finalization of the
+    // handles in a single pass. The communication plan is built on the
+    // first launch of the task and reused afterwards.
+    if constexpr(traits_t::epilog || traits_t::finalize) {
+      static launch_plan_t plan;
+
+      task_finish_t task_finish(&plan);
+      task_finish.walk(task_args);
+    } // if
 
     constexpr size_t ZERO =
       flecsi::utils::const_string_t{EXPAND_AND_STRINGIFY(0)}.hash();
 
     if constexpr(REDUCTION != ZERO) {
 
-      MPI_Datatype datatype;
+      flecsi_trace_region("reduction", "allreduce");
+      flecsi_trace_bytes(sizeof(RETURN));
 
-      if constexpr(!std::is_pod_v<RETURN>) {
+      MPI_Op op = reduction_operation(REDUCTION);
+      auto [datatype, count] = reduction_datatype<RETURN>(op);
 
-        size_t typehash = typeid(RETURN).hash_code();
-        auto reduction_type = context_.reduction_types().find(typehash);
+      const RETURN sendbuf = future.get();
+      RETURN recvbuf;
+
+      MPI_Allreduce(&sendbuf, &recvbuf, count, datatype, op, context_.comm());
 
-        clog_assert(reduction_type != context_.reduction_types().end(),
-          "invalid reduction operation");
+      mpi_future_u<RETURN> gfuture;
+      gfuture.set(recvbuf);
+      return gfuture;
+    }
+    else {
+      return future;
+    } // if
+  } // execute_task
 
-        datatype = reduction_type->second;
-      }
-      else {
-        datatype = flecsi::utils::mpi_typetraits_u<RETURN>::type();
-      } // if
+  /*!
+    Execute an index launch once for each local color of this rank. Each
+    color executes on its own thread with a copy of the task arguments
+    whose dense handles are bound to the storage of that color. The task
+    epilog, which performs the ghost exchange for all local colors, and the
+    reduction of the task results run on the calling thread. Tasks with
+    sparse or ragged handles, or client handles with write permissions,
+    are rejected.
+   */
 
-      auto reduction_op = context_.reduction_operations().find(REDUCTION);
+  template<size_t TASK,
+    size_t REDUCTION,
+    typename RETURN,
+    typename ARG_TUPLE>
+  static mpi_future_u<RETURN> execute_local_colors(void * function,
+    ARG_TUPLE & task_args) {
 
-      clog_assert(reduction_op != context_.reduction_operations().end(),
-        "invalid reduction operation");
+    context_t & context_ = context_t::instance();
+    const size_t colors_per_rank = context_.colors_per_rank();
 
-      const RETURN sendbuf = future.get();
-      RETURN recvbuf;
+    // Reject arguments that can not be bound to each color before any
+    // color executes.
+    local_colors_check_t local_colors_check;
+    local_colors_check.walk(task_args);
 
-      MPI_Allreduce(
-        &sendbuf, &recvbuf, 1, datatype, reduction_op->second, MPI_COMM_WORLD);
+    std::vector<ARG_TUPLE> color_args(colors_per_rank, task_args);
+    std::vector<mpi_future_u<RETURN>> futures(colors_per_rank);
+
+    context_.for_each_local_color([&](size_t local) {
+      bind_handles_t bind_handles;
+      bind_handles.walk(color_args[local]);
+
+      task_prolog_t task_prolog;
+      task_prolog.walk(color_args[local]);
+
+      futures[local] =
+        executor_u<RETURN, ARG_TUPLE>::execute(
+          function, color_args[local], TASK);
+    });
+
+    task_epilog_t task_epilog;
+    task_epilog.walk(color_args[0]);
+
+    for(auto & args : color_args) {
+      finalize_handles_t finalize_handles;
+      finalize_handles.walk(args);
+    } // for
+
+    constexpr size_t ZERO =
+      flecsi::utils::const_string_t{EXPAND_AND_STRINGIFY(0)}.hash();
+
+    if constexpr(REDUCTION != ZERO) {
+      flecsi_trace_region("reduction", "allreduce");
+      flecsi_trace_bytes(sizeof(RETURN));
+
+      MPI_Op op = reduction_operation(REDUCTION);
+      auto [datatype, count] = reduction_datatype<RETURN>(op);
+
+      // Combine the results of the local colors before the global
+      // reduction, so that only one value per rank is communicated.
+      RETURN sendbuf = futures[0].get();
+      for(size_t local{1}; local < colors_per_rank; ++local) {
+        RETURN value = futures[local].get();
+        MPI_Reduce_local(&value, &sendbuf, count, datatype, op);
+      } // for
+
+      RETURN recvbuf;
+      MPI_Allreduce(&sendbuf, &recvbuf, count, datatype, op, context_.comm());
 
       mpi_future_u<RETURN> gfuture;
       gfuture.set(recvbuf);
       return gfuture;
     }
     else {
-      return future;
+      return futures[0];
     } // if
-  } // execute_task
+  } // execute_local_colors
+
+  /*!
+    Return the MPI datatype and count used to reduce values of type RETURN
+    with the operation \em op.
+   */
+
+  template<typename RETURN>
+  static std::pair<MPI_Datatype, int> reduction_datatype(MPI_Op op) {
+    context_t & context_ = context_t::instance();
+    return mpi_reduction_datatype<RETURN>(op, context_.reduction_types());
+  } // reduction_datatype
+
+  /*!
+    Return the registered MPI operation of a reduction.
+   */
+
+  static MPI_Op reduction_operation(size_t reduction) {
+    context_t & context_ = context_t::instance();
+    auto reduction_op = context_.reduction_operations().find(reduction);
+
+    clog_assert(reduction_op != context_.reduction_operations().end(),
+      "invalid reduction operation");
+
+    return reduction_op->second;
+  } // reduction_operation
 
   //--------------------------------------------------------------------------//
   // Reduction interface.
@@ -33,6 +33,8 @@
 #include <flecsi/topology/mesh_topology.h>
 #include <flecsi/topology/set_topology.h>
 #include <flecsi/utils/mpi_type_traits.h>
+#include <flecsi/utils/set_utils.h>
+#include <flecsi/utils/trace.h>
 
 #include <flecsi/utils/tuple_walker.h>
 #include <flecsi/utils/type_traits.h>
@@ -57,12 +59,25 @@ struct finalize_handles_t
     auto & sparse_field_metadata =
       context.registered_sparse_field_metadata().at(h.fid);
 
-    value_t * shared_data =
-      new value_t[h.num_shared() * h.max_entries_per_index];
-    value_t * ghost_data = new value_t[h.num_ghost() * h.max_entries_per_index];
+    flecsi_trace_region("ghost", "mutator");
+
+    // The rows of padded fields are exchanged in place if they use the
+    // buffer of the field.
+    value_t * const shared_padding =
+      h.padded_block(h.num_exclusive_, h.num_shared());
+    value_t * const ghost_padding =
+      h.padded_block(h.num_exclusive_ + h.num_shared(), h.num_ghost());
+
+    value_t * shared_data = shared_padding;
+    value_t * ghost_data = ghost_padding;
+
+    if(!shared_padding)
+      shared_data = new value_t[h.num_shared() * h.max_entries_per_index];
+    if(!ghost_padding)
+      ghost_data = new value_t[h.num_ghost() * h.max_entries_per_index];
 
     // Load data into shared data buffer
-    for(int i = 0; i < h.num_shared(); ++i) {
+    for(int i = 0; !shared_padding && i < h.num_shared(); ++i) {
       int r = h.num_exclusive_ + i;
       const auto & row = h.rows[r];
       size_t count = row.size();
@@ -78,29 +93,27 @@ struct finalize_handles_t
     MPI_Win win;
     MPI_Win_create(shared_data,
       sizeof(value_t) * h.num_shared() * h.max_entries_per_index,
-      sizeof(value_t), MPI_INFO_NULL, MPI_COMM_WORLD, &win);
+      sizeof(value_t), MPI_INFO_NULL, context.comm(), &win);
 
     MPI_Win_post(sparse_field_metadata.shared_users_grp, 0, win);
     MPI_Win_start(sparse_field_metadata.ghost_owners_grp, 0, win);
 
     int i = 0;
     for(auto & ghost : index_coloring.ghost) {
-      clog_rank(warn, 0) << "ghost id: " << ghost.id << ", rank: " << ghost.rank
-                         << ", offset: " << ghost.offset << std::endl;
       MPI_Get(&ghost_data[i * h.max_entries_per_index], h.max_entries_per_index,
         shared_ghost_type, ghost.rank, ghost.offset * h.max_entries_per_index,
         h.max_entries_per_index, shared_ghost_type, win);
       i++;
     }
 
+    double start = MPI_Wtime();
+
     MPI_Win_complete(win);
     MPI_Win_wait(win);
 
-    MPI_Win_free(&win);
+    double wait_time = MPI_Wtime() - start;
 
-    // for (int i = 0; i < h.num_ghost() * h.max_entries_per_index; i++)
-    //  clog_rank(warn, 0) << "ghost after: " << ghost_data[i].value <<
-    //  std::endl;
+    MPI_Win_free(&win);
 
     int send_count = 0;
     for(auto & shared : index_coloring.shared) {
@@ -126,7 +139,7 @@ struct finalize_handles_t
       for(auto peer : shared.shared) {
         MPI_Isend(&send_count_buf[i], 1,
           flecsi::utils::mpi_typetraits_u<uint32_t>::type(), peer, 99,
-          MPI_COMM_WORLD, &requests[i]);
+          context.comm(), &requests[i]);
         i++;
       }
     }
@@ -137,16 +150,26 @@ struct finalize_handles_t
       MPI_Status status;
       MPI_Irecv(&recv_count_buf[i], 1,
         flecsi::utils::mpi_typetraits_u<uint32_t>::type(), ghost.rank, 99,
-        MPI_COMM_WORLD, &recv_requests[i]);
+        context.comm(), &recv_requests[i]);
       i++;
     }
 
+    start = MPI_Wtime();
     MPI_Waitall(send_count, requests.data(), statuses.data());
     MPI_Waitall(h.num_ghost(), recv_requests.data(), recv_status.data());
+    wait_time += MPI_Wtime() - start;
 
-    for(int i = 0; i < h.num_ghost(); i++) {
-      clog_rank(warn, 0) << recv_count_buf[i] << std::endl;
-    }
+    // Each ghost receives a full row and its entry count.
+    const size_t row_bytes =
+      h.max_entries_per_index * sizeof(value_t) + sizeof(uint32_t);
+    flecsi_trace_bytes(h.num_ghost() * row_bytes);
+
+    context.comm_stats(h.fid, h.index_space)
+      .record(2 * h.num_ghost() + send_count, send_count * row_bytes,
+        h.num_ghost() * row_bytes,
+        utils::set_union(my_coloring_info.ghost_owners,
+          my_coloring_info.shared_users).size(),
+        wait_time);
 
     // Unload data from ghost data buffer
     for(int i = 0; i < h.num_ghost(); i++) {
@@ -154,17 +177,28 @@ struct finalize_handles_t
       auto & row = h.rows[r];
       int count = recv_count_buf[i];
       row.resize(count);
-      std::memcpy(row.begin(), &ghost_data[i * h.max_entries_per_index],
-        count * sizeof(value_t));
+      if(!ghost_padding) {
+        std::memcpy(row.begin(), &ghost_data[i * h.max_entries_per_index],
+          count * sizeof(value_t));
+      }
     }
 
-    delete[] shared_data;
-    delete[] ghost_data;
+    if(!shared_padding)
+      delete[] shared_data;
+    if(!ghost_padding)
+      delete[] ghost_data;
+
+    // The structure of the field has changed.
+    if(h.transpose) {
+      h.transpose->invalidate();
+    } // if
 
   } // handle
 
   template<typename T>
   void handle(sparse_mutator<T> & m) {
+    // Sort the rows changed by batched operations.
+    m.commit();
     handle(m.ragged);
   }
 
@@ -193,8 +227,15 @@ struct finalize_handles_t
   typename std::enable_if_t<
     std::is_base_of<topology::mesh_topology_base_t, T>::value>
   handle(data_client_handle_u<T, PERMISSIONS> & h) {
+    auto & context_ = context_t::instance();
+
+    // Read-only storage is a topology view that is owned by the context.
+    if constexpr(PERMISSIONS == ro) {
+      h.clear_storage();
+      return;
+    } // if
+
     if(PERMISSIONS == wo || PERMISSIONS == rw) {
-      auto & context_ = context_t::instance();
       auto & ssm = context_.index_subspace_info();
 
       for(size_t i{0}; i < h.num_index_subspaces; ++i) {
@@ -210,6 +251,10 @@ struct finalize_handles_t
     } // if
 
     h.delete_storage();
+
+    // The views of the client no longer reflect its data.
+    context_.invalidate_topology_views(
+      h.type_hash, h.name_hash, h.namespace_hash);
   } // handle
 
   /*!
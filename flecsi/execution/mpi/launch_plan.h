@@ -0,0 +1,192 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mpi.h>
+
+#include <flecsi/data/accessor.h>
+#include <flecsi/data/common/data_reference.h>
+#include <flecsi/data/common/privilege.h>
+#include <flecsi/data/data_constants.h>
+#include <flecsi/data/mutator.h>
+#include <flecsi/execution/common/comm_stats.h>
+#include <flecsi/execution/mpi/node_exchange.h>
+#include <flecsi/runtime/types.h>
+
+namespace flecsi {
+namespace execution {
+
+/*!
+  The handle_traits_u type classifies a task argument type at compile time
+  by the launch phases that must visit it: the task prolog, the task
+  epilog, and handle finalization. Types that are not data references are
+  not visited by any phase. Data references without a specialization are
+  conservatively visited by every phase.
+
+  @ingroup execution
+ */
+
+template<typename T>
+struct handle_traits_u {
+  static constexpr bool is_handle =
+    std::is_base_of<data::data_reference_base_t, T>::value;
+
+  static constexpr bool prolog = is_handle;
+  static constexpr bool epilog = is_handle;
+  static constexpr bool finalize = is_handle;
+}; // struct handle_traits_u
+
+template<typename T, size_t E, size_t S, size_t G>
+struct handle_traits_u<accessor_u<data::dense, T, E, S, G>> {
+  static constexpr bool prolog = false;
+  static constexpr bool epilog = !(E == ro && S == ro);
+  static constexpr bool finalize = false;
+}; // struct handle_traits_u
+
+template<typename T, size_t E, size_t S, size_t G>
+struct handle_traits_u<accessor_u<data::ragged, T, E, S, G>> {
+  static constexpr bool prolog = false;
+  static constexpr bool epilog = !(E == ro && S == ro);
+  static constexpr bool finalize = false;
+}; // struct handle_traits_u
+
+template<typename T, size_t E, size_t S, size_t G>
+struct handle_traits_u<accessor_u<data::sparse, T, E, S, G>> {
+  static constexpr bool prolog = false;
+  static constexpr bool epilog = !(E == ro && S == ro);
+  static constexpr bool finalize = false;
+}; // struct handle_traits_u
+
+template<typename T, size_t P>
+struct handle_traits_u<accessor_u<data::global, T, P, 0, 0>> {
+  static constexpr bool prolog = true;
+  static constexpr bool epilog = P != ro;
+  static constexpr bool finalize = false;
+}; // struct handle_traits_u
+
+template<typename T, size_t P>
+struct handle_traits_u<accessor_u<data::color, T, P, 0, 0>> {
+  static constexpr bool prolog = false;
+  static constexpr bool epilog = false;
+  static constexpr bool finalize = false;
+}; // struct handle_traits_u
+
+template<typename T>
+struct handle_traits_u<mutator_u<data::ragged, T>> {
+  static constexpr bool prolog = false;
+  static constexpr bool epilog = false;
+  static constexpr bool finalize = true;
+}; // struct handle_traits_u
+
+template<typename T>
+struct handle_traits_u<mutator_u<data::sparse, T>> {
+  static constexpr bool prolog = false;
+  static constexpr bool epilog = false;
+  static constexpr bool finalize = true;
+}; // struct handle_traits_u
+
+template<typename T, size_t N>
+struct handle_traits_u<std::array<T, N>> : handle_traits_u<T> {};
+
+template<typename... Ts>
+struct handle_traits_u<std::tuple<Ts...>> {
+  static constexpr bool prolog =
+    (handle_traits_u<std::decay_t<Ts>>::prolog || ... || false);
+  static constexpr bool epilog =
+    (handle_traits_u<std::decay_t<Ts>>::epilog || ... || false);
+  static constexpr bool finalize =
+    (handle_traits_u<std::decay_t<Ts>>::finalize || ... || false);
+}; // struct handle_traits_u
+
+/*!
+  The cached ghost update of one dense field in the MPI task epilog. This
+  holds everything the epilog needs to issue the one-sided ghost copies of
+  the field without looking up the coloring or the field metadata.
+ */
+
+struct dense_ghost_plan_t {
+
+  struct get_t {
+    int owner;
+    MPI_Datatype origin_type;
+    MPI_Datatype target_type;
+  }; // struct get_t
+
+  bool matches(field_id_t fid_, size_t index_space_, size_t epoch_) const {
+    return win != MPI_WIN_NULL && fid == fid_ &&
+           index_space == index_space_ && epoch == epoch_;
+  } // matches
+
+  field_id_t fid = 0;
+  size_t index_space = 0;
+
+  // The coloring epoch in which the plan was built. Plans built before the
+  // coloring of their index space changed refer to released windows.
+  size_t epoch = 0;
+
+  // The number of ghost entities of the field on this rank, the number of
+  // copies of its shared entities that other ranks read, and the number of
+  // ranks that it communicates with.
+  size_t ghosts = 0;
+  size_t shared_copies = 0;
+  size_t neighbors = 0;
+
+  field_comm_stats_t * stats = nullptr;
+
+  MPI_Win win = MPI_WIN_NULL;
+  MPI_Group shared_users_grp = MPI_GROUP_NULL;
+  MPI_Group ghost_owners_grp = MPI_GROUP_NULL;
+  std::vector<get_t> gets;
+
+  // The shared-memory copies of the ghosts owned by ranks on the same
+  // node, if node ghosts are enabled.
+  node_exchange_t * node = nullptr;
+}; // struct dense_ghost_plan_t
+
+/*!
+  The communication plan of one task. An instance is cached for each task
+  launch site and filled on the first execution of the task. The plans of
+  the dense handles are stored in the order in which the epilog visits
+  them, and are rebuilt if a launch passes a different field in the same
+  argument position.
+
+  @ingroup execution
+ */
+
+struct launch_plan_t {
+
+  /*!
+    Return the ghost plan of the i-th writable dense handle of the task.
+   */
+
+  dense_ghost_plan_t & dense(size_t i) {
+    if(i >= dense_.size()) {
+      dense_.resize(i + 1);
+    } // if
+    return dense_[i];
+  } // dense
+
+private:
+  std::vector<dense_ghost_plan_t> dense_;
+}; // struct launch_plan_t
+
+} // namespace execution
+} // namespace flecsi
@@ -0,0 +1,194 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+#include <mpi.h>
+
+namespace flecsi {
+namespace execution {
+
+/*!
+  The node_exchange_t type copies the ghosts of a dense field that are
+  owned by ranks on the same node through an MPI shared-memory window.
+  Each rank publishes its shared entities in its segment of the window,
+  and the ranks of the node copy their ghosts from the segments of the
+  owners with plain loads.
+
+  Segments hold two buffers, which are used in turn by consecutive
+  exchanges, so that a rank can publish the next update while the other
+  ranks of the node may still read the previous one. One barrier on the
+  node communicator per exchange orders the writes and the reads.
+
+  @ingroup mpi-execution
+ */
+
+struct node_exchange_t {
+
+  /*!
+    A run of ghost bytes copied from the segment of one rank of the node.
+   */
+
+  struct copy_t {
+    size_t ghost;
+    int rank;
+    size_t offset;
+    size_t bytes;
+  }; // struct copy_t
+
+  /*!
+    Allocate the window. This is collective on \em comm.
+
+    @param comm         The communicator of the ranks of the node.
+    @param shared_bytes The size in bytes of the shared entities of this
+                        rank.
+   */
+
+  void create(MPI_Comm comm, size_t shared_bytes) {
+    comm_ = comm;
+    half_ = shared_bytes;
+
+    void * base;
+    MPI_Win_allocate_shared(
+      2 * shared_bytes, 1, MPI_INFO_NULL, comm, &base, &win_);
+    segment_ = static_cast<uint8_t *>(base);
+
+    // The window stays in a passive epoch, in which MPI_Win_sync
+    // synchronizes the public and private copies of the segments.
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+
+    int size;
+    MPI_Comm_size(comm, &size);
+    sources_.resize(size);
+
+    for(int r(0); r < size; ++r) {
+      MPI_Aint bytes;
+      int disp_unit;
+      void * data;
+      MPI_Win_shared_query(win_, r, &bytes, &disp_unit, &data);
+      sources_[r] = {static_cast<const uint8_t *>(data), size_t(bytes) / 2};
+    } // for
+  } // create
+
+  /*!
+    Add a ghost copy. Copies that continue the previous one are merged
+    with it.
+
+    @param ghost  The offset in bytes of the ghost in the ghost region.
+    @param rank   The owner's rank in the node communicator.
+    @param offset The offset in bytes of the entity in the owner's shared
+                  region.
+    @param bytes  The number of bytes to copy.
+   */
+
+  void add(size_t ghost, int rank, size_t offset, size_t bytes) {
+    if(!copies_.empty()) {
+      auto & last = copies_.back();
+
+      if(last.rank == rank && last.ghost + last.bytes == ghost &&
+         last.offset + last.bytes == offset) {
+        last.bytes += bytes;
+        return;
+      } // if
+    } // if
+
+    copies_.push_back({ghost, rank, offset, bytes});
+  } // add
+
+  /*!
+    Publish the shared entities of this rank and copy the ghosts owned by
+    the ranks of the node. This is collective on the node communicator.
+
+    @param shared The shared region of this rank.
+    @param ghosts The ghost region of this rank.
+   */
+
+  void exchange(const void * shared, void * ghosts) {
+    const size_t phase = phase_++ % 2;
+
+    if(half_ > 0) {
+      std::memcpy(segment_ + phase * half_, shared, half_);
+    } // if
+
+    MPI_Win_sync(win_);
+    MPI_Barrier(comm_);
+    MPI_Win_sync(win_);
+
+    auto dst = static_cast<uint8_t *>(ghosts);
+
+    for(auto & c : copies_) {
+      auto & s = sources_[c.rank];
+      std::memcpy(dst + c.ghost, s.data + phase * s.half + c.offset, c.bytes);
+    } // for
+  } // exchange
+
+  /*!
+    Return the number of bytes copied from the ranks of the node.
+   */
+
+  size_t bytes() const {
+    size_t sum = 0;
+
+    for(auto & c : copies_) {
+      sum += c.bytes;
+    } // for
+
+    return sum;
+  } // bytes
+
+  const std::vector<copy_t> & copies() const {
+    return copies_;
+  } // copies
+
+  bool active() const {
+    return win_ != MPI_WIN_NULL;
+  } // active
+
+  /*!
+    Free the window. This is collective on the node communicator.
+   */
+
+  void release() {
+    if(win_ != MPI_WIN_NULL) {
+      MPI_Win_unlock_all(win_);
+      MPI_Win_free(&win_);
+    } // if
+
+    copies_.clear();
+    sources_.clear();
+  } // release
+
+private:
+  struct source_t {
+    const uint8_t * data;
+    size_t half;
+  }; // struct source_t
+
+  MPI_Comm comm_ = MPI_COMM_NULL;
+  MPI_Win win_ = MPI_WIN_NULL;
+  uint8_t * segment_ = nullptr;
+  size_t half_ = 0;
+  size_t phase_ = 0;
+  std::vector<source_t> sources_;
+  std::vector<copy_t> copies_;
+}; // struct node_exchange_t
+
+} // namespace execution
+} // namespace flecsi
@@ -19,6 +19,7 @@
 
 #include <type_traits>
 
+#include <flecsi/execution/common/mpi_reduction.h>
 #include <flecsi/execution/context.h>
 #include <flecsi/utils/mpi_type_traits.h>
 
@@ -36,21 +37,6 @@ struct reduction_wrapper_u {
   // MPI does not have support for mixed-type reductions
   static_assert(std::is_same_v<lhs_t, rhs_t>, "type mismatch: LHS != RHS");
 
-  /*!
-    Wrapper to convert the type-erased MPI function to the typed C++ method.
-   */
-
-  static void
-  mpi_wrapper(void * in, void * inout, int * len, MPI_Datatype * dptr) {
-
-    lhs_t * lhs = reinterpret_cast<lhs_t *>(inout);
-    rhs_t * rhs = reinterpret_cast<rhs_t *>(in);
-
-    for(size_t i{0}; i < *len; ++i) {
-      TYPE::apply(lhs[i], rhs[i]);
-    } // for
-  } // mpi_wrapper
-
   /*!
     Register the user-defined reduction operator with the runtime.
    */
@@ -72,6 +58,12 @@ struct reduction_wrapper_u {
     clog_assert(reduction_ops.find(HASH) == reduction_ops.end(),
       typeid(TYPE).name() << " has already been registered with this name");
 
+    // Built-in reductions use the predefined MPI operations.
+    if constexpr(mpi_reduction_op_u<TYPE>::native) {
+      reduction_ops[HASH] = mpi_reduction_op_u<TYPE>::op();
+      return;
+    } // if
+
     // Create the MPI data type if it isn't P.O.D.
     if constexpr(!std::is_pod_v<lhs_t>) {
       // Get the datatype map from the context
@@ -95,7 +87,7 @@ struct reduction_wrapper_u {
 
     // Create the operator and register it with the runtime
     MPI_Op mpiop;
-    MPI_Op_create(mpi_wrapper, true, &mpiop);
+    MPI_Op_create(mpi_reduction_wrapper<TYPE>, true, &mpiop);
     reduction_ops[HASH] = mpiop;
   } // registration_callback
 
@@ -0,0 +1,239 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cinchlog.h>
+
+#include <flecsi/coloring/coloring_types.h>
+#include <flecsi/coloring/index_coloring.h>
+#include <flecsi/coloring/repartition.h>
+#include <flecsi/data/common/row_vector.h>
+#include <flecsi/data/data_constants.h>
+#include <flecsi/execution/context.h>
+#include <flecsi/execution/remap_shared.h>
+
+namespace flecsi {
+namespace execution {
+
+/*!
+  Replace the coloring of an index space during a run, e.g., to rebalance
+  the load between steps, and migrate the dense, sparse, and ragged field
+  data of the index space to the new coloring. Every entity of the new
+  coloring, including its ghosts, receives the current value of the
+  entity from its old owner, so no ghost update is needed afterwards.
+
+  The new coloring is given in the form produced by a specialization at
+  initialization, i.e., before the shared entities are renumbered. It is
+  typically computed from a new primary coloring, e.g., one returned by
+  geometric_colorer_u::recolor with measured per-entity costs.
+
+  The MPI windows and datatypes of the ghost copies of the migrated
+  fields are released, and cached communication plans are invalidated.
+  They are rebuilt for the new coloring when the next handle to a field is
+  created, so handles obtained before the repartition must not be used
+  after it. Topology data of the index space that stores local ids, e.g.,
+  mesh connectivity, is not remapped and must be rebuilt by the
+  specialization.
+
+  This is collective, and requires one color per rank.
+
+  @param index_space   The index space.
+  @param coloring      The new index coloring of this rank.
+  @param coloring_info The new coloring information of every color.
+
+  @ingroup mpi-execution
+ */
+
+inline void
+repartition(size_t index_space,
+  const coloring::index_coloring_t & coloring,
+  const std::unordered_map<size_t, coloring::coloring_info_t> &
+    coloring_info) {
+  using sparse_field_data_t = context_t::sparse_field_data_t;
+  using row_t = data::row_vector_u<uint8_t>;
+
+  auto & context = context_t::instance();
+
+  clog_assert(context.colors_per_rank() == 1,
+    "repartition requires one color per rank");
+
+  // The old storage follows the index map, which may have a reordered
+  // exclusive block. The new storage is in id order.
+  const auto & old_coloring = context.coloring(index_space);
+  std::vector<size_t> old_ids;
+
+  for(auto & i : context.index_map(index_space)) {
+    old_ids.push_back(i.second);
+  } // for
+
+  auto plan = coloring::make_migration_plan(old_ids,
+    old_coloring.exclusive.size() + old_coloring.shared.size(),
+    coloring::storage_ids(coloring));
+
+  const auto & info = coloring_info.at(context.color());
+
+  clog_assert(plan.new_size == info.exclusive + info.shared + info.ghost,
+    "coloring information does not match the coloring of index space "
+      << index_space);
+
+  //--------------------------------------------------------------------------//
+  // Collect the fields of the index space. Dense buffers are grown so that
+  // they can hold both the old and the new entities, and sparse rows are
+  // moved aside while the new rows are allocated.
+  //--------------------------------------------------------------------------//
+
+  struct dense_field_t {
+    field_id_t fid;
+    size_t type_size;
+    uint8_t * data;
+  }; // struct dense_field_t
+
+  struct sparse_field_t {
+    sparse_field_data_t old_data;
+    sparse_field_data_t * new_data;
+    const data::serdez_untyped_t * serdez;
+  }; // struct sparse_field_t
+
+  std::vector<dense_field_t> dense;
+  std::vector<sparse_field_t> sparse;
+
+  auto & sparse_field_data = context.registered_sparse_field_data();
+
+  for(auto & fi : context.registered_fields()) {
+    if(fi.index_space != index_space) {
+      continue;
+    } // if
+
+    if(fi.storage_class == data::dense) {
+      if(context.field_data(fi.fid) == nullptr) {
+        continue;
+      } // if
+
+      context.release_field_metadata(fi.fid);
+
+      auto data = context.register_field_data(fi.fid,
+        std::max(plan.old_size, plan.new_size) * fi.size, index_space);
+      dense.push_back({fi.fid, fi.size, data});
+    }
+    else if(fi.storage_class == data::sparse ||
+            fi.storage_class == data::ragged) {
+      auto it = sparse_field_data.find(fi.fid);
+
+      if(it == sparse_field_data.end()) {
+        continue;
+      } // if
+
+      context.release_field_metadata(fi.fid);
+
+      sparse_field_t field{std::move(it->second), nullptr,
+        context.get_serdez(fi.fid)};
+      context.register_sparse_field_data(fi.fid, field.old_data.type_size,
+        info, field.old_data.max_entries_per_index);
+      field.new_data = &it->second;
+      sparse.emplace_back(std::move(field));
+    } // if
+  } // for
+
+  //--------------------------------------------------------------------------//
+  // Migrate the data.
+  //--------------------------------------------------------------------------//
+
+  auto pack = [&](size_t position, std::vector<uint8_t> & buffer) {
+    for(auto & f : dense) {
+      const uint8_t * value = f.data + position * f.type_size;
+      buffer.insert(buffer.end(), value, value + f.type_size);
+    } // for
+
+    for(auto & f : sparse) {
+      std::ostringstream os;
+      f.serdez->serialize(
+        f.old_data.rows.data() + position * sizeof(row_t), os);
+
+      const std::string row = os.str();
+      const size_t bytes = row.size();
+      const uint8_t * b = reinterpret_cast<const uint8_t *>(&bytes);
+      buffer.insert(buffer.end(), b, b + sizeof(size_t));
+      buffer.insert(buffer.end(), row.begin(), row.end());
+    } // for
+  };
+
+  auto unpack = [&](size_t position, const uint8_t *& buffer) {
+    for(auto & f : dense) {
+      std::memcpy(f.data + position * f.type_size, buffer, f.type_size);
+      buffer += f.type_size;
+    } // for
+
+    for(auto & f : sparse) {
+      size_t bytes;
+      std::memcpy(&bytes, buffer, sizeof(size_t));
+      buffer += sizeof(size_t);
+
+      std::istringstream is(
+        std::string(reinterpret_cast<const char *>(buffer), bytes));
+      f.serdez->deserialize(
+        f.new_data->rows.data() + position * sizeof(row_t), is);
+      buffer += bytes;
+    } // for
+  };
+
+  coloring::migrate(plan, pack, unpack);
+
+  //--------------------------------------------------------------------------//
+  // Release the old storage.
+  //--------------------------------------------------------------------------//
+
+  for(auto & f : dense) {
+    context.register_field_data(
+      f.fid, plan.new_size * f.type_size, index_space);
+  } // for
+
+  for(auto & f : sparse) {
+    for(size_t i(0); i < f.old_data.num_total; ++i) {
+      f.serdez->destroy(f.old_data.rows.data() + i * sizeof(row_t));
+    } // for
+  } // for
+
+  //--------------------------------------------------------------------------//
+  // Replace the coloring and the index maps.
+  //--------------------------------------------------------------------------//
+
+  context.coloring(index_space) = coloring;
+  context.coloring_info_map()[index_space] = coloring_info;
+  context.set_exclusive_order(index_space, {});
+
+  remap_shared_entities(index_space);
+
+  std::map<size_t, size_t> index_map;
+  size_t counter(0);
+
+  for(auto id : context.storage_ids(index_space)) {
+    index_map[counter++] = id;
+  } // for
+
+  context.add_index_map(index_space, index_map);
+  context.advance_coloring_epoch();
+} // repartition
+
+} // namespace execution
+} // namespace flecsi
@@ -90,7 +90,11 @@ runtime_driver(int argc, char ** argv) {
   specialization_tlt_init(argc, argv);
 #endif // FLECSI_ENABLE_SPECIALIZATION_TLT_INIT
 
-  remap_shared_entities();
+  // With more than one color per rank, the local colorings already give
+  // the offsets of the ghosts in the shared regions of their owners.
+  if(context_.colors_per_rank() == 1) {
+    remap_shared_entities();
+  } // if
 
   // Setup maps from mesh to compacted (local) index space and vice versa
   //
@@ -101,19 +105,35 @@ runtime_driver(int argc, char ** argv) {
     std::map<size_t, size_t> _map;
     size_t counter(0);
 
-    for(auto index : is.second.exclusive) {
-      _map[counter++] = index.id;
+    // The exclusive entities may have been reordered by the
+    // specialization with context_t::set_exclusive_order.
+    for(auto id : context_.storage_ids(is.first)) {
+      _map[counter++] = id;
     } // for
 
-    for(auto index : is.second.shared) {
-      _map[counter++] = index.id;
-    } // for
+    context_.add_index_map(is.first, _map);
+  } // for
 
-    for(auto index : is.second.ghost) {
-      _map[counter++] = index.id;
+  // Size the first slab of each index space from the dense fields that
+  // are registered on it. Global and color fields share the default pool.
+
+  for(size_t local{0}; local < context_.colors_per_rank(); ++local) {
+    for(auto & fi : context_.registered_fields()) {
+      if(fi.storage_class == data::dense) {
+        auto it = context_.coloring_info_map().find(fi.index_space);
+
+        if(it != context_.coloring_info_map().end()) {
+          auto & info = it->second.at(context_.color() + local);
+          context_.reserve_field_data(local,
+            fi.size * (info.exclusive + info.shared + info.ghost),
+            fi.index_space);
+        } // if
+      }
+      else if(fi.storage_class == data::global ||
+              fi.storage_class == data::color) {
+        context_.reserve_field_data(local, fi.size);
+      } // if
     } // for
-
-    context_.add_index_map(is.first, _map);
   } // for
 
 #if defined(FLECSI_ENABLE_DYNAMIC_CONTROL_MODEL)
@@ -38,7 +38,10 @@
 #include <flecsi/data/data.h>
 #include <flecsi/data/dense_accessor.h>
 #include <flecsi/execution/context.h>
+#include <flecsi/execution/mpi/launch_plan.h>
 
+#include <flecsi/utils/set_utils.h>
+#include <flecsi/utils/trace.h>
 #include <flecsi/utils/tuple_walker.h>
 #include <flecsi/utils/type_traits.h>
 
@@ -61,6 +64,13 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
 
   task_epilog_t() = default;
 
+  /*!
+   Construct a task_epilog_t instance that caches the communication of the
+   task in the given plan.
+   */
+
+  task_epilog_t(launch_plan_t * plan) : plan_(plan) {}
+
   /*!
    FIXME: Need a description.
 
@@ -89,25 +99,91 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
       return;
 
     auto & context = context_t::instance();
-    const int my_color = context.color();
-    auto & my_coloring_info = context.coloring_info(h.index_space).at(my_color);
 
-    auto & field_metadata = context.registered_field_metadata().at(h.fid);
+    // With more than one color per rank, the epilog runs once after all
+    // local colors have executed and updates the ghosts of every color.
+    if(context.colors_per_rank() > 1) {
+      context.exchange_dense_ghosts(h.fid, h.index_space, sizeof(T),
+        context.coloring_info(h.index_space),
+        context.comm_stats(h.fid, h.index_space));
+      return;
+    } // if
+
+    dense_ghost_plan_t uncached;
+    dense_ghost_plan_t & plan =
+      plan_ != nullptr ? plan_->dense(dense_index_++) : uncached;
+
+    if(!plan.matches(h.fid, h.index_space, context.coloring_epoch())) {
+      build_dense_plan(plan, h.fid, h.index_space);
+    } // if
 
-    MPI_Win win = field_metadata.win;
+    flecsi_trace_region("ghost", "dense");
+    flecsi_trace_bytes(plan.ghosts * sizeof(T));
 
-    MPI_Win_post(field_metadata.shared_users_grp, 0, win);
-    MPI_Win_start(field_metadata.ghost_owners_grp, 0, win);
+    MPI_Win win = plan.win;
 
-    for(auto ghost_owner : my_coloring_info.ghost_owners) {
-      MPI_Get(h.ghost_data, 1, field_metadata.origin_types[ghost_owner],
-        ghost_owner, 0, 1, field_metadata.target_types[ghost_owner], win);
+    MPI_Win_post(plan.shared_users_grp, 0, win);
+    MPI_Win_start(plan.ghost_owners_grp, 0, win);
+
+    for(auto & get : plan.gets) {
+      MPI_Get(h.ghost_data, 1, get.origin_type, get.owner, 0, 1,
+        get.target_type, win);
     }
 
+    // Copy the ghosts owned on the node while the gets are in flight.
+    if(plan.node != nullptr) {
+      plan.node->exchange(h.shared_data, h.ghost_data);
+    } // if
+
+    const double start = MPI_Wtime();
+
     MPI_Win_complete(win);
     MPI_Win_wait(win);
+
+    plan.stats->record(plan.gets.size(), plan.shared_copies * sizeof(T),
+      plan.ghosts * sizeof(T), plan.neighbors, MPI_Wtime() - start);
   } // handle
 
+  /*!
+   Look up the coloring and field metadata of a dense field and record the
+   ghost copies of the field in \em plan.
+   */
+
+  static void build_dense_plan(dense_ghost_plan_t & plan,
+    field_id_t fid,
+    size_t index_space) {
+    auto & context = context_t::instance();
+    const int my_color = context.color();
+    auto & my_coloring_info = context.coloring_info(index_space).at(my_color);
+
+    auto & field_metadata = context.registered_field_metadata().at(fid);
+
+    plan.fid = fid;
+    plan.index_space = index_space;
+    plan.epoch = context.coloring_epoch();
+    plan.ghosts = my_coloring_info.ghost;
+    plan.shared_copies = 0;
+    for(auto & shared : context.coloring(index_space).shared) {
+      plan.shared_copies += shared.shared.size();
+    } // for
+    plan.neighbors = utils::set_union(my_coloring_info.ghost_owners,
+      my_coloring_info.shared_users).size();
+    plan.stats = &context.comm_stats(fid, index_space);
+    plan.win = field_metadata.win;
+    plan.shared_users_grp = field_metadata.shared_users_grp;
+    plan.ghost_owners_grp = field_metadata.ghost_owners_grp;
+
+    plan.node = field_metadata.node.active() ? &field_metadata.node : nullptr;
+
+    // The datatypes only cover the ghost owners that are not on the node
+    // when node ghosts are enabled.
+    plan.gets.clear();
+    for(auto & origin : field_metadata.origin_types) {
+      plan.gets.push_back({origin.first, origin.second,
+        field_metadata.target_types.at(origin.first)});
+    } // for
+  } // build_dense_plan
+
   template<typename T, size_t PERMISSIONS>
   void handle(global_accessor_u<T, PERMISSIONS> & a) {
     auto & h = a.handle;
@@ -119,7 +195,7 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
     auto & context = context_t::instance();
     const int my_color = context.color();
     MPI_Bcast(&a.data(), 1, flecsi::coloring::mpi_typetraits_u<T>::type(), 0,
-      MPI_COMM_WORLD);
+      context.comm());
   } // handle
 
   template<typename T,
@@ -139,6 +215,10 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
       return;
 
     auto & context = context_t::instance();
+
+    clog_assert(context.colors_per_rank() == 1,
+      "ragged and sparse data are not supported with colors_per_rank > 1");
+
     const int my_color = context.color();
     auto & my_coloring_info = context.coloring_info(h.index_space).at(my_color);
     auto index_coloring = context.coloring(h.index_space);
@@ -146,12 +226,25 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
     auto & sparse_field_metadata =
       context.registered_sparse_field_metadata().at(h.fid);
 
-    value_t * shared_data =
-      new value_t[h.num_shared_ * h.max_entries_per_index];
-    value_t * ghost_data = new value_t[h.num_ghost_ * h.max_entries_per_index];
+    flecsi_trace_region("ghost", "ragged");
+
+    // The rows of padded fields are exchanged in place if they use the
+    // buffer of the field.
+    value_t * const shared_padding =
+      h.padded_block(h.num_exclusive_, h.num_shared_);
+    value_t * const ghost_padding =
+      h.padded_block(h.num_exclusive_ + h.num_shared_, h.num_ghost_);
+
+    value_t * shared_data = shared_padding;
+    value_t * ghost_data = ghost_padding;
+
+    if(!shared_padding)
+      shared_data = new value_t[h.num_shared_ * h.max_entries_per_index];
+    if(!ghost_padding)
+      ghost_data = new value_t[h.num_ghost_ * h.max_entries_per_index];
 
     // Load data into shared data buffer
-    for(int i = 0; i < h.num_shared_; ++i) {
+    for(int i = 0; !shared_padding && i < h.num_shared_; ++i) {
       int r = i + h.num_exclusive_;
       const auto & row = h.rows[r];
       size_t count = row.size();
@@ -167,28 +260,27 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
     MPI_Win win;
     MPI_Win_create(shared_data,
       sizeof(value_t) * h.num_shared_ * h.max_entries_per_index,
-      sizeof(value_t), MPI_INFO_NULL, MPI_COMM_WORLD, &win);
+      sizeof(value_t), MPI_INFO_NULL, context.comm(), &win);
 
     MPI_Win_post(sparse_field_metadata.shared_users_grp, 0, win);
     MPI_Win_start(sparse_field_metadata.ghost_owners_grp, 0, win);
 
     int i = 0;
     for(auto & ghost : index_coloring.ghost) {
-      clog_rank(warn, 0) << "ghost id: " << ghost.id << ", rank: " << ghost.rank
-                         << ", offset: " << ghost.offset << std::endl;
       MPI_Get(&ghost_data[i * h.max_entries_per_index], h.max_entries_per_index,
         shared_ghost_type, ghost.rank, ghost.offset * h.max_entries_per_index,
         h.max_entries_per_index, shared_ghost_type, win);
       i++;
     }
 
+    double start = MPI_Wtime();
+
     MPI_Win_complete(win);
     MPI_Win_wait(win);
 
-    MPI_Win_free(&win);
+    double wait_time = MPI_Wtime() - start;
 
-    for(int i = 0; i < h.num_ghost_ * h.max_entries_per_index; i++)
-      clog_rank(warn, 0) << "ghost after: " << ghost_data[i] << std::endl;
+    MPI_Win_free(&win);
 
     int send_count = 0;
     for(auto & shared : index_coloring.shared) {
@@ -212,7 +304,7 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
       for(auto peer : shared.shared) {
         MPI_Isend(&send_count_buf[i], 1,
           flecsi::coloring::mpi_typetraits_u<uint32_t>::type(), peer, shared.id,
-          MPI_COMM_WORLD, &requests[i]);
+          context.comm(), &requests[i]);
         i++;
       }
     }
@@ -223,15 +315,25 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
       MPI_Status status;
       MPI_Irecv(&recv_count_buf[i], 1,
         flecsi::coloring::mpi_typetraits_u<uint32_t>::type(), ghost.rank,
-        ghost.id, MPI_COMM_WORLD, &requests[i + send_count]);
+        ghost.id, context.comm(), &requests[i + send_count]);
       i++;
     }
 
+    start = MPI_Wtime();
     MPI_Waitall(send_count + h.num_ghost_, requests.data(), statuses.data());
+    wait_time += MPI_Wtime() - start;
 
-    for(int i = 0; i < h.num_ghost_; i++) {
-      clog_rank(warn, 0) << recv_count_buf[i] << std::endl;
-    }
+    // Each ghost receives a full row and its entry count.
+    const size_t row_bytes =
+      h.max_entries_per_index * sizeof(value_t) + sizeof(uint32_t);
+    flecsi_trace_bytes(h.num_ghost_ * row_bytes);
+
+    context.comm_stats(h.fid, h.index_space)
+      .record(2 * h.num_ghost_ + send_count, send_count * row_bytes,
+        h.num_ghost_ * row_bytes,
+        utils::set_union(my_coloring_info.ghost_owners,
+          my_coloring_info.shared_users).size(),
+        wait_time);
 
     // Unload data from ghost data buffer
     for(int i = 0; i < h.num_ghost_; i++) {
@@ -239,12 +341,16 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
       auto & row = h.rows[r];
       int count = recv_count_buf[i];
       row.resize(count);
-      std::memcpy(row.begin(), &ghost_data[i * h.max_entries_per_index],
-        count * sizeof(value_t));
+      if(!ghost_padding) {
+        std::memcpy(row.begin(), &ghost_data[i * h.max_entries_per_index],
+          count * sizeof(value_t));
+      }
     }
 
-    delete[] shared_data;
-    delete[] ghost_data;
+    if(!shared_padding)
+      delete[] shared_data;
+    if(!ghost_padding)
+      delete[] ghost_data;
 
   } // handle
 
@@ -282,19 +388,19 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
       constexpr auto DIM = entity_type_t::dimension;
       constexpr auto DOM = entity_type_t::domain;
 
+      // get context information
+      auto & context = context_t::instance();
+      const int my_color = context.color();
+
       // mpi stats
       int comm_size, comm_rank;
-      MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
-      MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank);
+      MPI_Comm_size(context.comm(), &comm_size);
+      MPI_Comm_rank(context.comm(), &comm_rank);
 
       // loop over entities and exchange the ghost values
       auto entity_size = sizeof(entity_type_t);
       auto entities = h.template get_entities<DIM, DOM>();
 
-      // get context information
-      auto & context = context_t::instance();
-      const int my_color = context.color();
-
       // figure out index space id
       constexpr auto index_space = topology::find_index_space_from_dimension_u<
         std::tuple_size<entity_types_t>::value, entity_types_t, DIM,
@@ -354,7 +460,7 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
 
       // exchange data
       auto ret = coloring::alltoallv(sendbuf, sendcounts, senddispls, recvbuf,
-        recvcounts, recvdispls, MPI_COMM_WORLD);
+        recvcounts, recvdispls, context.comm());
       if(ret != MPI_SUCCESS)
         clog_error("Error communicating vertices");
 
@@ -394,6 +500,9 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
     if(PERMISSIONS == ro)
       return;
 
+    clog_assert(context_t::instance().colors_per_rank() == 1,
+      "writing mesh topology is not supported with colors_per_rank > 1");
+
     // iterate over types
     client_handler<0>(h);
   }
@@ -437,6 +546,10 @@ struct task_epilog_t : public flecsi::utils::tuple_walker_u<task_epilog_t> {
   template<typename T>
   void handle(T &) {} // handle
 
+private:
+  launch_plan_t * plan_ = nullptr;
+  size_t dense_index_ = 0;
+
 }; // struct task_epilog_t
 
 } // namespace execution
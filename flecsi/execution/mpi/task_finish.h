@@ -0,0 +1,65 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <flecsi/execution/mpi/finalize_handles.h>
+#include <flecsi/execution/mpi/launch_plan.h>
+#include <flecsi/execution/mpi/task_epilog.h>
+#include <flecsi/utils/tuple_walker.h>
+
+namespace flecsi {
+namespace execution {
+
+/*!
+ The task_finish_t type fuses the task epilog and the finalization of the
+ task handles into a single walk over the task args. Each argument is
+ passed to task_epilog_t and then to finalize_handles_t. Arguments that
+ need neither phase are skipped at compile time.
+
+ @ingroup execution
+ */
+
+struct task_finish_t : public flecsi::utils::tuple_walker_u<task_finish_t> {
+
+  /*!
+   Construct a task_finish_t instance.
+
+   @param plan The cached communication plan of the task, or nullptr.
+   */
+
+  task_finish_t(launch_plan_t * plan = nullptr) : task_epilog_(plan) {}
+
+  template<typename T>
+  void handle(T & t) {
+    using traits_t = handle_traits_u<std::decay_t<T>>;
+
+    if constexpr(traits_t::epilog) {
+      task_epilog_.handle(t);
+    } // if
+
+    if constexpr(traits_t::finalize) {
+      finalize_handles_.handle(t);
+    } // if
+  } // handle
+
+private:
+  task_epilog_t task_epilog_;
+  finalize_handles_t finalize_handles_;
+
+}; // struct task_finish_t
+
+} // namespace execution
+} // namespace flecsi
@@ -15,6 +15,7 @@ All rights reserved.
 
 /*! @file */
 
+#include <memory>
 #include <vector>
 
 #include "mpi.h"
@@ -64,15 +65,29 @@ struct task_prolog_t : public flecsi::utils::tuple_walker_u<task_prolog_t> {
   typename std::enable_if_t<
     std::is_base_of<topology::mesh_topology_base_t, T>::value>
   handle(data_client_handle_u<T, PERMISSIONS> & h) {
+    using storage_t = typename T::storage_t;
+
     auto & context_ = context_t::instance();
 
+    int color = context_.color();
+
+    // Read-only storage is built on the first launch and reused until a
+    // task with write permissions on the client invalidates it.
+    const context_t::topology_view_key_t key{
+      h.type_hash, h.name_hash, h.namespace_hash, size_t(color)};
+
+    if constexpr(PERMISSIONS == ro) {
+      if(auto view = context_.topology_view<storage_t>(key)) {
+        h.set_storage(view);
+        return;
+      } // if
+    } // if
+
     // h is partially initialized in client.h
-    auto storage = h.set_storage(new typename T::storage_t);
+    auto storage = h.set_storage(new storage_t);
 
     bool _read{PERMISSIONS == ro || PERMISSIONS == rw};
 
-    int color = context_.color();
-
     for(size_t i{0}; i < h.num_handle_entities; ++i) {
       data_client_handle_entity_t & ent = h.handle_entities[i];
 
@@ -89,24 +104,21 @@ struct task_prolog_t : public flecsi::utils::tuple_walker_u<task_prolog_t> {
       auto num_entities = ent.num_exclusive + ent.num_shared + ent.num_ghost;
 
       // see if the field data is registered for this entity field.
-      auto & registered_field_data = context_.registered_field_data();
-      auto fieldDataIter = registered_field_data.find(ent.fid);
-      if(fieldDataIter == registered_field_data.end()) {
+      auto ent_data = context_.field_data(ent.fid);
+      if(ent_data == nullptr) {
         size_t size = ent.size * num_entities;
 
-        execution::context_t::instance().register_field_data(ent.fid, size);
+        ent_data = context_.register_field_data(ent.fid, size, index_space);
       }
-      auto ents = reinterpret_cast<topology::mesh_entity_base_ *>(
-        registered_field_data[ent.fid].data());
+      auto ents = reinterpret_cast<topology::mesh_entity_base_ *>(ent_data);
 
-      fieldDataIter = registered_field_data.find(ent.id_fid);
-      if(fieldDataIter == registered_field_data.end()) {
+      auto id_data = context_.field_data(ent.id_fid);
+      if(id_data == nullptr) {
         size_t size = ent.size * num_entities;
 
-        execution::context_t::instance().register_field_data(ent.id_fid, size);
+        id_data = context_.register_field_data(ent.id_fid, size, index_space);
       }
-      auto ids = reinterpret_cast<utils::id_t *>(
-        registered_field_data[ent.id_fid].data());
+      auto ids = reinterpret_cast<utils::id_t *>(id_data);
 
       // new allocation every time.
       storage->init_entities(ent.domain, ent.dim, ents, ids, ent.size,
@@ -121,30 +133,27 @@ struct task_prolog_t : public flecsi::utils::tuple_walker_u<task_prolog_t> {
       const size_t to_index_space = adj.to_index_space;
 
       auto & color_info = (context_.coloring_info(from_index_space)).at(color);
-      auto & registered_field_data = context_.registered_field_data();
 
       adj.num_offsets =
         (color_info.exclusive + color_info.shared + color_info.ghost);
-      auto fieldDataIter = registered_field_data.find(adj.offset_fid);
-      if(fieldDataIter == registered_field_data.end()) {
+      auto offset_data = context_.field_data(adj.offset_fid);
+      if(offset_data == nullptr) {
         size_t size = sizeof(size_t) * adj.num_offsets;
 
-        execution::context_t::instance().register_field_data(
-          adj.offset_fid, size);
+        offset_data =
+          context_.register_field_data(adj.offset_fid, size, adj_index_space);
       }
-      adj.offsets_buf = reinterpret_cast<size_t *>(
-        registered_field_data[adj.offset_fid].data());
+      adj.offsets_buf = reinterpret_cast<size_t *>(offset_data);
 
       auto adj_info = (context_.adjacency_info()).at(adj_index_space);
       adj.num_indices = adj_info.color_sizes[color];
-      fieldDataIter = registered_field_data.find(adj.index_fid);
-      if(fieldDataIter == registered_field_data.end()) {
+      auto index_data = context_.field_data(adj.index_fid);
+      if(index_data == nullptr) {
         size_t size = sizeof(utils::id_t) * adj.num_indices;
-        execution::context_t::instance().register_field_data(
-          adj.index_fid, size);
+        index_data =
+          context_.register_field_data(adj.index_fid, size, adj_index_space);
       }
-      adj.indices_buf =
-        reinterpret_cast<id_t *>(registered_field_data[adj.index_fid].data());
+      adj.indices_buf = reinterpret_cast<id_t *>(index_data);
 
       storage->init_connectivity(adj.from_domain, adj.to_domain, adj.from_dim,
         adj.to_dim, reinterpret_cast<utils::offset_t *>(adj.offsets_buf),
@@ -159,16 +168,14 @@ struct task_prolog_t : public flecsi::utils::tuple_walker_u<task_prolog_t> {
       // the num indices is the capacity (
       auto num_indices = iss_info.capacity;
       // register the field
-      auto & registered_field_data = context_.registered_field_data();
-      auto fieldDataIter = registered_field_data.find(iss.index_fid);
-      if(fieldDataIter == registered_field_data.end()) {
+      auto index_data = context_.field_data(iss.index_fid);
+      if(index_data == nullptr) {
         auto size = sizeof(utils::id_t) * num_indices;
-        execution::context_t::instance().register_field_data(
-          iss.index_fid, size);
+        index_data = context_.register_field_data(
+          iss.index_fid, size, iss.index_space);
       }
       // assign the storage to the buffer
-      iss.indices_buf =
-        reinterpret_cast<id_t *>(registered_field_data[iss.index_fid].data());
+      iss.indices_buf = reinterpret_cast<id_t *>(index_data);
       // now initialize the index subspace
       storage->init_index_subspace(iss.index_space, iss.index_subspace,
         iss.domain, iss.dim, reinterpret_cast<utils::id_t *>(iss.indices_buf),
@@ -178,6 +185,10 @@ struct task_prolog_t : public flecsi::utils::tuple_walker_u<task_prolog_t> {
     if(!_read) {
       h.initialize_storage();
     }
+
+    if constexpr(PERMISSIONS == ro) {
+      context_.add_topology_view(key, std::unique_ptr<storage_t>(storage));
+    } // if
   } // handle
 
   /*!
@@ -215,25 +226,23 @@ struct task_prolog_t : public flecsi::utils::tuple_walker_u<task_prolog_t> {
       auto & color_info = citr->second;
 
       // see if the field data is registered for this entity field.
-      auto & registered_field_data = context_.registered_field_data();
-      auto fieldDataIter = registered_field_data.find(ent.fid);
-      if(fieldDataIter == registered_field_data.end()) {
+      if(!context_.registered_field_data().contains(ent.fid)) {
         size_t size = ent.size * color_info.main_capacity;
-        context_.register_field_data(ent.fid, size);
+        context_.register_field_data(ent.fid, size, ent.index_space);
 
         size = ent.size * color_info.active_migrate_capacity;
-        context_.register_field_data(ent.fid2, size);
-        context_.register_field_data(ent.fid3, size);
+        context_.register_field_data(ent.fid2, size, ent.index_space);
+        context_.register_field_data(ent.fid3, size, ent.index_space);
       }
 
-      auto ents = reinterpret_cast<topology::set_entity_t *>(
-        registered_field_data[ent.fid].data());
+      auto ents =
+        reinterpret_cast<topology::set_entity_t *>(context_.field_data(ent.fid));
 
       auto active_ents = reinterpret_cast<topology::set_entity_t *>(
-        registered_field_data[ent.fid2].data());
+        context_.field_data(ent.fid2));
 
       auto migrate_ents = reinterpret_cast<topology::set_entity_t *>(
-        registered_field_data[ent.fid3].data());
+        context_.field_data(ent.fid3));
 
       storage->init_entities(ent.index_space, ent.index_space2, ents, 0,
         active_ents, 0, migrate_ents, 0, ent.size, _read);
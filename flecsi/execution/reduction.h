@@ -2,7 +2,12 @@
 
 /*! @file */
 
+#include <array>
+#include <cstddef>
 #include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include <flecsi/execution/execution.h>
 
@@ -19,6 +24,28 @@ namespace reduction {
   flecsi_register_reduction_operation(operation, float);                       \
   flecsi_register_reduction_operation(operation, double);
 
+/*!
+  Atomically replace \em target with op(target, value). This is used by the
+  non-exclusive operations, e.g., when several threads reduce into the same
+  element. The compare-and-swap operates on the object representation of
+  T, whose size must be supported by the atomic builtins.
+ */
+
+template<typename T, typename OPERATION>
+inline void
+atomic_update(T & target, T value, OPERATION && op) {
+  static_assert(std::is_trivially_copyable_v<T>,
+    "atomic reductions require a trivially copyable type");
+
+  T expected, desired;
+  __atomic_load(&target, &expected, __ATOMIC_RELAXED);
+
+  do {
+    desired = op(expected, value);
+  } while(!__atomic_compare_exchange(&target, &expected, &desired, true,
+    __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+} // atomic_update
+
 //----------------------------------------------------------------------------//
 // Min
 //----------------------------------------------------------------------------//
@@ -40,18 +67,7 @@ struct min {
       lhs = lhs < rhs ? lhs : rhs;
     }
     else {
-      int64_t * target = (int64_t *)&lhs;
-      union
-      {
-        int64_t as_int;
-        T as_T;
-      } oldval, newval;
-      do {
-        oldval.as_int = *target;
-        newval.as_T = std::min(oldval.as_T, rhs);
-      } while(
-        !__sync_bool_compare_and_swap(target, oldval.as_int, newval.as_int));
-
+      atomic_update(lhs, rhs, [](T a, T b) { return a < b ? a : b; });
     } // if constexpr
 
   } // apply
@@ -63,17 +79,7 @@ struct min {
       rhs1 = std::min(rhs1, rhs2);
     }
     else {
-      int64_t * target = (int64_t *)&rhs1;
-      union
-      {
-        int64_t as_int;
-        T as_T;
-      } oldval, newval;
-      do {
-        oldval.as_int = *target;
-        newval.as_T = std::min(oldval.as_T, rhs2);
-      } while(
-        !__sync_bool_compare_and_swap(target, oldval.as_int, newval.as_int));
+      atomic_update(rhs1, rhs2, [](T a, T b) { return a < b ? a : b; });
     } // if constexpr
 
   } // fold
@@ -95,7 +101,7 @@ struct max {
 
   using LHS = T;
   using RHS = T;
-  static constexpr T identity{};
+  static constexpr T identity{std::numeric_limits<T>::lowest()};
 
   template<bool EXCLUSIVE = true>
   static void apply(LHS & lhs, RHS rhs) {
@@ -104,6 +110,7 @@ struct max {
       lhs = lhs > rhs ? lhs : rhs;
     }
     else {
+      atomic_update(lhs, rhs, [](T a, T b) { return a > b ? a : b; });
     } // if constexpr
 
   } // apply
@@ -115,6 +122,7 @@ struct max {
       lhs = lhs > rhs ? lhs : rhs;
     }
     else {
+      atomic_update(lhs, rhs, [](T a, T b) { return a > b ? a : b; });
     } // if constexpr
 
   } // fold
@@ -145,6 +153,7 @@ struct sum {
       lhs += rhs;
     }
     else {
+      atomic_update(lhs, rhs, [](T a, T b) { return a + b; });
     } // if constexpr
 
   } // apply
@@ -156,6 +165,7 @@ struct sum {
       lhs += rhs;
     }
     else {
+      atomic_update(lhs, rhs, [](T a, T b) { return a + b; });
     } // if constexpr
 
   } // fold
@@ -177,7 +187,7 @@ struct product {
 
   using LHS = T;
   using RHS = T;
-  static constexpr T identity{};
+  static constexpr T identity{1};
 
   template<bool EXCLUSIVE = true>
   static void apply(LHS & lhs, RHS rhs) {
@@ -186,6 +196,7 @@ struct product {
       lhs *= rhs;
     }
     else {
+      atomic_update(lhs, rhs, [](T a, T b) { return a * b; });
     } // if constexpr
 
   } // apply
@@ -197,6 +208,7 @@ struct product {
       lhs *= rhs;
     }
     else {
+      atomic_update(lhs, rhs, [](T a, T b) { return a * b; });
     } // if constexpr
 
   } // fold
@@ -205,6 +217,130 @@ struct product {
 
 flecsi_register_operation_types(product);
 
+//----------------------------------------------------------------------------//
+// Vector reductions
+//----------------------------------------------------------------------------//
+
+/*!
+  Return an array whose elements are all \em value.
+ */
+
+template<typename T, std::size_t SIZE>
+constexpr std::array<T, SIZE>
+filled_array(T value) {
+  std::array<T, SIZE> result{};
+  for(std::size_t i{0}; i < SIZE; ++i) {
+    result[i] = value;
+  } // for
+  return result;
+} // filled_array
+
+/*!
+  Element-wise reduction of a fixed-size array with a scalar operation.
+  The min, max, sum, and product types of std::array derive from it, so
+  that, e.g., sum<std::array<double, 3>> sums three values in one call.
+
+  @tparam OPERATION The reduction type of the elements.
+  @tparam SIZE      The number of elements.
+ */
+
+template<typename OPERATION, std::size_t SIZE>
+struct elementwise_u {
+
+  using element_t = typename OPERATION::LHS;
+  using LHS = std::array<element_t, SIZE>;
+  using RHS = LHS;
+
+  static constexpr LHS identity =
+    filled_array<element_t, SIZE>(OPERATION::identity);
+
+  template<bool EXCLUSIVE = true>
+  static void apply(LHS & lhs, const RHS & rhs) {
+    for(std::size_t i{0}; i < SIZE; ++i) {
+      OPERATION::template apply<EXCLUSIVE>(lhs[i], rhs[i]);
+    } // for
+  } // apply
+
+  template<bool EXCLUSIVE = true>
+  static void fold(RHS & rhs1, const RHS & rhs2) {
+    for(std::size_t i{0}; i < SIZE; ++i) {
+      OPERATION::template fold<EXCLUSIVE>(rhs1[i], rhs2[i]);
+    } // for
+  } // fold
+
+}; // struct elementwise_u
+
+template<typename T, std::size_t SIZE>
+struct min<std::array<T, SIZE>> : elementwise_u<min<T>, SIZE> {};
+
+template<typename T, std::size_t SIZE>
+struct max<std::array<T, SIZE>> : elementwise_u<max<T>, SIZE> {};
+
+template<typename T, std::size_t SIZE>
+struct sum<std::array<T, SIZE>> : elementwise_u<sum<T>, SIZE> {};
+
+template<typename T, std::size_t SIZE>
+struct product<std::array<T, SIZE>> : elementwise_u<product<T>, SIZE> {};
+
+/*!
+  Reduction of several values of the same type with a different operation
+  for each of them, in one call. The reduced value is a std::array with one
+  element per operation. For example, a task that computes a time step
+  limit, the maximum wave speed, and the total mass may return
+
+  @code
+  template<typename T>
+  using hydro = composite<min<T>, max<T>, sum<T>>;
+
+  flecsi_register_reduction_operation(hydro, double);
+  @endcode
+
+  and be launched with flecsi_execute_reduction_task(..., hydro, double,
+  ...).
+
+  @tparam OPERATIONS The reduction types of the elements.
+ */
+
+template<typename... OPERATIONS>
+struct composite {
+
+  using element_t =
+    typename std::tuple_element_t<0, std::tuple<OPERATIONS...>>::LHS;
+
+  static_assert(
+    (std::is_same_v<element_t, typename OPERATIONS::LHS> && ...),
+    "composite reductions require a common element type");
+
+  using LHS = std::array<element_t, sizeof...(OPERATIONS)>;
+  using RHS = LHS;
+
+  static constexpr LHS identity{{OPERATIONS::identity...}};
+
+  template<bool EXCLUSIVE = true>
+  static void apply(LHS & lhs, const RHS & rhs) {
+    apply<EXCLUSIVE>(
+      lhs, rhs, std::make_index_sequence<sizeof...(OPERATIONS)>());
+  } // apply
+
+  template<bool EXCLUSIVE = true>
+  static void fold(RHS & rhs1, const RHS & rhs2) {
+    fold<EXCLUSIVE>(
+      rhs1, rhs2, std::make_index_sequence<sizeof...(OPERATIONS)>());
+  } // fold
+
+private:
+  template<bool EXCLUSIVE, std::size_t... I>
+  static void apply(LHS & lhs, const RHS & rhs, std::index_sequence<I...>) {
+    (OPERATIONS::template apply<EXCLUSIVE>(lhs[I], rhs[I]), ...);
+  } // apply
+
+  template<bool EXCLUSIVE, std::size_t... I>
+  static void fold(RHS & rhs1, const RHS & rhs2, std::index_sequence<I...>) {
+    (OPERATIONS::template fold<EXCLUSIVE>(rhs1[I], rhs2[I]), ...);
+  } // fold
+
+}; // struct composite
+
 } // namespace reduction
 } // namespace execution
 } // namespace flecsi
@@ -0,0 +1,103 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <sstream>
+
+#include <flecsi/execution/common/comm_stats.h>
+
+using namespace flecsi::execution;
+
+TEST(comm_stats, record) {
+  field_comm_stats_t stats;
+
+  stats.record(4, 100, 80, 2, 0.5);
+  stats.record(3, 50, 40, 3, 0.25);
+
+  ASSERT_EQ(stats.exchanges, 2);
+  ASSERT_EQ(stats.messages, 7);
+  ASSERT_EQ(stats.bytes_sent, 150);
+  ASSERT_EQ(stats.bytes_received, 120);
+  ASSERT_EQ(stats.neighbors, 3);
+  ASSERT_DOUBLE_EQ(stats.wait_time, 0.75);
+
+  field_comm_stats_t other;
+  other.record(1, 10, 10, 5, 1.0);
+  stats.merge(other);
+
+  ASSERT_EQ(stats.exchanges, 2);
+  ASSERT_EQ(stats.messages, 8);
+  ASSERT_EQ(stats.bytes_sent, 160);
+  ASSERT_EQ(stats.bytes_received, 130);
+  ASSERT_EQ(stats.neighbors, 5);
+  ASSERT_DOUBLE_EQ(stats.wait_time, 1.0);
+} // TEST
+
+TEST(comm_stats, write) {
+  field_comm_stats_map_t stats;
+  stats[3].index_space = 1;
+  stats[3].record(2, 16, 16, 1, 0.125);
+  stats[7].index_space = 0;
+  stats[7].record(2, 16, 16, 1, 2.0);
+
+  std::ostringstream os;
+  write_comm_stats(os, stats);
+
+  // A header and one line per field, the slowest first.
+  std::istringstream is(os.str());
+  std::string header, first, second;
+  std::getline(is, header);
+  std::getline(is, first);
+  std::getline(is, second);
+
+  ASSERT_NE(header.find("exchanges"), std::string::npos);
+
+  std::istringstream fs(first), ss(second);
+  size_t fid;
+  fs >> fid;
+  ASSERT_EQ(fid, 7);
+  ss >> fid;
+  ASSERT_EQ(fid, 3);
+} // TEST
+
+TEST(comm_stats, reduce) {
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // Every rank communicates field 0, and only rank 1 field 1.
+  field_comm_stats_map_t stats;
+  stats[0].index_space = 2;
+  stats[0].record(rank + 1, 8 * (rank + 1), 8, rank, 0.5 * rank);
+
+  if(rank == 1) {
+    stats[1].record(1, 4, 4, 1, 0.0);
+  } // if
+
+  auto result = reduce_comm_stats(stats, MPI_COMM_WORLD);
+
+  if(rank != 0) {
+    ASSERT_TRUE(result.empty());
+    return;
+  } // if
+
+  ASSERT_EQ(result.size(), size > 1 ? 2 : 1);
+
+  auto & s = result.at(0);
+  ASSERT_EQ(s.index_space, 2);
+  ASSERT_EQ(s.exchanges, 1);
+  ASSERT_EQ(s.messages, size_t(size * (size + 1) / 2));
+  ASSERT_EQ(s.bytes_sent, size_t(4 * size * (size + 1)));
+  ASSERT_EQ(s.bytes_received, size_t(8 * size));
+  ASSERT_EQ(s.neighbors, size_t(size - 1));
+  ASSERT_DOUBLE_EQ(s.wait_time, 0.5 * (size - 1));
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -11,6 +11,8 @@
 #include <cinchlog.h>
 #include <cinchtest.h>
 
+#include <cstdlib>
+
 #include <flecsi/data/dense_accessor.h>
 #include <flecsi/execution/execution.h>
 #include <flecsi/supplemental/coloring/add_colorings.h>
@@ -19,6 +21,12 @@
 #define INDEX_ID 0
 #define VERSIONS 1
 
+#if defined(FLECSI_TEST_NODE_GHOSTS)
+// The runtime reads the ghost copy mode when it is initialized, after the
+// static initialization of this unit.
+static const int node_ghosts_env = setenv("FLECSI_NODE_GHOSTS", "1", 0);
+#endif
+
 using namespace flecsi;
 using namespace supplemental;
 using namespace topology;
@@ -82,6 +90,10 @@ driver(int argc, char ** argv) {
 
   clog(trace) << " in driver" << std::endl;
 
+#if defined(FLECSI_TEST_NODE_GHOSTS)
+  ASSERT_TRUE(context_t::instance().node_ghosts());
+#endif
+
   auto ch = flecsi_get_client_handle(empty_mesh_t, meshes, mesh1);
 
   auto handle =
@@ -0,0 +1,182 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include <flecsi/execution/kernel.h>
+
+using namespace flecsi;
+using namespace flecsi::topology;
+
+struct object_id_t {
+  size_t id;
+
+  size_t index_space_index() const {
+    return id;
+  }
+
+  bool operator<(const object_id_t & oid) const {
+    return id < oid.id;
+  }
+};
+
+struct object_t {
+  using id_t = object_id_t;
+
+  object_id_t index_space_id() const {
+    return id;
+  }
+
+  object_id_t id;
+  double mass;
+};
+
+template<typename T>
+struct sum_t {
+  using LHS = T;
+  using RHS = T;
+  static constexpr T identity{};
+
+  static void apply(LHS & lhs, RHS rhs) {
+    lhs += rhs;
+  }
+
+  static void fold(LHS & lhs, RHS rhs) {
+    lhs += rhs;
+  }
+};
+
+template<typename T>
+struct min_t {
+  using LHS = T;
+  using RHS = T;
+  static constexpr T identity{std::numeric_limits<T>::max()};
+
+  static void apply(LHS & lhs, RHS rhs) {
+    lhs = rhs < lhs ? rhs : lhs;
+  }
+
+  static void fold(LHS & lhs, RHS rhs) {
+    lhs = rhs < lhs ? rhs : lhs;
+  }
+};
+
+// A field over the cells of a chain, in which face i joins the cells i and
+// i + 1.
+struct cell_field_t {
+  double & operator()(size_t i) {
+    return values[i];
+  }
+
+  size_t size() const {
+    return values.size();
+  }
+
+  std::vector<double> values;
+};
+
+TEST(kernel, parallel_for) {
+
+  constexpr size_t n = 100000;
+  std::vector<int> counts(n, 0);
+
+  using schedule_t = range_executor::schedule_t;
+
+  for(auto schedule : {schedule_t::blocked, schedule_t::chunked}) {
+    parallel_for(n, [&](size_t i) { ++counts[i]; }, "counts", schedule);
+  } // for
+
+  for(size_t i{0}; i < n; ++i) {
+    ASSERT_EQ(counts[i], 2);
+  } // for
+
+} // TEST
+
+TEST(kernel, index_space) {
+
+  constexpr size_t n = 10000;
+  std::vector<object_t *> objects;
+  index_space_u<object_t *, false, true, false> is;
+  is.set_storage(&objects);
+
+  for(size_t i{0}; i < n; ++i) {
+    objects.push_back(new object_t{{i}, 1.0});
+    is.push_back(object_id_t{i});
+  } // for
+
+  forall(o, is, "scale") {
+    o->mass *= 2.0;
+  };
+
+  double mass = reduce_all(o, m, is, sum_t<double>, "mass") {
+    m += o->mass;
+  };
+
+  ASSERT_EQ(mass, 2.0 * n);
+
+  // Nested kernels run serially on the executing thread.
+  std::atomic<size_t> visits(0);
+  parallel_for(size_t{64}, [&](size_t) {
+    parallel_for(size_t{64}, [&](size_t) { ++visits; });
+  });
+
+  ASSERT_EQ(visits, 64 * 64);
+
+  for(auto o : is) {
+    delete o;
+  } // for
+
+} // TEST
+
+TEST(kernel, scatter) {
+
+  constexpr size_t n = 10000;
+
+  auto faces = [](size_t f) { return std::vector<size_t>{f, f + 1}; };
+  scatter_schedule_t schedule(n, faces);
+
+  ASSERT_EQ(schedule.size(), n);
+  ASSERT_EQ(schedule.colors(), 2);
+
+  auto flux = [](size_t f) { return double(f % 7); };
+
+  auto body = [&](size_t f, auto & r) {
+    r(f) <<= flux(f);
+    r(f + 1) <<= flux(f);
+  };
+
+  std::vector<double> expected(n + 1, 1.0);
+  for(size_t f{0}; f < n; ++f) {
+    expected[f] += flux(f);
+    expected[f + 1] += flux(f);
+  } // for
+
+  cell_field_t privatized{std::vector<double>(n + 1, 1.0)};
+  parallel_scatter<sum_t<double>>(n, privatized, body, "privatized");
+  ASSERT_EQ(privatized.values, expected);
+
+  // A second scatter reuses the private copies of the first one.
+  cell_field_t reused{std::vector<double>(n + 1, 1.0)};
+  parallel_scatter<sum_t<double>>(n, reused, body, "privatized");
+  ASSERT_EQ(reused.values, expected);
+
+  cell_field_t colored{std::vector<double>(n + 1, 1.0)};
+  parallel_scatter<sum_t<double>>(n, schedule, colored, body, "colored");
+  ASSERT_EQ(colored.values, expected);
+
+  // The minimum of the fluxes of the adjacent faces.
+  cell_field_t minimum{
+    std::vector<double>(n + 1, std::numeric_limits<double>::max())};
+  parallel_scatter<min_t<double>>(n, schedule, minimum, body);
+
+  for(size_t c{1}; c < n; ++c) {
+    ASSERT_EQ(minimum.values[c], std::min(flux(c - 1), flux(c)));
+  } // for
+
+} // TEST
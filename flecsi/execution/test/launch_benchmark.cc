@@ -0,0 +1,346 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2018, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+
+///
+/// \file
+///
+/// Task launch and ghost exchange benchmarks. Results are written as one
+/// line of JSON per benchmark (see flecsi/utils/benchmark.h). The number of
+/// iterations may be set with FLECSI_BENCHMARK_ITERATIONS.
+///
+
+#include <cinchtest.h>
+
+#include <flecsi/data/dense_accessor.h>
+#include <flecsi/data/ragged_accessor.h>
+#include <flecsi/data/ragged_mutator.h>
+#include <flecsi/execution/execution.h>
+#include <flecsi/execution/reduction.h>
+#include <flecsi/supplemental/mesh/test_mesh_2d.h>
+#include <flecsi/utils/benchmark.h>
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Type definitions
+//----------------------------------------------------------------------------//
+
+using mesh_t = flecsi::supplemental::test_mesh_2d_t;
+
+template<size_t PS>
+using mesh = data_client_handle_u<mesh_t, PS>;
+
+template<size_t EP, size_t SP, size_t GP>
+using field = dense_accessor<double, EP, SP, GP>;
+
+using ro_field = field<ro, ro, ro>;
+using rw_field = field<rw, rw, ro>;
+
+//----------------------------------------------------------------------------//
+// Variable registration
+//----------------------------------------------------------------------------//
+
+flecsi_register_data_client(mesh_t, meshes, mesh1);
+
+flecsi_register_field(mesh_t, bench, f0, double, dense, 1, index_spaces::cells);
+flecsi_register_field(mesh_t, bench, f1, double, dense, 1, index_spaces::cells);
+flecsi_register_field(mesh_t, bench, f2, double, dense, 1, index_spaces::cells);
+flecsi_register_field(mesh_t, bench, f3, double, dense, 1, index_spaces::cells);
+flecsi_register_field(mesh_t, bench, f4, double, dense, 1, index_spaces::cells);
+flecsi_register_field(mesh_t, bench, f5, double, dense, 1, index_spaces::cells);
+flecsi_register_field(mesh_t, bench, f6, double, dense, 1, index_spaces::cells);
+flecsi_register_field(mesh_t, bench, f7, double, dense, 1, index_spaces::cells);
+
+flecsi_register_field(mesh_t, bench, r, double, ragged, 1, index_spaces::cells);
+
+//----------------------------------------------------------------------------//
+// Tasks. The task bodies are empty so that only the launch and the ghost
+// exchange of the handles are measured.
+//----------------------------------------------------------------------------//
+
+void
+empty_task() {} // empty_task
+
+flecsi_register_task(empty_task, flecsi::execution, loc, index);
+
+void
+dense_ro_1(ro_field) {} // dense_ro_1
+
+void
+dense_ro_2(ro_field, ro_field) {} // dense_ro_2
+
+void
+dense_ro_4(ro_field, ro_field, ro_field, ro_field) {} // dense_ro_4
+
+void
+dense_ro_8(ro_field,
+  ro_field,
+  ro_field,
+  ro_field,
+  ro_field,
+  ro_field,
+  ro_field,
+  ro_field) {} // dense_ro_8
+
+flecsi_register_task(dense_ro_1, flecsi::execution, loc, index);
+flecsi_register_task(dense_ro_2, flecsi::execution, loc, index);
+flecsi_register_task(dense_ro_4, flecsi::execution, loc, index);
+flecsi_register_task(dense_ro_8, flecsi::execution, loc, index);
+
+void
+dense_rw_1(rw_field) {} // dense_rw_1
+
+void
+dense_rw_2(rw_field, rw_field) {} // dense_rw_2
+
+void
+dense_rw_4(rw_field, rw_field, rw_field, rw_field) {} // dense_rw_4
+
+void
+dense_rw_8(rw_field,
+  rw_field,
+  rw_field,
+  rw_field,
+  rw_field,
+  rw_field,
+  rw_field,
+  rw_field) {} // dense_rw_8
+
+flecsi_register_task(dense_rw_1, flecsi::execution, loc, index);
+flecsi_register_task(dense_rw_2, flecsi::execution, loc, index);
+flecsi_register_task(dense_rw_4, flecsi::execution, loc, index);
+flecsi_register_task(dense_rw_8, flecsi::execution, loc, index);
+
+void
+ragged_init(mesh<ro> m, ragged_mutator<double> rm, size_t entries) {
+  for(auto c : m.cells(owned)) {
+    rm.resize(c, entries);
+    for(size_t j = 0; j < entries; ++j) {
+      rm(c, j) = double(j);
+    } // for
+  } // for
+} // ragged_init
+
+void
+ragged_rw(ragged_accessor<double, rw, rw, ro>) {} // ragged_rw
+
+flecsi_register_task(ragged_init, flecsi::execution, loc, index);
+flecsi_register_task(ragged_rw, flecsi::execution, loc, index);
+
+double
+reduce_task() {
+  return 1.0;
+} // reduce_task
+
+flecsi_register_task(reduce_task, flecsi::execution, loc, index);
+
+//----------------------------------------------------------------------------//
+// Top-Level Specialization Initialization
+//----------------------------------------------------------------------------//
+
+static constexpr size_t max_ragged_entries = 8;
+
+void
+specialization_tlt_init(int argc, char ** argv) {
+  supplemental::do_test_mesh_2d_coloring();
+
+  context_t::sparse_index_space_info_t isi;
+  isi.index_space = index_spaces::cells;
+  isi.max_entries_per_index = max_ragged_entries;
+  isi.exclusive_reserve = 8192;
+  context_t::instance().set_sparse_index_space_info(isi);
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// SPMD Specialization Initialization
+//----------------------------------------------------------------------------//
+
+void
+specialization_spmd_init(int argc, char ** argv) {
+  auto & context = context_t::instance();
+  auto mh = flecsi_get_client_handle(mesh_t, meshes, mesh1);
+
+  // The mesh can only be initialized once, so this is a single sample of
+  // the time to build the local mesh, including all of its connectivity.
+  const double s = utils::benchmark_seconds(1, [&]() {
+    flecsi_execute_task(initialize_mesh, flecsi::supplemental, index, mh)
+      .wait();
+  });
+
+  if(context.color() == 0) {
+    auto & info =
+      context.coloring_info(index_spaces::cells).at(context.color());
+    const double cells = info.exclusive + info.shared + info.ghost;
+
+    utils::benchmark_report("topology", "initialize_mesh",
+      {{"cells", cells}, {"seconds", s}, {"cells_per_s", cells / s}});
+  } // if
+} // specialization_spmd_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void
+driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+  const size_t iterations = utils::benchmark_iterations();
+  const bool report = context.color() == 0;
+  const double n = double(iterations);
+
+  const double ghosts =
+    context.coloring_info(index_spaces::cells).at(context.color()).ghost;
+
+  auto mh = flecsi_get_client_handle(mesh_t, meshes, mesh1);
+  auto h0 = flecsi_get_handle(mh, bench, f0, double, dense, 0);
+  auto h1 = flecsi_get_handle(mh, bench, f1, double, dense, 0);
+  auto h2 = flecsi_get_handle(mh, bench, f2, double, dense, 0);
+  auto h3 = flecsi_get_handle(mh, bench, f3, double, dense, 0);
+  auto h4 = flecsi_get_handle(mh, bench, f4, double, dense, 0);
+  auto h5 = flecsi_get_handle(mh, bench, f5, double, dense, 0);
+  auto h6 = flecsi_get_handle(mh, bench, f6, double, dense, 0);
+  auto h7 = flecsi_get_handle(mh, bench, f7, double, dense, 0);
+
+  // Each benchmark launches once before timing, so that one-time costs,
+  // e.g., the construction of communication plans, are not measured.
+  auto run = [&](auto && launch) {
+    launch();
+    return utils::benchmark_seconds(iterations, launch);
+  };
+
+  //--------------------------------------------------------------------------//
+  // Launch overhead versus handle count.
+  //--------------------------------------------------------------------------//
+
+  auto launch_report = [&](const char * name, size_t handles, double s) {
+    if(report) {
+      utils::benchmark_report("launch", name,
+        {{"handles", double(handles)}, {"iterations", n},
+          {"us_per_launch", 1.0e6 * s / n}});
+    } // if
+  };
+
+  launch_report("empty", 0, run([&]() {
+    flecsi_execute_task(empty_task, flecsi::execution, index).wait();
+  }));
+
+  launch_report("dense_ro", 1, run([&]() {
+    flecsi_execute_task(dense_ro_1, flecsi::execution, index, h0).wait();
+  }));
+
+  launch_report("dense_ro", 2, run([&]() {
+    flecsi_execute_task(dense_ro_2, flecsi::execution, index, h0, h1).wait();
+  }));
+
+  launch_report("dense_ro", 4, run([&]() {
+    flecsi_execute_task(
+      dense_ro_4, flecsi::execution, index, h0, h1, h2, h3)
+      .wait();
+  }));
+
+  launch_report("dense_ro", 8, run([&]() {
+    flecsi_execute_task(
+      dense_ro_8, flecsi::execution, index, h0, h1, h2, h3, h4, h5, h6, h7)
+      .wait();
+  }));
+
+  //--------------------------------------------------------------------------//
+  // Dense ghost exchange versus field count.
+  //--------------------------------------------------------------------------//
+
+  auto ghost_report = [&](const char * name, size_t fields, double s) {
+    if(report) {
+      const double bytes = ghosts * sizeof(double) * fields;
+      utils::benchmark_report("ghost", name,
+        {{"fields", double(fields)}, {"ghosts", ghosts}, {"iterations", n},
+          {"us_per_exchange", 1.0e6 * s / n},
+          {"mb_per_s", bytes * n / s / 1.0e6}});
+    } // if
+  };
+
+  ghost_report("dense", 1, run([&]() {
+    flecsi_execute_task(dense_rw_1, flecsi::execution, index, h0).wait();
+  }));
+
+  ghost_report("dense", 2, run([&]() {
+    flecsi_execute_task(dense_rw_2, flecsi::execution, index, h0, h1).wait();
+  }));
+
+  ghost_report("dense", 4, run([&]() {
+    flecsi_execute_task(
+      dense_rw_4, flecsi::execution, index, h0, h1, h2, h3)
+      .wait();
+  }));
+
+  ghost_report("dense", 8, run([&]() {
+    flecsi_execute_task(
+      dense_rw_8, flecsi::execution, index, h0, h1, h2, h3, h4, h5, h6, h7)
+      .wait();
+  }));
+
+  //--------------------------------------------------------------------------//
+  // Ragged ghost exchange versus entries per index.
+  //--------------------------------------------------------------------------//
+
+  auto rm =
+    flecsi_get_mutator(mh, bench, r, double, ragged, 0, max_ragged_entries);
+  auto rh = flecsi_get_handle(mh, bench, r, double, ragged, 0);
+
+  for(size_t entries : {1, 4, 8}) {
+    flecsi_execute_task(ragged_init, flecsi::execution, index, mh, rm, entries)
+      .wait();
+
+    const double s = run([&]() {
+      flecsi_execute_task(ragged_rw, flecsi::execution, index, rh).wait();
+    });
+
+    if(report) {
+      const double bytes = ghosts * sizeof(double) * entries;
+      utils::benchmark_report("ghost", "ragged",
+        {{"entries", double(entries)}, {"ghosts", ghosts}, {"iterations", n},
+          {"us_per_exchange", 1.0e6 * s / n},
+          {"mb_per_s", bytes * n / s / 1.0e6}});
+    } // if
+  } // for
+
+  //--------------------------------------------------------------------------//
+  // Reduction latency.
+  //--------------------------------------------------------------------------//
+
+  const double s = run([&]() {
+    flecsi_execute_reduction_task(
+      reduce_task, flecsi::execution, index, sum, double)
+      .get();
+  });
+
+  if(report) {
+    utils::benchmark_report("reduction", "sum_double",
+      {{"iterations", n}, {"us_per_reduction", 1.0e6 * s / n}});
+  } // if
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(launch_benchmark, testname) {} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
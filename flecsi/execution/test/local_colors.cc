@@ -0,0 +1,221 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include <cstdlib>
+
+#include <flecsi/data/dense_accessor.h>
+#include <flecsi/execution/execution.h>
+#include <flecsi/execution/reduction.h>
+#include <flecsi/supplemental/mesh/empty_mesh_2d.h>
+
+// The runtime reads the number of colors per rank when it is initialized,
+// after the static initialization of this unit.
+static const int colors_per_rank_env =
+  setenv("FLECSI_COLORS_PER_RANK", "2", 0);
+
+#define INDEX_ID 0
+#define VERSIONS 1
+
+// The number of cells of each color.
+#define CELLS 8
+
+clog_register_tag(local_colors);
+
+namespace flecsi {
+namespace execution {
+
+using mesh_t = flecsi::supplemental::empty_mesh_t;
+
+template<size_t EP, size_t SP, size_t GP>
+using field = dense_accessor<double, EP, SP, GP>;
+
+flecsi_register_data_client(mesh_t, meshes, mesh1);
+
+flecsi_register_field(mesh_t,
+  name_space,
+  values,
+  double,
+  dense,
+  VERSIONS,
+  INDEX_ID);
+
+//----------------------------------------------------------------------------//
+// The cells of the colors form a ring. Color c owns the cells
+// [c * CELLS, (c + 1) * CELLS). Its first cell is a ghost of the previous
+// color, and its last cell a ghost of the next one.
+//----------------------------------------------------------------------------//
+
+coloring::index_coloring_t
+ring_coloring(size_t color, size_t colors) {
+  const size_t prev = (color + colors - 1) % colors;
+  const size_t next = (color + 1) % colors;
+  const size_t first = color * CELLS;
+
+  coloring::index_coloring_t coloring;
+
+  for(size_t i{1}; i < CELLS - 1; ++i) {
+    coloring.exclusive.insert(coloring::entity_info_t(first + i, color, i - 1));
+  } // for
+
+  // The offsets of shared and ghost cells are their positions in the
+  // shared region of their owner.
+  coloring.shared.insert(coloring::entity_info_t(first, color, 0, prev));
+  coloring.shared.insert(
+    coloring::entity_info_t(first + CELLS - 1, color, 1, next));
+
+  coloring.ghost.insert(
+    coloring::entity_info_t(prev * CELLS + CELLS - 1, prev, 1));
+  coloring.ghost.insert(coloring::entity_info_t(next * CELLS, next, 0));
+
+  return coloring;
+} // ring_coloring
+
+double
+cell_value(size_t id, size_t cycle) {
+  return double(id) + 0.5 * cycle;
+} // cell_value
+
+//----------------------------------------------------------------------------//
+// Tasks
+//----------------------------------------------------------------------------//
+
+void
+init_task(field<rw, rw, na> v, size_t cycle) {
+  auto & context_ = context_t::instance();
+  auto & coloring = context_.local_coloring(INDEX_ID, context_.color());
+
+  ASSERT_EQ(v.exclusive_size(), coloring.exclusive.size());
+  ASSERT_EQ(v.shared_size(), coloring.shared.size());
+
+  size_t index{0};
+  for(auto & e : coloring.exclusive) {
+    v.exclusive(index++) = cell_value(e.id, cycle);
+  } // for
+
+  index = 0;
+  for(auto & s : coloring.shared) {
+    v.shared(index++) = cell_value(s.id, cycle);
+  } // for
+} // init_task
+
+flecsi_register_task(init_task, flecsi::execution, loc, index);
+
+void
+check_task(field<ro, ro, ro> v, size_t cycle) {
+  auto & context_ = context_t::instance();
+  const size_t color = context_.color();
+  auto & coloring = context_.local_coloring(INDEX_ID, color);
+
+  ASSERT_TRUE(context_.is_local_color(color));
+
+  size_t index{0};
+  for(auto & e : coloring.exclusive) {
+    ASSERT_EQ(v.exclusive(index++), cell_value(e.id, cycle));
+  } // for
+
+  index = 0;
+  for(auto & s : coloring.shared) {
+    ASSERT_EQ(v.shared(index++), cell_value(s.id, cycle));
+  } // for
+
+  // The ghosts hold the values written by the neighboring colors, which
+  // are on this rank or on another one.
+  ASSERT_EQ(v.ghost_size(), 2);
+
+  index = 0;
+  for(auto & g : coloring.ghost) {
+    ASSERT_EQ(v.ghost(index++), cell_value(g.id, cycle));
+  } // for
+} // check_task
+
+flecsi_register_task(check_task, flecsi::execution, loc, index);
+
+double
+owned_task(field<ro, ro, ro> v) {
+  double sum{0.0};
+
+  for(size_t i{0}; i < v.exclusive_size(); ++i) {
+    sum += v.exclusive(i);
+  } // for
+
+  for(size_t i{0}; i < v.shared_size(); ++i) {
+    sum += v.shared(i);
+  } // for
+
+  return sum;
+} // owned_task
+
+flecsi_register_task(owned_task, flecsi::execution, loc, index);
+
+//----------------------------------------------------------------------------//
+// Top-Level Specialization Initialization
+//----------------------------------------------------------------------------//
+
+void
+specialization_tlt_init(int argc, char ** argv) {
+  auto & context_ = context_t::instance();
+
+  const size_t colors = context_.colors();
+  const size_t first = context_.color();
+
+  ASSERT_EQ(context_.colors_per_rank(), 2);
+
+  std::unordered_map<size_t, coloring::coloring_info_t> coloring_info;
+
+  for(size_t c{0}; c < colors; ++c) {
+    auto & info = coloring_info[c];
+    info.exclusive = CELLS - 2;
+    info.shared = 2;
+    info.ghost = 2;
+    info.shared_users = {(c + colors - 1) % colors, (c + 1) % colors};
+    info.ghost_owners = info.shared_users;
+  } // for
+
+  for(size_t local{0}; local < context_.colors_per_rank(); ++local) {
+    context_.add_local_coloring(
+      INDEX_ID, first + local, ring_coloring(first + local, colors));
+  } // for
+
+  auto coloring = ring_coloring(first, colors);
+  context_.add_coloring(INDEX_ID, coloring, coloring_info);
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void
+driver(int argc, char ** argv) {
+  auto & context_ = context_t::instance();
+
+  auto ch = flecsi_get_client_handle(mesh_t, meshes, mesh1);
+  auto vh = flecsi_get_handle(ch, name_space, values, double, dense, INDEX_ID);
+
+  for(size_t cycle{0}; cycle < 3; ++cycle) {
+    flecsi_execute_task(init_task, flecsi::execution, index, vh, cycle);
+    flecsi_execute_task(check_task, flecsi::execution, index, vh, cycle);
+  } // for
+
+  // Each color contributes the values of its own cells, which hold their
+  // id plus one after the last cycle.
+  auto f = flecsi_execute_reduction_task(
+    owned_task, flecsi::execution, index, sum, double, vh);
+
+  const size_t cells = context_.colors() * CELLS;
+  ASSERT_EQ(f.get(), double(cells * (cells - 1) / 2 + cells));
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(local_colors, testname) {} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,148 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <limits>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <flecsi/execution/common/mpi_reduction.h>
+#include <flecsi/execution/reduction.h>
+
+using namespace flecsi::execution;
+
+template<typename T>
+using hydro = reduction::composite<reduction::min<T>,
+  reduction::max<T>,
+  reduction::sum<T>>;
+
+TEST(mpi_reduction, identity) {
+  ASSERT_EQ(reduction::min<double>::identity,
+    std::numeric_limits<double>::max());
+  ASSERT_EQ(reduction::max<double>::identity,
+    std::numeric_limits<double>::lowest());
+  ASSERT_EQ(reduction::max<int>::identity, std::numeric_limits<int>::min());
+  ASSERT_EQ(reduction::sum<double>::identity, 0.0);
+  ASSERT_EQ(reduction::product<double>::identity, 1.0);
+
+  using sum3_t = reduction::sum<std::array<double, 3>>;
+  ASSERT_EQ(sum3_t::identity, (std::array<double, 3>{{0.0, 0.0, 0.0}}));
+
+  ASSERT_EQ(hydro<double>::identity,
+    (std::array<double, 3>{{std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::lowest(), 0.0}}));
+} // TEST
+
+TEST(mpi_reduction, apply) {
+  std::array<double, 3> a{{1.0, 2.0, 3.0}};
+  reduction::max<std::array<double, 3>>::apply(a, {{3.0, 1.0, 4.0}});
+  ASSERT_EQ(a, (std::array<double, 3>{{3.0, 2.0, 4.0}}));
+
+  std::array<double, 3> h{{0.5, 2.0, 3.0}};
+  hydro<double>::apply(h, {{0.25, 1.0, 4.0}});
+  ASSERT_EQ(h, (std::array<double, 3>{{0.25, 2.0, 7.0}}));
+} // TEST
+
+TEST(mpi_reduction, non_exclusive) {
+  // Adjacent 4-byte values must not be modified by each other's updates.
+  std::array<float, 2> sums{{0.0f, 0.0f}};
+  std::array<int, 2> maxima{{0, 0}};
+
+  std::vector<std::thread> threads;
+
+  for(int t{0}; t < 4; ++t) {
+    threads.emplace_back([&, t]() {
+      for(int i{0}; i < 1000; ++i) {
+        reduction::sum<float>::apply<false>(sums[0], 1.0f);
+        reduction::max<int>::fold<false>(maxima[0], 1000 * t + i);
+      } // for
+    });
+  } // for
+
+  for(auto & t : threads) {
+    t.join();
+  } // for
+
+  ASSERT_EQ(sums[0], 4000.0f);
+  ASSERT_EQ(sums[1], 0.0f);
+  ASSERT_EQ(maxima[0], 3999);
+  ASSERT_EQ(maxima[1], 0);
+} // TEST
+
+TEST(mpi_reduction, traits) {
+  static_assert(mpi_reduction_op_u<reduction::min<double>>::native);
+  static_assert(mpi_reduction_op_u<reduction::sum<int>>::native);
+  static_assert(
+    mpi_reduction_op_u<reduction::product<std::array<float, 4>>>::native);
+  static_assert(!mpi_reduction_op_u<hydro<double>>::native);
+
+  static_assert(mpi_reduction_value_u<double>::count == 1);
+  static_assert(mpi_reduction_value_u<std::array<double, 3>>::count == 3);
+  static_assert(mpi_reduction_value_u<hydro<double>::LHS>::count == 3);
+
+  ASSERT_EQ(mpi_reduction_op_u<reduction::min<double>>::op(), MPI_MIN);
+  ASSERT_EQ(mpi_reduction_op_u<reduction::max<double>>::op(), MPI_MAX);
+  ASSERT_EQ(mpi_reduction_op_u<reduction::sum<double>>::op(), MPI_SUM);
+  ASSERT_EQ(mpi_reduction_op_u<reduction::product<double>>::op(), MPI_PROD);
+} // TEST
+
+TEST(mpi_reduction, allreduce) {
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // A vector reduction with a predefined operation.
+  using max3_t = reduction::max<std::array<double, 3>>;
+  MPI_Op max_op = mpi_reduction_op_u<max3_t>::op();
+  std::map<size_t, MPI_Datatype> types;
+  auto [element, elements] =
+    mpi_reduction_datatype<std::array<double, 3>>(max_op, types);
+
+  ASSERT_EQ(element, MPI_DOUBLE);
+  ASSERT_EQ(elements, 3);
+
+  std::array<double, 3> value{{double(rank), -double(rank), 1.0}}, result;
+  MPI_Allreduce(&value, &result, elements, element, max_op, MPI_COMM_WORLD);
+
+  ASSERT_EQ(result, (std::array<double, 3>{{size - 1.0, 0.0, 1.0}}));
+
+  // A composite reduction with a user-defined operation, passed as whole
+  // values of a contiguous datatype.
+  MPI_Op op;
+  MPI_Op_create(mpi_reduction_wrapper<hydro<double>>, true, &op);
+
+  auto [datatype, count] =
+    mpi_reduction_datatype<hydro<double>::LHS>(op, types);
+
+  int bytes;
+  MPI_Type_size(datatype, &bytes);
+  ASSERT_EQ(count, 1);
+  ASSERT_EQ(size_t(bytes), sizeof(hydro<double>::LHS));
+
+  std::array<double, 3> h{{1.0 + rank, 1.0 + rank, 1.0}};
+  MPI_Allreduce(&h, &result, count, datatype, op, MPI_COMM_WORLD);
+
+  ASSERT_EQ(result, (std::array<double, 3>{{1.0, double(size), double(size)}}));
+
+  // Several values reduced in one call.
+  std::array<std::array<double, 3>, 2> hh{{h, {{-1.0 * rank, 0.0, 2.0}}}};
+  std::array<std::array<double, 3>, 2> hresult;
+  MPI_Allreduce(&hh, &hresult, 2, datatype, op, MPI_COMM_WORLD);
+
+  ASSERT_EQ(hresult[0], result);
+  ASSERT_EQ(hresult[1],
+    (std::array<double, 3>{{1.0 - size, 0.0, 2.0 * size}}));
+
+  MPI_Op_free(&op);
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
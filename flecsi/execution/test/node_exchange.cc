@@ -0,0 +1,75 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <vector>
+
+#include <flecsi/execution/mpi/node_exchange.h>
+
+using namespace flecsi::execution;
+
+TEST(node_exchange, add) {
+  node_exchange_t node;
+
+  // Runs that continue each other in the ghosts and in the owner's shared
+  // region are merged.
+  node.add(0, 1, 8, 8);
+  node.add(8, 1, 16, 8);
+  node.add(16, 1, 40, 8);
+  node.add(24, 2, 48, 8);
+
+  ASSERT_EQ(node.copies().size(), 3);
+  ASSERT_EQ(node.copies()[0].bytes, 16);
+  ASSERT_EQ(node.copies()[1].offset, 40);
+  ASSERT_EQ(node.copies()[2].rank, 2);
+  ASSERT_EQ(node.bytes(), 32);
+  ASSERT_FALSE(node.active());
+} // TEST
+
+TEST(node_exchange, exchange) {
+  MPI_Comm comm;
+  MPI_Comm_split_type(
+    MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &comm);
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  // Each rank shares 4 values and reads the shared values of the next rank
+  // in reverse order.
+  const size_t nshared = 4;
+  const int next = (rank + 1) % size;
+
+  node_exchange_t node;
+  node.create(comm, nshared * sizeof(double));
+  ASSERT_TRUE(node.active());
+
+  for(size_t i = 0; i < nshared; ++i) {
+    node.add(i * sizeof(double), next, (nshared - 1 - i) * sizeof(double),
+      sizeof(double));
+  } // for
+
+  std::vector<double> shared(nshared), ghosts(nshared);
+
+  // Successive exchanges alternate between the buffers of the segments.
+  for(int step = 0; step < 3; ++step) {
+    for(size_t i = 0; i < nshared; ++i) {
+      shared[i] = 100.0 * step + 10.0 * rank + i;
+    } // for
+
+    node.exchange(shared.data(), ghosts.data());
+
+    for(size_t i = 0; i < nshared; ++i) {
+      ASSERT_EQ(ghosts[i], 100.0 * step + 10.0 * next + (nshared - 1 - i));
+    } // for
+  } // for
+
+  node.release();
+  ASSERT_FALSE(node.active());
+
+  MPI_Comm_free(&comm);
+} // TEST
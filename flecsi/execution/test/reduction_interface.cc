@@ -4,6 +4,7 @@
  *----------------------------------------------------------------------------*/
 
 #include <cinchdevel.h>
+#include <cinchtest.h>
 
 #include <flecsi/execution/context.h>
 #include <flecsi/execution/execution.h>
@@ -68,6 +69,15 @@ double_task(mesh<ro> m, field<rw, rw, ro> v) {
 
 flecsi_register_task(double_task, flecsi::execution, loc, index);
 
+// The same task on the MPI processor, whose result is reduced on the
+// MPI side under the Legion runtime.
+double
+double_mpi_task(mesh<ro> m, field<rw, rw, ro> v) {
+  return double_task(m, v);
+} // double_mpi_task
+
+flecsi_register_task(double_mpi_task, flecsi::execution, mpi, index);
+
 //----------------------------------------------------------------------------//
 // Top-Level Specialization Initialization
 //----------------------------------------------------------------------------//
@@ -130,6 +140,9 @@ driver(int argc, char ** argv) {
       double_task, flecsi::execution, index, sum, double, mh, vh);
 
     clog(info) << "reduction sum: " << f.get() << std::endl;
+
+    // Every cell of the 16x16 mesh holds 1.
+    CINCH_ASSERT(EQ, f.get(), 256.0);
   } // scope
 
   {
@@ -138,6 +151,15 @@ driver(int argc, char ** argv) {
 
     clog(info) << "reduction product: " << f.get() << std::endl;
   } // scope
+
+  {
+    auto f = flecsi_execute_reduction_task(
+      double_mpi_task, flecsi::execution, index, sum, double, mh, vh);
+
+    clog(info) << "mpi task reduction sum: " << f.get() << std::endl;
+
+    CINCH_ASSERT(EQ, f.get(), 256.0);
+  } // scope
 } // driver
 
 } // namespace execution
@@ -0,0 +1,321 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include <flecsi/data/dense_accessor.h>
+#include <flecsi/data/sparse_accessor.h>
+#include <flecsi/data/sparse_mutator.h>
+#include <flecsi/execution/execution.h>
+#include <flecsi/execution/mpi/repartition.h>
+#include <flecsi/execution/reduction.h>
+#include <flecsi/supplemental/mesh/empty_mesh_2d.h>
+
+#define INDEX_ID 0
+#define VERSIONS 1
+
+// The number of cells of each color before the repartition.
+#define CELLS 8
+
+// The number of cells that each color passes to the previous one.
+#define SHIFT 3
+
+clog_register_tag(repartition);
+
+namespace flecsi {
+namespace execution {
+
+using mesh_t = flecsi::supplemental::empty_mesh_t;
+
+template<size_t EP, size_t SP, size_t GP>
+using field = dense_accessor<double, EP, SP, GP>;
+
+template<size_t EP, size_t SP, size_t GP>
+using entries = sparse_accessor<double, EP, SP, GP>;
+
+flecsi_register_data_client(mesh_t, meshes, mesh1);
+
+flecsi_register_field(mesh_t,
+  name_space,
+  values,
+  double,
+  dense,
+  VERSIONS,
+  INDEX_ID);
+
+flecsi_register_field(mesh_t,
+  name_space,
+  pairs,
+  double,
+  sparse,
+  VERSIONS,
+  INDEX_ID);
+
+//----------------------------------------------------------------------------//
+// The cells form a line, of which color c owns [bounds[c], bounds[c + 1]).
+// The first and last cells of a color are shared with its neighbors, and
+// their neighboring cells are its ghosts.
+//----------------------------------------------------------------------------//
+
+std::vector<size_t>
+initial_bounds(size_t colors) {
+  std::vector<size_t> bounds;
+
+  for(size_t c{0}; c <= colors; ++c) {
+    bounds.push_back(c * CELLS);
+  } // for
+
+  return bounds;
+} // initial_bounds
+
+std::vector<size_t>
+shifted_bounds(size_t colors) {
+  auto bounds = initial_bounds(colors);
+
+  for(size_t c{1}; c < colors; ++c) {
+    bounds[c] += SHIFT;
+  } // for
+
+  return bounds;
+} // shifted_bounds
+
+coloring::index_coloring_t
+line_coloring(const std::vector<size_t> & bounds, size_t color) {
+  const size_t colors = bounds.size() - 1;
+  const size_t first = bounds[color];
+  const size_t last = bounds[color + 1] - 1;
+
+  coloring::index_coloring_t coloring;
+
+  for(size_t id{first}; id <= last; ++id) {
+    std::vector<size_t> users;
+
+    if(id == first && color > 0) {
+      users.push_back(color - 1);
+    } // if
+
+    if(id == last && color < colors - 1) {
+      users.push_back(color + 1);
+    } // if
+
+    if(users.empty()) {
+      coloring.exclusive.insert(coloring::entity_info_t(id, color, 0));
+    }
+    else {
+      coloring.shared.insert(coloring::entity_info_t(id, color, 0, users));
+    } // if
+  } // for
+
+  if(color > 0) {
+    coloring.ghost.insert(coloring::entity_info_t(first - 1, color - 1, 0));
+  } // if
+
+  if(color < colors - 1) {
+    coloring.ghost.insert(coloring::entity_info_t(last + 1, color + 1, 0));
+  } // if
+
+  return coloring;
+} // line_coloring
+
+std::unordered_map<size_t, coloring::coloring_info_t>
+line_coloring_info(const std::vector<size_t> & bounds) {
+  const size_t colors = bounds.size() - 1;
+  std::unordered_map<size_t, coloring::coloring_info_t> coloring_info;
+
+  for(size_t c{0}; c < colors; ++c) {
+    auto coloring = line_coloring(bounds, c);
+    auto & info = coloring_info[c];
+
+    info.exclusive = coloring.exclusive.size();
+    info.shared = coloring.shared.size();
+    info.ghost = coloring.ghost.size();
+
+    for(auto & s : coloring.shared) {
+      info.shared_users.insert(s.shared.begin(), s.shared.end());
+    } // for
+
+    for(auto & g : coloring.ghost) {
+      info.ghost_owners.insert(g.rank);
+    } // for
+  } // for
+
+  return coloring_info;
+} // line_coloring_info
+
+double
+cell_value(size_t id, size_t cycle) {
+  return double(id) + 0.5 * cycle;
+} // cell_value
+
+// Each cell has the entries id % 3 and id % 3 + 3.
+size_t
+cell_entry(size_t id, size_t j) {
+  return id % 3 + 3 * j;
+} // cell_entry
+
+//----------------------------------------------------------------------------//
+// Tasks
+//----------------------------------------------------------------------------//
+
+void
+init_task(field<rw, rw, na> v, sparse_mutator<double> m, size_t cycle) {
+  auto & index_map = context_t::instance().index_map(INDEX_ID);
+
+  const size_t exclusive = v.exclusive_size();
+
+  for(size_t i{0}; i < exclusive + v.shared_size(); ++i) {
+    const size_t id = index_map.at(i);
+
+    if(i < exclusive) {
+      v.exclusive(i) = cell_value(id, cycle);
+    }
+    else {
+      v.shared(i - exclusive) = cell_value(id, cycle);
+    } // if
+
+    for(size_t j{0}; j < 2; ++j) {
+      m(i, cell_entry(id, j)) = -cell_value(id, cycle + j);
+    } // for
+  } // for
+} // init_task
+
+flecsi_register_task(init_task, flecsi::execution, loc, index);
+
+void
+check_task(field<ro, ro, ro> v, entries<ro, ro, ro> e, size_t cycle) {
+  auto & context_ = context_t::instance();
+  auto & index_map = context_.index_map(INDEX_ID);
+  auto & coloring = context_.coloring(INDEX_ID);
+
+  const size_t exclusive = v.exclusive_size();
+  const size_t shared = v.shared_size();
+
+  ASSERT_EQ(exclusive, coloring.exclusive.size());
+  ASSERT_EQ(shared, coloring.shared.size());
+  ASSERT_EQ(v.ghost_size(), coloring.ghost.size());
+
+  for(size_t i{0}; i < exclusive + shared + v.ghost_size(); ++i) {
+    const size_t id = index_map.at(i);
+
+    if(i < exclusive) {
+      ASSERT_EQ(v.exclusive(i), cell_value(id, cycle));
+    }
+    else if(i < exclusive + shared) {
+      ASSERT_EQ(v.shared(i - exclusive), cell_value(id, cycle));
+    }
+    else {
+      ASSERT_EQ(v.ghost(i - exclusive - shared), cell_value(id, cycle));
+    } // if
+
+    ASSERT_EQ(e.entries(i).size(), 2);
+
+    for(size_t j{0}; j < 2; ++j) {
+      ASSERT_EQ(e(i, cell_entry(id, j)), -cell_value(id, cycle + j));
+    } // for
+  } // for
+} // check_task
+
+flecsi_register_task(check_task, flecsi::execution, loc, index);
+
+double
+owned_task(field<ro, ro, ro> v) {
+  double sum{0.0};
+
+  for(size_t i{0}; i < v.exclusive_size(); ++i) {
+    sum += v.exclusive(i);
+  } // for
+
+  for(size_t i{0}; i < v.shared_size(); ++i) {
+    sum += v.shared(i);
+  } // for
+
+  return sum;
+} // owned_task
+
+flecsi_register_task(owned_task, flecsi::execution, loc, index);
+
+//----------------------------------------------------------------------------//
+// Top-Level Specialization Initialization
+//----------------------------------------------------------------------------//
+
+void
+specialization_tlt_init(int argc, char ** argv) {
+  auto & context_ = context_t::instance();
+
+  auto bounds = initial_bounds(context_.colors());
+  auto coloring = line_coloring(bounds, context_.color());
+  auto coloring_info = line_coloring_info(bounds);
+
+  context_.add_coloring(INDEX_ID, coloring, coloring_info);
+
+  context_t::sparse_index_space_info_t isi;
+  isi.index_space = INDEX_ID;
+  isi.max_entries_per_index = 4;
+  isi.exclusive_reserve = 2 * CELLS * 4;
+  context_.set_sparse_index_space_info(isi);
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void
+driver(int argc, char ** argv) {
+  auto & context_ = context_t::instance();
+  const size_t colors = context_.colors();
+
+  auto ch = flecsi_get_client_handle(mesh_t, meshes, mesh1);
+
+  {
+    auto vh =
+      flecsi_get_handle(ch, name_space, values, double, dense, INDEX_ID);
+    auto mh = flecsi_get_mutator(ch, name_space, pairs, double, sparse, 0, 2);
+    auto eh = flecsi_get_handle(ch, name_space, pairs, double, sparse, 0);
+
+    flecsi_execute_task(init_task, flecsi::execution, index, vh, mh, 0);
+    flecsi_execute_task(check_task, flecsi::execution, index, vh, eh, 0);
+  }
+
+  // Every color but the first passes its first cells to the previous one.
+  auto bounds = shifted_bounds(colors);
+
+  repartition(INDEX_ID, line_coloring(bounds, context_.color()),
+    line_coloring_info(bounds));
+
+  ASSERT_EQ(context_.coloring(INDEX_ID).exclusive.size() +
+              context_.coloring(INDEX_ID).shared.size(),
+    bounds[context_.color() + 1] - bounds[context_.color()]);
+
+  // The handles of the old coloring can not be used after the repartition.
+  auto vh = flecsi_get_handle(ch, name_space, values, double, dense, INDEX_ID);
+  auto mh = flecsi_get_mutator(ch, name_space, pairs, double, sparse, 0, 2);
+  auto eh = flecsi_get_handle(ch, name_space, pairs, double, sparse, 0);
+
+  // The migration fills the ghosts of the new coloring.
+  flecsi_execute_task(check_task, flecsi::execution, index, vh, eh, 0);
+
+  // The ghost copies are rebuilt for the new coloring.
+  for(size_t cycle{1}; cycle < 3; ++cycle) {
+    flecsi_execute_task(init_task, flecsi::execution, index, vh, mh, cycle);
+    flecsi_execute_task(check_task, flecsi::execution, index, vh, eh, cycle);
+  } // for
+
+  auto f = flecsi_execute_reduction_task(
+    owned_task, flecsi::execution, index, sum, double, vh);
+
+  const size_t cells = colors * CELLS;
+  ASSERT_EQ(f.get(), double(cells * (cells - 1) / 2 + cells));
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(repartition, testname) {} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
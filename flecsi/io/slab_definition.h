@@ -0,0 +1,480 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <flecsi-config.h>
+
+#if !defined(FLECSI_ENABLE_MPI)
+#error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cinchlog.h>
+
+#include <flecsi/coloring/crs.h>
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/topology/parallel_mesh_definition.h>
+#include <flecsi/utils/mpi_comm.h>
+#include <flecsi/utils/mpi_type_traits.h>
+
+namespace flecsi {
+namespace io {
+
+//----------------------------------------------------------------------------//
+//! The slab_definition_u type is a parallel mesh definition that reads
+//! a binary mesh file with MPI-IO. Each rank reads only a contiguous slab
+//! of cells, the cell-to-vertex connectivity of that slab, and the
+//! coordinates of the vertices it references, so that the memory and time
+//! used per rank are proportional to the size of the slab rather than the
+//! size of the global mesh. The result can be passed directly to
+//! coloring::make_dcrs_distributed and coloring::migrate.
+//!
+//! The file layout is, with all integers stored as 64-bit unsigned values
+//! and coordinates as doubles in native byte order:
+//!
+//! @code
+//!   dimension num_vertices num_cells
+//!   offsets[num_cells + 1]
+//!   indices[offsets[num_cells]]
+//!   coordinates[num_vertices * dimension]
+//! @endcode
+//!
+//! @tparam DIMENSION The mesh dimension.
+//!
+//! @ingroup io
+//----------------------------------------------------------------------------//
+
+template<size_t DIMENSION>
+class slab_definition_u
+  : public topology::parallel_mesh_definition_u<DIMENSION>
+{
+public:
+  using base_t = topology::parallel_mesh_definition_u<DIMENSION>;
+  using byte_t = typename base_t::byte_t;
+  using real_t = typename base_t::real_t;
+  using file_size_t = std::uint64_t;
+
+  /*!
+    Read this rank's slab of the mesh in \em filename. This is collective
+    over the communicator of the runtime.
+   */
+
+  slab_definition_u(const std::string & filename) {
+    int size, rank;
+    MPI_Comm_size(utils::mpi_comm(), &size);
+    MPI_Comm_rank(utils::mpi_comm(), &rank);
+
+    MPI_File fh;
+    int ret = MPI_File_open(utils::mpi_comm(), filename.c_str(),
+      MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+
+    clog_assert(ret == MPI_SUCCESS, "failed opening " << filename);
+
+    //------------------------------------------------------------------------//
+    // Header.
+    //------------------------------------------------------------------------//
+
+    file_size_t header[3];
+    read_at(fh, 0, header, 3);
+
+    clog_assert(header[0] == DIMENSION,
+      "mesh dimension " << header[0] << " does not match " << DIMENSION);
+
+    const file_size_t num_cells = header[2];
+
+    //------------------------------------------------------------------------//
+    // Cell slab.
+    //------------------------------------------------------------------------//
+
+    std::vector<size_t> distribution;
+    coloring::subdivide(num_cells, size, distribution);
+
+    const size_t cells_start = distribution[rank];
+    const size_t cells_end = distribution[rank + 1];
+    const size_t num_local = cells_end - cells_start;
+
+    const MPI_Offset offsets_start = sizeof(header);
+    const MPI_Offset indices_start =
+      offsets_start + (num_cells + 1) * sizeof(file_size_t);
+
+    std::vector<file_size_t> offsets(num_local + 1);
+    read_at(fh, offsets_start + cells_start * sizeof(file_size_t),
+      offsets.data(), offsets.size());
+
+    std::vector<file_size_t> indices(offsets.back() - offsets.front());
+    read_at(fh, indices_start + offsets.front() * sizeof(file_size_t),
+      indices.data(), indices.size());
+
+    // The coordinates follow the indices of the last cell.
+    file_size_t num_indices;
+    read_at(fh, offsets_start + num_cells * sizeof(file_size_t), &num_indices,
+      1);
+
+    const MPI_Offset coordinates_start =
+      indices_start + num_indices * sizeof(file_size_t);
+
+    //------------------------------------------------------------------------//
+    // Local vertex numbering.
+    //------------------------------------------------------------------------//
+
+    vertex_local_to_global_.assign(indices.begin(), indices.end());
+    std::sort(vertex_local_to_global_.begin(), vertex_local_to_global_.end());
+    vertex_local_to_global_.erase(std::unique(vertex_local_to_global_.begin(),
+                                    vertex_local_to_global_.end()),
+      vertex_local_to_global_.end());
+
+    for(size_t v(0); v < vertex_local_to_global_.size(); ++v) {
+      vertex_global_to_local_.emplace(vertex_local_to_global_[v], v);
+    } // for
+
+    cells2vertices_.offsets.reserve(num_local + 1);
+    cells2vertices_.indices.reserve(indices.size());
+    cells2vertices_.offsets.push_back(0);
+
+    for(size_t c(0); c < num_local; ++c) {
+      for(auto i = offsets[c]; i < offsets[c + 1]; ++i) {
+        cells2vertices_.indices.push_back(
+          vertex_global_to_local_.at(indices[i - offsets.front()]));
+      } // for
+
+      cells2vertices_.offsets.push_back(cells2vertices_.indices.size());
+
+      cell_local_to_global_.push_back(cells_start + c);
+      cell_global_to_local_.emplace(cells_start + c, c);
+    } // for
+
+    //------------------------------------------------------------------------//
+    // Vertex coordinates. A file view selects only the referenced vertices,
+    // which are sorted, so the read is a single collective operation.
+    //------------------------------------------------------------------------//
+
+    std::vector<MPI_Aint> displacements;
+    displacements.reserve(vertex_local_to_global_.size());
+
+    for(auto v : vertex_local_to_global_) {
+      displacements.push_back(v * DIMENSION * sizeof(real_t));
+    } // for
+
+    MPI_Datatype filetype;
+    MPI_Type_create_hindexed_block(displacements.size(), DIMENSION,
+      displacements.data(), MPI_DOUBLE, &filetype);
+    MPI_Type_commit(&filetype);
+
+    coordinates_.resize(vertex_local_to_global_.size() * DIMENSION);
+
+    MPI_File_set_view(
+      fh, coordinates_start, MPI_DOUBLE, filetype, "native", MPI_INFO_NULL);
+    MPI_File_read_all(fh, coordinates_.data(), coordinates_.size(), MPI_DOUBLE,
+      MPI_STATUS_IGNORE);
+
+    MPI_Type_free(&filetype);
+    MPI_File_close(&fh);
+  } // slab_definition_u
+
+  /// Copy constructor (disabled)
+  slab_definition_u(const slab_definition_u &) = delete;
+
+  /// Assignment operator (disabled)
+  slab_definition_u & operator=(const slab_definition_u &) = delete;
+
+  /*!
+    Write the mesh defined by \em md in the format read by this type.
+    This is a serial operation that is intended for converting meshes.
+    The definition type must provide a vertex(id) method that returns
+    the coordinates of a vertex.
+   */
+
+  template<typename MESH_DEFINITION>
+  static void write(const std::string & filename,
+    const MESH_DEFINITION & md) {
+    std::ofstream file(filename, std::ios::binary);
+
+    clog_assert(file.good(), "failed opening " << filename);
+
+    auto put = [&file](const auto * data, size_t count) {
+      file.write(reinterpret_cast<const char *>(data), count * sizeof(*data));
+    };
+
+    const file_size_t num_vertices = md.num_entities(0);
+    const file_size_t num_cells = md.num_entities(DIMENSION);
+    const file_size_t header[3] = {DIMENSION, num_vertices, num_cells};
+    put(header, 3);
+
+    std::vector<file_size_t> offsets{0};
+    std::vector<file_size_t> indices;
+
+    for(size_t c(0); c < num_cells; ++c) {
+      for(auto v : md.entities(DIMENSION, 0, c)) {
+        indices.push_back(v);
+      } // for
+
+      offsets.push_back(indices.size());
+    } // for
+
+    put(offsets.data(), offsets.size());
+    put(indices.data(), indices.size());
+
+    for(size_t v(0); v < num_vertices; ++v) {
+      auto point = md.vertex(v);
+      real_t coord[DIMENSION];
+
+      for(size_t d(0); d < DIMENSION; ++d) {
+        coord[d] = point[d];
+      } // for
+
+      put(coord, DIMENSION);
+    } // for
+  } // write
+
+  //--------------------------------------------------------------------------//
+  // mesh_definition_u interface.
+  //--------------------------------------------------------------------------//
+
+  size_t num_entities(size_t dimension) const override {
+    if(dimension == DIMENSION) {
+      return cell_local_to_global_.size();
+    }
+    else if(dimension == 0) {
+      return vertex_local_to_global_.size();
+    } // if
+
+    return 0;
+  } // num_entities
+
+  std::vector<size_t>
+  entities(size_t from_dim, size_t to_dim, size_t id) const override {
+    clog_assert(from_dim == DIMENSION, "invalid dimension " << from_dim);
+    clog_assert(to_dim == 0, "invalid dimension " << to_dim);
+
+    auto vertices = cells2vertices_.at(id);
+    return std::vector<size_t>(vertices.begin(), vertices.end());
+  } // entities
+
+  //--------------------------------------------------------------------------//
+  // parallel_mesh_definition_u interface.
+  //--------------------------------------------------------------------------//
+
+  const coloring::crs_t & entities_crs(size_t from_dim,
+    size_t to_dim) const override {
+    clog_assert(from_dim == DIMENSION, "invalid dimension " << from_dim);
+    clog_assert(to_dim == 0, "invalid dimension " << to_dim);
+
+    return cells2vertices_;
+  } // entities_crs
+
+  const std::vector<size_t> & local_to_global(size_t dim) const override {
+    return dim == 0 ? vertex_local_to_global_ : cell_local_to_global_;
+  } // local_to_global
+
+  const std::map<size_t, size_t> & global_to_local(size_t dim) const override {
+    return dim == 0 ? vertex_global_to_local_ : cell_global_to_local_;
+  } // global_to_local
+
+  void create_graph(size_t from_dimension,
+    size_t to_dimension,
+    size_t min_connections,
+    coloring::dcrs_t & dcrs) const override {
+    coloring::make_dcrs_distributed<DIMENSION>(
+      *this, from_dimension, to_dimension, min_connections, dcrs);
+  } // create_graph
+
+  /*!
+    Pack a cell for migration: the global cell id, the number of vertices,
+    and the global id and coordinates of each vertex.
+   */
+
+  void pack(size_t dimension, size_t local_id, std::vector<byte_t> & buffer)
+    const override {
+    clog_assert(dimension == DIMENSION, "invalid dimension " << dimension);
+
+    topology::cast_insert(&cell_local_to_global_[local_id], 1, buffer);
+
+    auto vertices = cells2vertices_.at(local_id);
+    size_t num_vertices = vertices.size();
+    topology::cast_insert(&num_vertices, 1, buffer);
+
+    for(auto v : vertices) {
+      topology::cast_insert(&vertex_local_to_global_[v], 1, buffer);
+      topology::cast_insert(&coordinates_[v * DIMENSION], DIMENSION, buffer);
+    } // for
+  } // pack
+
+  /*!
+    Unpack a migrated cell and append it to the local cells. Vertices that
+    are not yet known locally are appended to the local vertices.
+   */
+
+  void
+  unpack(size_t dimension, size_t local_id, byte_t const *& buffer) override {
+    clog_assert(dimension == DIMENSION, "invalid dimension " << dimension);
+    clog_assert(local_id == cell_local_to_global_.size(),
+      "migrated cells must be appended");
+
+    size_t global_id;
+    topology::uncast(buffer, 1, &global_id);
+
+    cell_local_to_global_.push_back(global_id);
+    cell_global_to_local_[global_id] = local_id;
+
+    size_t num_vertices;
+    topology::uncast(buffer, 1, &num_vertices);
+
+    std::vector<size_t> vertices(num_vertices);
+
+    for(size_t i(0); i < num_vertices; ++i) {
+      size_t vertex;
+      real_t coord[DIMENSION];
+      topology::uncast(buffer, 1, &vertex);
+      topology::uncast(buffer, DIMENSION, coord);
+
+      auto it = vertex_global_to_local_.find(vertex);
+
+      if(it == vertex_global_to_local_.end()) {
+        it = vertex_global_to_local_
+               .emplace(vertex, vertex_local_to_global_.size())
+               .first;
+        vertex_local_to_global_.push_back(vertex);
+        coordinates_.insert(coordinates_.end(), coord, coord + DIMENSION);
+      } // if
+
+      vertices[i] = it->second;
+    } // for
+
+    cells2vertices_.append(vertices.begin(), vertices.end());
+  } // unpack
+
+  /*!
+    Erase cells that have been migrated, and any vertices that are no
+    longer referenced by a local cell. The \em local_ids must be sorted.
+   */
+
+  void erase(size_t dimension, const std::vector<size_t> & local_ids) override {
+    clog_assert(dimension == DIMENSION, "invalid dimension " << dimension);
+
+    if(local_ids.empty()) {
+      return;
+    } // if
+
+    cells2vertices_.erase(local_ids);
+
+    // Compact the cell numbering.
+    size_t c{0};
+    auto remove = local_ids.begin();
+
+    for(size_t i(0); i < cell_local_to_global_.size(); ++i) {
+      if(remove != local_ids.end() && *remove == i) {
+        ++remove;
+        continue;
+      } // if
+
+      cell_local_to_global_[c++] = cell_local_to_global_[i];
+    } // for
+
+    cell_local_to_global_.resize(c);
+    cell_global_to_local_.clear();
+
+    for(size_t i(0); i < cell_local_to_global_.size(); ++i) {
+      cell_global_to_local_.emplace(cell_local_to_global_[i], i);
+    } // for
+
+    // Compact the vertex numbering.
+    std::vector<size_t> renumber(vertex_local_to_global_.size(), 0);
+
+    for(auto v : cells2vertices_.indices) {
+      renumber[v] = 1;
+    } // for
+
+    size_t v{0};
+    vertex_global_to_local_.clear();
+
+    for(size_t i(0); i < renumber.size(); ++i) {
+      if(renumber[i]) {
+        vertex_local_to_global_[v] = vertex_local_to_global_[i];
+        std::copy_n(&coordinates_[i * DIMENSION], DIMENSION,
+          &coordinates_[v * DIMENSION]);
+        vertex_global_to_local_.emplace(vertex_local_to_global_[v], v);
+        renumber[i] = v++;
+      } // if
+    } // for
+
+    vertex_local_to_global_.resize(v);
+    coordinates_.resize(v * DIMENSION);
+
+    for(auto & i : cells2vertices_.indices) {
+      i = renumber[i];
+    } // for
+  } // erase
+
+  /*!
+    The slab definition only stores cell-to-vertex connectivity, which is
+    always up to date, so there is nothing to build.
+   */
+
+  void build_connectivity() override {} // build_connectivity
+
+  void vertex(size_t id, real_t * coord) const override {
+    std::copy_n(&coordinates_[id * DIMENSION], DIMENSION, coord);
+  } // vertex
+
+  const std::vector<size_t> & face_owners() const override {
+    return face_owners_;
+  } // face_owners
+
+  const std::vector<size_t> & region_ids() const override {
+    return region_ids_;
+  } // region_ids
+
+private:
+  /*!
+    Collective read of \em count 64-bit values at byte \em offset. The
+    count is in values, not bytes, so that a rank can read more than 2 GiB.
+   */
+
+  static void
+  read_at(MPI_File fh, MPI_Offset offset, file_size_t * data, size_t count) {
+    clog_assert(count <= size_t(std::numeric_limits<int>::max()),
+      "slab read of " << count << " values exceeds the MPI count limit");
+
+    MPI_File_read_at_all(fh, offset, data, int(count),
+      utils::mpi_typetraits_u<file_size_t>::type(), MPI_STATUS_IGNORE);
+  } // read_at
+
+  coloring::crs_t cells2vertices_;
+
+  std::vector<size_t> cell_local_to_global_;
+  std::map<size_t, size_t> cell_global_to_local_;
+
+  std::vector<size_t> vertex_local_to_global_;
+  std::map<size_t, size_t> vertex_global_to_local_;
+
+  std::vector<real_t> coordinates_;
+
+  std::vector<size_t> face_owners_;
+  std::vector<size_t> region_ids_;
+
+}; // class slab_definition_u
+
+} // namespace io
+} // namespace flecsi
@@ -0,0 +1,70 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/io/simple_definition.h>
+#include <flecsi/io/slab_definition.h>
+
+using slab_definition_t = flecsi::io::slab_definition_u<2>;
+
+TEST(slab_definition, simple2d_8x8) {
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+
+  if(rank == 0) {
+    slab_definition_t::write("simple2d-8x8.bin", sd);
+  } // if
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  slab_definition_t md("simple2d-8x8.bin");
+
+  // Each rank holds only its slab of cells and the vertices they reference.
+  const auto & cells = md.local_to_global(2);
+  const auto & vertices = md.local_to_global(0);
+
+  for(size_t c(0); c < md.num_entities(2); ++c) {
+    auto local = md.entities(2, 0, c);
+    auto global = sd.entities(2, 0, cells[c]);
+
+    CINCH_ASSERT(EQ, local.size(), global.size());
+
+    for(size_t v(0); v < local.size(); ++v) {
+      CINCH_ASSERT(EQ, vertices[local[v]], global[v]);
+    } // for
+  } // for
+
+  for(size_t v(0); v < md.num_entities(0); ++v) {
+    double coord[2];
+    md.vertex(v, coord);
+
+    auto point = sd.vertex(vertices[v]);
+    CINCH_ASSERT(EQ, coord[0], point[0]);
+    CINCH_ASSERT(EQ, coord[1], point[1]);
+  } // for
+
+  // The distributed graph matches the graph built from the global
+  // definition on every rank.
+  flecsi::coloring::dcrs_t dcrs;
+  md.create_graph(2, 0, 2, dcrs);
+
+  auto expected = flecsi::coloring::make_dcrs(sd);
+
+  CINCH_ASSERT(EQ, dcrs.distribution, expected.distribution);
+  CINCH_ASSERT(EQ, dcrs.offsets, expected.offsets);
+  CINCH_ASSERT(EQ, dcrs.indices, expected.indices);
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -41,8 +41,8 @@ add_colorings(coloring_map_t map) {
   context_t & context_ = context_t::instance();
 
   int rank, size;
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(utils::mpi_comm(), &size);
+  MPI_Comm_rank(utils::mpi_comm(), &rank);
 
   {
     clog_tag_guard(coloring);
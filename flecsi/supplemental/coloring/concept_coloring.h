@@ -47,8 +47,8 @@ generic_coloring(typename COLORING_POLICY::mesh_definition_t & md,
   using namespace flecsi::utils;
 
   int rank, size;
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(utils::mpi_comm(), &size);
+  MPI_Comm_rank(utils::mpi_comm(), &rank);
 
   flecsi::coloring::index_coloring_t primary_coloring;
   flecsi::coloring::coloring_info_t primary_coloring_info;
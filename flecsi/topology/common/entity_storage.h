@@ -171,5 +171,8 @@ private:
   size_t size_;
 };
 
+template<typename T>
+struct is_identity_storage_u<identity_storage_u<T>> : std::true_type {};
+
 } // namespace topology
 } // namespace flecsi
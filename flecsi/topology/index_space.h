@@ -51,6 +51,10 @@ struct index_space_ref_type_u<domain_entity_u<M, E>> {
   using type = domain_entity_u<M, E>;
 };
 
+//! true if the id storage type maps each offset to the same storage index
+template<typename S>
+struct is_identity_storage_u : std::false_type {};
+
 //----------------------------------------------------------------------------//
 //! index_space_u provides a compile-time
 //! configurable and iterable container of objects, e.g. mesh/tree topology
@@ -635,6 +639,73 @@ public:
     }
   };
 
+  //------------------------------------------------------------------------//
+  //! Iterable range of the entities for which a predicate returns true.
+  //! The predicate is stored by value, so that calls to it can be inlined.
+  //!
+  //! @tparam P predicate callable object type
+  //!
+  //! @ingroup topology
+  //------------------------------------------------------------------------//
+  template<class P>
+  class filtered_range_
+  {
+  public:
+    class iterator
+    {
+    public:
+      iterator(const filtered_range_ * r, size_t offset)
+        : r_(r), offset_(offset) {
+        skip_();
+      }
+
+      bool operator==(const iterator & itr) const {
+        return offset_ == itr.offset_;
+      }
+
+      bool operator!=(const iterator & itr) const {
+        return offset_ != itr.offset_;
+      }
+
+      iterator & operator++() {
+        ++offset_;
+        skip_();
+        return *this;
+      }
+
+      ref_t operator*() const {
+        return r_->is_->get_(offset_);
+      }
+
+    private:
+      void skip_() {
+        const size_t end = r_->is_->size();
+        while(offset_ < end && !r_->p_(r_->is_->get_(offset_))) {
+          ++offset_;
+        } // while
+      }
+
+      const filtered_range_ * r_;
+      size_t offset_;
+    };
+
+    template<class Q>
+    filtered_range_(const index_space_u & is, Q && p)
+      : is_(&is), p_(std::forward<Q>(p)) {}
+
+    iterator begin() const {
+      return iterator(this, 0);
+    }
+
+    iterator end() const {
+      return iterator(this, is_->size());
+    }
+
+  private:
+    const index_space_u * is_;
+    mutable P p_;
+  };
+
   //-----------------------------------------------------------------//
   //! Constructor. If storage is true then allocate storage type,
   //! else this index space will index into a separate storage.
@@ -967,7 +1038,7 @@ public:
   //-----------------------------------------------------------------//
   FLECSI_INLINE_TARGET
   ref_t get_(size_t offset) {
-    return static_cast<cast_t>(
+    return static_cast<ref_t>(
       (*s_)[(*v_)[begin_ + offset].index_space_index()]);
   }
 
@@ -976,7 +1047,7 @@ public:
   //-----------------------------------------------------------------//
   FLECSI_INLINE_TARGET
   const ref_t get_(size_t offset) const {
-    return static_cast<cast_t>(
+    return static_cast<ref_t>(
       (*s_)[(*v_)[begin_ + offset].index_space_index()]);
   }
 
@@ -985,7 +1056,7 @@ public:
   //-----------------------------------------------------------------//
   FLECSI_INLINE_TARGET
   ref_t get_end_(size_t offset) {
-    return static_cast<cast_t>(
+    return static_cast<ref_t>(
       (*s_)[(*v_)[end_ - 1 - offset].index_space_index()]);
   }
 
@@ -994,7 +1065,7 @@ public:
   //-----------------------------------------------------------------//
   FLECSI_INLINE_TARGET
   const ref_t get_end_(size_t offset) const {
-    return static_cast<cast_t>(
+    return static_cast<ref_t>(
       (*s_)[(*v_)[end_ - 1 - offset].index_space_index()]);
   }
 
@@ -1226,46 +1297,103 @@ public:
     return is;
   }
 
+  //-----------------------------------------------------------------//
+  //! Return a range over the entities for which the predicate f returns
+  //! true, without building a new index space.
+  //!
+  //! @tparam Predicate predicate callable object type
+  //-----------------------------------------------------------------//
+  template<typename Predicate>
+  auto filtered(Predicate && f) const {
+    return filtered_range_<std::decay_t<Predicate>>(
+      *this, std::forward<Predicate>(f));
+  }
+
+  //-----------------------------------------------------------------//
+  //! Return true if the offsets of the index space map onto a
+  //! contiguous block of its storage, whose first index is returned in
+  //! \em base. This is known without reading the ids for identity id
+  //! storage.
+  //-----------------------------------------------------------------//
+  bool contiguous(size_t & base) const {
+    if(empty() || s_ == nullptr) {
+      return false;
+    }
+
+    if constexpr(is_identity_storage_u<id_storage_t>::value) {
+      base = begin_;
+      return true;
+    }
+    else {
+      base = (*v_)[begin_].index_space_index();
+
+      const size_t n = size();
+      for(size_t i = 1; i < n; ++i) {
+        if((*v_)[begin_ + i].index_space_index() != base + i) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+  }
+
   //-----------------------------------------------------------------//
   //! Apply a function f to each indexed entity in the index space,
-  //! mutating its state.
+  //! mutating its state. Contiguous index spaces are walked without
+  //! reading their ids, so that the loop can be vectorized.
+  //!
+  //! @tparam Function callable object type
   //-----------------------------------------------------------------//
-  void apply(apply_function f) const {
-    for(auto ent : *this) {
-      f(ent);
+  template<typename Function>
+  void apply(Function && f) const {
+    size_t base;
+
+    if(contiguous(base)) {
+      const size_t n = size();
+      for(size_t i = 0; i < n; ++i) {
+        f(static_cast<ref_t>((*s_)[base + i]));
+      }
+    }
+    else {
+      const size_t n = size();
+      for(size_t i = 0; i < n; ++i) {
+        f(get_(i));
+      }
     }
   }
 
   //-----------------------------------------------------------------//
-  //! Non mutating method to apply a function f over each entity an
-  //! index face, returning a new index space in the process
+  //! Non mutating method to apply a function f over each entity of an
+  //! index space, returning the results in index space order.
+  //!
+  //! @tparam S result type
+  //! @tparam Function callable object type
   //-----------------------------------------------------------------//
-  template<class S>
-  auto map(map_function<S> f) const {
-    index_space_u<S, false, true, false, void, flecsi::vector, STORAGE_TYPE> is;
-    is.set_master(*this);
+  template<class S, typename Function>
+  std::vector<S> map(Function && f) const {
+    std::vector<S> results;
+    results.reserve(size());
 
-    is.begin_push_(v_->size());
+    apply([&](ref_t item) { results.push_back(f(item)); });
 
-    for(auto item : *this) {
-      is.batch_push_(f(*item));
-    }
-    return is;
+    return results;
   }
 
   //-----------------------------------------------------------------//
-  //! Apply a reduction function to each entity in the index space
-  //! and return the reduced result.
+  //! Apply a reduction function f(entity, result) to each entity in the
+  //! index space and return the reduced result.
+  //!
+  //! @tparam S result type
+  //! @tparam Function callable object type
   //!
   //! @param start start value, e.g. 0 for sum, 1 for product
   //-----------------------------------------------------------------//
-  template<typename S>
-  S reduce(T start, reduce_function<T> f) const {
-    T r = start;
+  template<typename S, typename Function>
+  S reduce(S start, Function && f) const {
+    S r = start;
 
-    for(auto item : *this) {
-      f(*item, r);
-    }
+    apply([&](ref_t item) { f(item, r); });
 
     return r;
   }
@@ -1542,7 +1670,7 @@ public:
     if(SORTED || sorted_) {
       auto id = id_(item);
       auto itr = std::upper_bound(v_->begin(), v_->end(), id);
-      v_->insert(itr, index);
+      v_->insert(itr, id);
     }
     else {
       v_->push_back(id_(item));
@@ -1,8 +1,7 @@
 #include <cinchtest.h>
 #include <iostream>
 
-//#include <flecsi/topology/index_space.h>
-#include <flecsi/execution/execution.h>
+#include <flecsi/topology/index_space.h>
 
 #include "pseudo_random.h"
 
@@ -56,32 +55,20 @@ TEST(index_space, index_space) {
   }
 
   size_t cnt = 0;
-  flecsi_for_each(o, is, {
-    // std::cout << o->id << endl;
+  for(auto o : is) {
     ASSERT_EQ(o->index_space_id().index_space_index(), cnt++);
-  }); // foreach
+  } // for
 
-  double total_mass(0.0);
-
-  flecsi_reduce_each(o, is, total_mass, { total_mass += o->mass; });
+  double total_mass =
+    is.reduce(0.0, [](object * o, double & r) { r += o->mass; });
 
   std::cout << "total_mass: " << total_mass << std::endl;
   int mass_check = total_mass * 100;
   ASSERT_EQ(mass_check, 500342);
 
-#if 0
-  forall(is, o,
-    cout << o->id << endl;
-  );
-
-  double total_mass = 0;
-
-  reduce_all(is, o, total_mass,
-    total_mass += o->mass;
-  );
-
-  cout << "total_mass: " << total_mass << endl;
-#endif
+  for(auto o : is) {
+    delete o;
+  } // for
 }
 
 TEST(index_space, bin) {
@@ -120,3 +107,49 @@ TEST(index_space, bin) {
     }
   }
 }
+
+TEST(index_space, algorithms) {
+
+  using index_space_t = index_space_u<object *, true, true, false>;
+  index_space_t is;
+
+  constexpr size_t num_objects = 10;
+
+  for(size_t i = 0; i < num_objects; ++i) {
+    is << new object(i);
+  }
+
+  // The objects are stored in id order.
+  size_t base = 1;
+  ASSERT_TRUE(is.contiguous(base));
+  ASSERT_EQ(base, 0);
+
+  is.apply([](object * o) { o->mass = o->id.index_space_index(); });
+
+  auto masses = is.map<double>([](object * o) { return o->mass; });
+  ASSERT_EQ(masses.size(), num_objects);
+  ASSERT_EQ(masses[3], 3.0);
+
+  auto odd = is.filter([](object * o) { return o->id.id % 2 == 1; });
+  ASSERT_EQ(odd.size(), num_objects / 2);
+  ASSERT_FALSE(odd.contiguous(base));
+
+  // The same loops over the indirection of a filtered index space.
+  odd.apply([](object * o) { o->tag = 1; });
+  double total = odd.reduce(
+    0.0, [](object * o, double & r) { r += o->mass * o->tag; });
+  ASSERT_EQ(total, 1.0 + 3.0 + 5.0 + 7.0 + 9.0);
+
+  size_t cnt = 0;
+  for(auto o : is.filtered([](object * o) { return o->tag == 0; })) {
+    ASSERT_EQ(o->id.index_space_index(), 2 * cnt++);
+  }
+  ASSERT_EQ(cnt, num_objects / 2);
+
+  auto none = is.filtered([](object *) { return false; });
+  ASSERT_TRUE(none.begin() == none.end());
+
+  for(auto o : is) {
+    delete o;
+  }
+}
@@ -0,0 +1,107 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace flecsi {
+namespace utils {
+
+//----------------------------------------------------------------------------//
+//! Return the number of iterations that benchmarks should run. This may be
+//! set with the FLECSI_BENCHMARK_ITERATIONS environment variable.
+//!
+//! @param fallback The number of iterations if the variable is not set.
+//!
+//! @ingroup utils
+//----------------------------------------------------------------------------//
+
+inline size_t
+benchmark_iterations(size_t fallback = 100) {
+  if(const char * env = std::getenv("FLECSI_BENCHMARK_ITERATIONS")) {
+    return std::strtoul(env, nullptr, 10);
+  } // if
+
+  return fallback;
+} // benchmark_iterations
+
+//----------------------------------------------------------------------------//
+//! Return the wall-clock time in seconds of \em iterations invocations of
+//! \em f.
+//!
+//! @ingroup utils
+//----------------------------------------------------------------------------//
+
+template<typename FUNCTION>
+double
+benchmark_seconds(size_t iterations, FUNCTION && f) {
+  const auto start = std::chrono::steady_clock::now();
+
+  for(size_t i{0}; i < iterations; ++i) {
+    f();
+  } // for
+
+  const std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+} // benchmark_seconds
+
+//----------------------------------------------------------------------------//
+//! Write one benchmark result as a single line of JSON, e.g.,
+//!
+//! {"suite": "launch", "name": "dense_ro", "handles": 4, "us": 1.25}
+//!
+//! Results are written to standard output and appended to the file named
+//! by the FLECSI_BENCHMARK_OUTPUT environment variable, if it is set, so
+//! that they can be collected across runs and releases.
+//!
+//! @param suite  The benchmark suite.
+//! @param name   The benchmark name.
+//! @param values The measured and configuration values of the benchmark.
+//!
+//! @ingroup utils
+//----------------------------------------------------------------------------//
+
+inline void
+benchmark_report(const std::string & suite,
+  const std::string & name,
+  std::initializer_list<std::pair<const char *, double>> values) {
+  std::stringstream ss;
+  ss << "{\"suite\": \"" << suite << "\", \"name\": \"" << name << "\"";
+
+  for(auto & v : values) {
+    ss << ", \"" << v.first << "\": " << v.second;
+  } // for
+
+  ss << "}" << std::endl;
+
+  std::cout << ss.str() << std::flush;
+
+  if(const char * env = std::getenv("FLECSI_BENCHMARK_OUTPUT")) {
+    std::ofstream file(env, std::ios::app);
+    file << ss.str();
+  } // if
+} // benchmark_report
+
+} // namespace utils
+} // namespace flecsi
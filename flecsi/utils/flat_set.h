@@ -0,0 +1,315 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace flecsi {
+namespace utils {
+
+/*!
+  A set that stores its elements in a sorted, contiguous array. It
+  provides the interface of std::set that does not depend on node
+  stability, with random-access iterators and no per-element allocation.
+
+  Elements are appended in constant time when they are inserted in
+  increasing order, which is the common case when a set is built from
+  sorted input. Other insertions take linear time, so a large set with an
+  arbitrary order should be built with the range constructor or the range
+  insert, which sort once. Like std::set, iterators are constant, and
+  insertion and erasure invalidate them.
+
+  @tparam T       The element type.
+  @tparam COMPARE The strict weak ordering of the elements.
+ */
+
+template<typename T, typename COMPARE = std::less<T>>
+class flat_set_u
+{
+  using vector_t = std::vector<T>;
+
+public:
+  using key_type = T;
+  using value_type = T;
+  using size_type = typename vector_t::size_type;
+  using difference_type = typename vector_t::difference_type;
+  using key_compare = COMPARE;
+  using value_compare = COMPARE;
+  using reference = const T &;
+  using const_reference = const T &;
+  using pointer = const T *;
+  using const_pointer = const T *;
+  using iterator = typename vector_t::const_iterator;
+  using const_iterator = typename vector_t::const_iterator;
+  using reverse_iterator = typename vector_t::const_reverse_iterator;
+  using const_reverse_iterator = typename vector_t::const_reverse_iterator;
+
+  flat_set_u() = default;
+
+  /*!
+    Construct from a range in any order. Duplicates are removed.
+   */
+
+  template<typename INPUT_ITERATOR>
+  flat_set_u(INPUT_ITERATOR first, INPUT_ITERATOR last) : data_(first, last) {
+    normalize(data_.begin());
+  } // flat_set_u
+
+  flat_set_u(std::initializer_list<T> values)
+    : flat_set_u(values.begin(), values.end()) {}
+
+  /*!
+    Implicit conversion from a std::set with the same ordering, which is
+    already sorted.
+   */
+
+  flat_set_u(const std::set<T, COMPARE> & values)
+    : data_(values.begin(), values.end()) {}
+
+  flat_set_u & operator=(std::initializer_list<T> values) {
+    data_.assign(values.begin(), values.end());
+    normalize(data_.begin());
+    return *this;
+  } // operator =
+
+  //--------------------------------------------------------------------------//
+  // Iterators.
+  //--------------------------------------------------------------------------//
+
+  const_iterator begin() const {
+    return data_.begin();
+  }
+  const_iterator end() const {
+    return data_.end();
+  }
+  const_iterator cbegin() const {
+    return data_.cbegin();
+  }
+  const_iterator cend() const {
+    return data_.cend();
+  }
+  const_reverse_iterator rbegin() const {
+    return data_.rbegin();
+  }
+  const_reverse_iterator rend() const {
+    return data_.rend();
+  }
+
+  //--------------------------------------------------------------------------//
+  // Capacity and element access.
+  //--------------------------------------------------------------------------//
+
+  bool empty() const {
+    return data_.empty();
+  }
+  size_type size() const {
+    return data_.size();
+  }
+  size_type capacity() const {
+    return data_.capacity();
+  }
+  void reserve(size_type n) {
+    data_.reserve(n);
+  }
+  void shrink_to_fit() {
+    data_.shrink_to_fit();
+  }
+
+  /*!
+    Return the element at position \em i in sorted order.
+   */
+
+  const T & operator[](size_type i) const {
+    return data_[i];
+  }
+
+  const T * data() const {
+    return data_.data();
+  }
+
+  //--------------------------------------------------------------------------//
+  // Modifiers.
+  //--------------------------------------------------------------------------//
+
+  void clear() {
+    data_.clear();
+  }
+
+  std::pair<iterator, bool> insert(const T & value) {
+    return insert_(value);
+  }
+
+  std::pair<iterator, bool> insert(T && value) {
+    return insert_(std::move(value));
+  }
+
+  /*!
+    Insert with a hint, which is used if \em value belongs right before
+    \em hint. This allows std::inserter to append to a set in constant
+    time.
+   */
+
+  iterator insert(const_iterator hint, const T & value) {
+    const COMPARE less;
+
+    if((hint == end() || less(value, *hint)) &&
+       (hint == begin() || less(*std::prev(hint), value))) {
+      return data_.insert(hint, value);
+    } // if
+
+    return insert_(value).first;
+  } // insert
+
+  /*!
+    Insert a range in any order. This sorts the new elements and merges
+    them with the existing ones, so it takes O(n log n) time in the size
+    of the range plus linear time in the size of the set.
+   */
+
+  template<typename INPUT_ITERATOR>
+  void insert(INPUT_ITERATOR first, INPUT_ITERATOR last) {
+    const size_type n = data_.size();
+    data_.insert(data_.end(), first, last);
+    normalize(data_.begin() + n);
+  } // insert
+
+  void insert(std::initializer_list<T> values) {
+    insert(values.begin(), values.end());
+  }
+
+  template<typename... ARGS>
+  std::pair<iterator, bool> emplace(ARGS &&... args) {
+    return insert_(T(std::forward<ARGS>(args)...));
+  }
+
+  iterator erase(const_iterator position) {
+    return data_.erase(position);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    return data_.erase(first, last);
+  }
+
+  size_type erase(const T & value) {
+    auto it = find(value);
+
+    if(it == end()) {
+      return 0;
+    } // if
+
+    data_.erase(it);
+    return 1;
+  } // erase
+
+  void swap(flat_set_u & other) {
+    data_.swap(other.data_);
+  }
+
+  //--------------------------------------------------------------------------//
+  // Lookup.
+  //--------------------------------------------------------------------------//
+
+  const_iterator lower_bound(const T & value) const {
+    return std::lower_bound(begin(), end(), value, COMPARE());
+  }
+
+  const_iterator upper_bound(const T & value) const {
+    return std::upper_bound(begin(), end(), value, COMPARE());
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+    const T & value) const {
+    return std::equal_range(begin(), end(), value, COMPARE());
+  }
+
+  const_iterator find(const T & value) const {
+    auto it = lower_bound(value);
+    return it != end() && !COMPARE()(value, *it) ? it : end();
+  } // find
+
+  size_type count(const T & value) const {
+    return find(value) != end();
+  }
+
+  key_compare key_comp() const {
+    return COMPARE();
+  }
+  value_compare value_comp() const {
+    return COMPARE();
+  }
+
+  //--------------------------------------------------------------------------//
+  // Comparison.
+  //--------------------------------------------------------------------------//
+
+  bool operator==(const flat_set_u & other) const {
+    return data_ == other.data_;
+  }
+  bool operator!=(const flat_set_u & other) const {
+    return data_ != other.data_;
+  }
+  bool operator<(const flat_set_u & other) const {
+    return data_ < other.data_;
+  }
+
+private:
+  template<typename U>
+  std::pair<iterator, bool> insert_(U && value) {
+    const COMPARE less;
+
+    // Appending is the common case.
+    if(data_.empty() || less(data_.back(), value)) {
+      data_.push_back(std::forward<U>(value));
+      return {std::prev(data_.cend()), true};
+    } // if
+
+    auto it = lower_bound(value);
+
+    if(it != end() && !less(value, *it)) {
+      return {it, false};
+    } // if
+
+    return {data_.insert(it, std::forward<U>(value)), true};
+  } // insert_
+
+  /*!
+    Sort the elements from \em middle on, merge them with the sorted
+    elements before it, and remove the duplicates. Of equivalent elements,
+    the first one is kept.
+   */
+
+  void normalize(typename vector_t::iterator middle) {
+    const COMPARE less;
+
+    std::stable_sort(middle, data_.end(), less);
+    std::inplace_merge(data_.begin(), middle, data_.end(), less);
+    data_.erase(std::unique(data_.begin(), data_.end(),
+                  [&](const T & a, const T & b) { return !less(a, b); }),
+      data_.end());
+  } // normalize
+
+  vector_t data_;
+
+}; // class flat_set_u
+
+} // namespace utils
+} // namespace flecsi
@@ -0,0 +1,64 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <flecsi-config.h>
+
+#if !defined(FLECSI_ENABLE_MPI)
+#error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+namespace flecsi {
+namespace utils {
+
+inline MPI_Comm &
+mpi_comm_() {
+  static MPI_Comm comm = MPI_COMM_WORLD;
+  return comm;
+} // mpi_comm_
+
+/*!
+ Return the communicator on which FleCSI runs. This is MPI_COMM_WORLD
+ unless the runtime was initialized on a sub-communicator, e.g., to run
+ next to other coupled codes or other FleCSI instances. All collectives,
+ windows and groups of the runtime and of the colorers use it.
+
+ @ingroup utils
+ */
+
+inline MPI_Comm
+mpi_comm() {
+  return mpi_comm_();
+} // mpi_comm
+
+/*!
+ Set the communicator on which FleCSI runs. This must be called before
+ any communication, and is done by the runtime when it is initialized.
+
+ @param comm The communicator of the ranks of this FleCSI instance.
+
+ @ingroup utils
+ */
+
+inline void
+set_mpi_comm(MPI_Comm comm) {
+  mpi_comm_() = comm;
+} // set_mpi_comm
+
+} // namespace utils
+} // namespace flecsi
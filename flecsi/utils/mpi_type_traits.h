@@ -37,6 +37,10 @@ namespace utils {
 template<typename TYPE>
 struct mpi_typetraits_u {
 
+  //! Whether the type is an MPI predefined type, to which the predefined
+  //! reduction operations apply.
+  static constexpr bool builtin = false;
+
   inline static MPI_Datatype type() {
     static MPI_Datatype data_type = MPI_DATATYPE_NULL;
 
@@ -50,6 +54,7 @@ struct mpi_typetraits_u {
 
 template<>
 struct mpi_typetraits_u<size_t> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     if(sizeof(size_t) == 8) {
       return MPI_UNSIGNED_LONG_LONG;
@@ -62,6 +67,7 @@ struct mpi_typetraits_u<size_t> {
 
 template<>
 struct mpi_typetraits_u<char> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_SIGNED_CHAR;
   }
@@ -69,6 +75,7 @@ struct mpi_typetraits_u<char> {
 
 template<>
 struct mpi_typetraits_u<unsigned char> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_UNSIGNED_CHAR;
   }
@@ -76,6 +83,7 @@ struct mpi_typetraits_u<unsigned char> {
 
 template<>
 struct mpi_typetraits_u<short> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_SHORT;
   }
@@ -83,6 +91,7 @@ struct mpi_typetraits_u<short> {
 
 template<>
 struct mpi_typetraits_u<unsigned short> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_UNSIGNED_SHORT;
   }
@@ -90,6 +99,7 @@ struct mpi_typetraits_u<unsigned short> {
 
 template<>
 struct mpi_typetraits_u<int> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_INT;
   }
@@ -97,6 +107,7 @@ struct mpi_typetraits_u<int> {
 
 template<>
 struct mpi_typetraits_u<unsigned> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_UNSIGNED;
   }
@@ -104,6 +115,7 @@ struct mpi_typetraits_u<unsigned> {
 
 template<>
 struct mpi_typetraits_u<long> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_LONG;
   }
@@ -111,6 +123,7 @@ struct mpi_typetraits_u<long> {
 
 template<>
 struct mpi_typetraits_u<double> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_DOUBLE;
   }
@@ -118,6 +131,7 @@ struct mpi_typetraits_u<double> {
 
 template<>
 struct mpi_typetraits_u<float> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_FLOAT;
   }
@@ -125,6 +139,7 @@ struct mpi_typetraits_u<float> {
 
 template<>
 struct mpi_typetraits_u<long double> {
+  static constexpr bool builtin = true;
   inline static MPI_Datatype type() {
     return MPI_LONG_DOUBLE;
   }
@@ -16,6 +16,7 @@
 /*! @file */
 
 #include <algorithm>
+#include <iterator>
 #include <set>
 
 namespace flecsi {
@@ -84,5 +85,44 @@ set_difference(const std::set<T> & s1, const std::set<T> & s2) {
   return difference;
 } // set_difference
 
+//!
+//! Versions of the set operations above for sorted containers other than
+//! std::set, e.g., flat_set_u, and for mixed arguments. The result has the
+//! type of the first argument.
+//!
+
+template<class S1, class S2>
+inline S1
+set_intersection(const S1 & s1, const S2 & s2) {
+  S1 intersection;
+
+  std::set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(),
+    std::inserter(intersection, intersection.end()));
+
+  return intersection;
+} // set_intersection
+
+template<class S1, class S2>
+inline S1
+set_union(const S1 & s1, const S2 & s2) {
+  S1 sunion;
+
+  std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(),
+    std::inserter(sunion, sunion.end()));
+
+  return sunion;
+} // set_union
+
+template<class S1, class S2>
+inline S1
+set_difference(const S1 & s1, const S2 & s2) {
+  S1 difference;
+
+  std::set_difference(s1.begin(), s1.end(), s2.begin(), s2.end(),
+    std::inserter(difference, difference.end()));
+
+  return difference;
+} // set_difference
+
 } // namespace utils
 } // namespace flecsi
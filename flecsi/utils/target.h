@@ -55,3 +55,13 @@ using vector = std::vector<T>;
 #if !defined(FLECSI_INLINE_TARGET)
 #define FLECSI_INLINE_TARGET inline
 #endif
+
+//----------------------------------------------------------------------------//
+// Vectorization hints.
+//----------------------------------------------------------------------------//
+
+#if defined(_OPENMP) || defined(FLECSI_ENABLE_OPENMP_SIMD)
+#define FLECSI_SIMD_LOOP _Pragma("omp simd")
+#else
+#define FLECSI_SIMD_LOOP
+#endif
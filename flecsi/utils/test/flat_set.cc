@@ -0,0 +1,123 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Tests related to a flat set.
+////////////////////////////////////////////////////////////////////////////////
+
+// user includes
+#include <flecsi/utils/flat_set.h>
+#include <flecsi/utils/set_utils.h>
+
+// system includes
+#include <cinchtest.h>
+#include <iterator>
+#include <set>
+
+// explicitly use some stuff
+using flat_set = flecsi::utils::flat_set_u<int>;
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the construction of flat_set's.
+///////////////////////////////////////////////////////////////////////////////
+TEST(flat_set, construction) {
+
+  // default constructor
+  flat_set s1;
+  ASSERT_TRUE(s1.empty());
+
+  // range constructor sorts and removes duplicates
+  std::vector<int> values = {5, 3, 9, 3, 1, 5};
+  flat_set s2(values.begin(), values.end());
+  ASSERT_EQ(4, s2.size());
+  ASSERT_TRUE(std::is_sorted(s2.begin(), s2.end()));
+
+  // initializer list constructor
+  flat_set s3 = {9, 1, 5, 3};
+  ASSERT_EQ(s2, s3);
+
+  // conversion from std::set
+  std::set<int> s = {1, 3, 5, 9};
+  flat_set s4(s);
+  ASSERT_EQ(s3, s4);
+  ASSERT_TRUE(std::equal(s.begin(), s.end(), s4.begin()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test insertion and erasure.
+///////////////////////////////////////////////////////////////////////////////
+TEST(flat_set, modifiers) {
+
+  flat_set s;
+
+  // in order
+  for(int i = 0; i < 10; i += 2) {
+    auto r = s.insert(i);
+    ASSERT_TRUE(r.second);
+    ASSERT_EQ(i, *r.first);
+  }
+
+  // out of order and duplicates
+  ASSERT_TRUE(s.insert(5).second);
+  ASSERT_FALSE(s.insert(4).second);
+  ASSERT_TRUE(s.emplace(-1).second);
+  ASSERT_EQ(7, s.size());
+  ASSERT_TRUE(std::is_sorted(s.begin(), s.end()));
+
+  // range insert merges
+  std::vector<int> more = {11, 3, 7, 3, 0};
+  s.insert(more.begin(), more.end());
+  flat_set expected = {-1, 0, 2, 3, 4, 5, 6, 7, 8, 11};
+  ASSERT_EQ(expected, s);
+
+  // hinted insert, e.g., through std::inserter
+  flat_set t;
+  std::copy(expected.begin(), expected.end(), std::inserter(t, t.end()));
+  ASSERT_EQ(expected, t);
+  t.insert(t.begin(), 1);
+  ASSERT_EQ(1, t[2]);
+
+  // erase
+  ASSERT_EQ(1, s.erase(5));
+  ASSERT_EQ(0, s.erase(5));
+  s.erase(s.begin());
+  ASSERT_EQ(0, *s.begin());
+  ASSERT_EQ(8, s.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test lookup.
+///////////////////////////////////////////////////////////////////////////////
+TEST(flat_set, lookup) {
+
+  flat_set s = {1, 3, 5, 7};
+
+  ASSERT_EQ(1, s.count(3));
+  ASSERT_EQ(0, s.count(4));
+  ASSERT_EQ(s.end(), s.find(4));
+  ASSERT_EQ(2, std::distance(s.begin(), s.find(5)));
+  ASSERT_EQ(5, *s.lower_bound(4));
+  ASSERT_EQ(7, *s.upper_bound(5));
+  ASSERT_EQ(7, *s.rbegin());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the set utilities with flat sets.
+///////////////////////////////////////////////////////////////////////////////
+TEST(flat_set, set_utils) {
+
+  flat_set a = {1, 2, 3, 4};
+  std::set<int> b = {3, 4, 5};
+
+  ASSERT_EQ(flat_set({1, 2, 3, 4, 5}), flecsi::utils::set_union(a, b));
+  ASSERT_EQ(flat_set({3, 4}), flecsi::utils::set_intersection(a, b));
+  ASSERT_EQ(flat_set({1, 2}), flecsi::utils::set_difference(a, b));
+  ASSERT_EQ(std::set<int>({5}), flecsi::utils::set_difference(b, a));
+}
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,128 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Tests related to the timeline trace.
+////////////////////////////////////////////////////////////////////////////////
+
+// user includes
+#include <flecsi/utils/trace.h>
+
+// system includes
+#include <cinchtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// explicitly use some stuff
+using flecsi::utils::trace_recorder_t;
+using flecsi::utils::trace_scope_t;
+
+namespace {
+
+size_t
+count(const std::string & s, const std::string & pattern) {
+  size_t n(0);
+  for(auto p = s.find(pattern); p != std::string::npos;
+      p = s.find(pattern, p + 1)) {
+    ++n;
+  } // for
+  return n;
+} // count
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test that scopes are written as complete events.
+///////////////////////////////////////////////////////////////////////////////
+TEST(trace, scope) {
+  auto & recorder = trace_recorder_t::instance();
+  recorder.clear();
+  recorder.set_name(42, "my_task");
+
+  {
+    trace_scope_t task("task", nullptr, 42);
+    trace_scope_t ghost("ghost", "dense \"quoted\"");
+    ghost.add_bytes(96);
+    ghost.add_bytes(32);
+  }
+
+  std::ostringstream os;
+  recorder.write(os, 3);
+  const std::string trace = os.str();
+
+  ASSERT_EQ(trace.find("{\"traceEvents\":["), 0);
+  ASSERT_EQ(count(trace, "\"ph\":\"X\""), 2);
+  ASSERT_EQ(count(trace, "\"pid\":3"), 2);
+  ASSERT_NE(trace.find("\"name\":\"my_task\",\"cat\":\"task\""),
+    std::string::npos);
+  ASSERT_NE(trace.find("\"name\":\"dense \\\"quoted\\\"\",\"cat\":\"ghost\""),
+    std::string::npos);
+  ASSERT_NE(trace.find("\"args\":{\"bytes\":128}"), std::string::npos);
+
+  recorder.clear();
+  std::ostringstream empty;
+  recorder.write(empty, 0);
+  ASSERT_EQ(count(empty.str(), "\"ph\""), 0);
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test that each thread records into its own buffer.
+///////////////////////////////////////////////////////////////////////////////
+TEST(trace, threads) {
+  auto & recorder = trace_recorder_t::instance();
+  recorder.clear();
+
+  auto work = []() {
+    for(size_t i(0); i < 10; ++i) {
+      trace_scope_t scope("task", "work");
+    } // for
+  };
+
+  std::thread t1(work), t2(work);
+  t1.join();
+  t2.join();
+  work();
+
+  std::ostringstream os;
+  recorder.write(os, 0);
+  const std::string trace = os.str();
+
+  ASSERT_EQ(count(trace, "\"name\":\"work\""), 30);
+  ASSERT_NE(trace.find("\"tid\":1"), std::string::npos);
+  ASSERT_NE(trace.find("\"tid\":2"), std::string::npos);
+  ASSERT_EQ(recorder.dropped(), 0);
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test that a full buffer keeps the newest events.
+///////////////////////////////////////////////////////////////////////////////
+TEST(trace, overflow) {
+  auto & recorder = trace_recorder_t::instance();
+  recorder.clear();
+
+  const size_t n = (1 << 16) + 5;
+
+  for(size_t i(0); i < n; ++i) {
+    recorder.record({"task", i + 1 == n ? "last" : "work", 0, i, i + 1, 0});
+  } // for
+
+  std::ostringstream os;
+  recorder.write(os, 0);
+  const std::string trace = os.str();
+
+  ASSERT_EQ(recorder.dropped(), 5);
+  ASSERT_EQ(count(trace, "\"ph\""), 1 << 16);
+
+  // The newest event is written last.
+  ASSERT_LT(trace.rfind("\"name\":\"work\""), trace.find("\"name\":\"last\""));
+
+  recorder.clear();
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
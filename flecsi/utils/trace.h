@@ -0,0 +1,346 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <flecsi-config.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flecsi {
+namespace utils {
+
+/*!
+  The trace_recorder_t type collects a timeline of the regions executed
+  by the runtime, e.g., tasks, ghost exchanges, and control actions, and
+  writes it in the Chrome trace event format, which can be viewed with
+  chrome://tracing or Perfetto.
+
+  Each thread records into its own ring buffer, so that recording does not
+  take a lock. When a buffer is full, the oldest events of the thread are
+  overwritten. The capacity of the buffers can be set with the
+  FLECSI_TRACE_EVENTS environment variable.
+
+  The recorder is normally used through the flecsi_trace macros, which
+  compile to nothing unless FleCSI is configured with ENABLE_TRACE.
+
+  @ingroup utils
+ */
+
+class trace_recorder_t
+{
+public:
+  /*!
+    A recorded region. Names are either string literals or ids that are
+    resolved by the name registry when the trace is written, so that
+    recording never copies a string.
+   */
+
+  struct event_t {
+    const char * category;
+    const char * name;
+    std::size_t id;
+    std::uint64_t begin;
+    std::uint64_t end;
+    std::uint64_t bytes;
+  }; // struct event_t
+
+  static trace_recorder_t & instance() {
+    static trace_recorder_t recorder;
+    return recorder;
+  } // instance
+
+  /*!
+    Return the current time in nanoseconds.
+   */
+
+  static std::uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  } // now
+
+  /*!
+    Record an event on the calling thread.
+   */
+
+  void record(const event_t & event) {
+    thread_buffer().push(event);
+  } // record
+
+  /*!
+    Associate a name with an id, e.g., the name of a registered task with
+    its hash.
+   */
+
+  void set_name(std::size_t id, const std::string & name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    names_[id] = name;
+  } // set_name
+
+  /*!
+    Return the number of events that have been overwritten because a
+    buffer was full.
+   */
+
+  std::size_t dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t result(0);
+
+    for(auto & b : buffers_) {
+      result += b->head > b->events.size() ? b->head - b->events.size() : 0;
+    } // for
+
+    return result;
+  } // dropped
+
+  /*!
+    Discard the recorded events of every thread.
+   */
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for(auto & b : buffers_) {
+      b->events.clear();
+      b->head = 0;
+    } // for
+  } // clear
+
+  /*!
+    Write the recorded events as a Chrome trace. This must not be called
+    while other threads are recording.
+
+    @param stream The output stream.
+    @param pid    The process id of the events, typically the rank.
+   */
+
+  void write(std::ostream & stream, std::size_t pid) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    stream << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    for(std::size_t tid(0); tid < buffers_.size(); ++tid) {
+      auto & b = *buffers_[tid];
+      const std::size_t n = b.events.size();
+
+      // Write the events of a full buffer from the oldest one.
+      for(std::size_t i(0); i < n; ++i) {
+        auto & e = b.events[(b.head + i) % n];
+
+        stream << (first ? "\n" : ",\n");
+        first = false;
+
+        stream << "{\"name\":\"";
+        escape(stream, event_name(e));
+        stream << "\",\"cat\":\"";
+        escape(stream, e.category);
+        stream << "\",\"ph\":\"X\",\"ts\":" << e.begin / 1000.0
+               << ",\"dur\":" << (e.end - e.begin) / 1000.0
+               << ",\"pid\":" << pid << ",\"tid\":" << tid;
+
+        if(e.bytes != 0) {
+          stream << ",\"args\":{\"bytes\":" << e.bytes << "}";
+        } // if
+
+        stream << "}";
+      } // for
+    } // for
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  } // write
+
+  /*!
+    Write the recorded events to the file <prefix>-<pid>.json, where the
+    prefix is given by the FLECSI_TRACE_PREFIX environment variable and
+    defaults to flecsi-trace.
+   */
+
+  void write(std::size_t pid) const {
+    const char * prefix = std::getenv("FLECSI_TRACE_PREFIX");
+    std::ofstream file(std::string(prefix ? prefix : "flecsi-trace") + "-" +
+                       std::to_string(pid) + ".json");
+    write(file, pid);
+  } // write
+
+private:
+  struct buffer_t {
+    void push(const event_t & event) {
+      if(events.size() < capacity) {
+        events.push_back(event);
+      }
+      else {
+        events[head % capacity] = event;
+      } // if
+
+      ++head;
+    } // push
+
+    std::size_t capacity;
+    std::size_t head = 0;
+    std::vector<event_t> events;
+  }; // struct buffer_t
+
+  trace_recorder_t() {
+    const char * events = std::getenv("FLECSI_TRACE_EVENTS");
+    capacity_ = events ? std::strtoul(events, nullptr, 10) : 0;
+    capacity_ = capacity_ ? capacity_ : 1 << 16;
+  } // trace_recorder_t
+
+  buffer_t & thread_buffer() {
+    thread_local buffer_t * buffer = nullptr;
+
+    if(buffer == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      buffers_.emplace_back(new buffer_t);
+      buffer = buffers_.back().get();
+      buffer->capacity = capacity_;
+    } // if
+
+    return *buffer;
+  } // thread_buffer
+
+  const char * event_name(const event_t & e) const {
+    if(e.name != nullptr) {
+      return e.name;
+    } // if
+
+    auto it = names_.find(e.id);
+    return it != names_.end() ? it->second.c_str() : "unnamed";
+  } // event_name
+
+  static void escape(std::ostream & stream, const char * s) {
+    for(; *s; ++s) {
+      if(*s == '"' || *s == '\\') {
+        stream << '\\' << *s;
+      }
+      else if(static_cast<unsigned char>(*s) >= 0x20) {
+        stream << *s;
+      } // if
+    } // for
+  } // escape
+
+  mutable std::mutex mutex_;
+  std::size_t capacity_;
+  std::vector<std::unique_ptr<buffer_t>> buffers_;
+  std::unordered_map<std::size_t, std::string> names_;
+
+}; // class trace_recorder_t
+
+/*!
+  The trace_scope_t type records the region from its construction to its
+  destruction.
+ */
+
+class trace_scope_t
+{
+public:
+  trace_scope_t(const char * category, const char * name, std::size_t id = 0)
+    : event_{category, name, id, trace_recorder_t::now(), 0, 0} {}
+
+  trace_scope_t(const trace_scope_t &) = delete;
+  trace_scope_t & operator=(const trace_scope_t &) = delete;
+
+  ~trace_scope_t() {
+    event_.end = trace_recorder_t::now();
+    trace_recorder_t::instance().record(event_);
+  } // ~trace_scope_t
+
+  /*!
+    Add to the number of bytes communicated in the region.
+   */
+
+  void add_bytes(std::size_t bytes) {
+    event_.bytes += bytes;
+  } // add_bytes
+
+private:
+  trace_recorder_t::event_t event_;
+
+}; // class trace_scope_t
+
+} // namespace utils
+} // namespace flecsi
+
+/*!
+  @def flecsi_trace_region
+
+  Record the rest of the enclosing scope as a region with the given
+  category and name, which must outlive the trace, e.g., string literals.
+ */
+
+/*!
+  @def flecsi_trace_task_region
+
+  Record the rest of the enclosing scope as a region named by an id that
+  has been registered with flecsi_trace_register, e.g., the hash of a
+  task.
+ */
+
+/*!
+  @def flecsi_trace_bytes
+
+  Add to the number of bytes communicated in the region of the enclosing
+  scope.
+ */
+
+/*!
+  @def flecsi_trace_register
+
+  Associate a name with an id.
+ */
+
+/*!
+  @def flecsi_trace_write
+
+  Write the trace of this process to a file.
+ */
+
+#if defined(FLECSI_ENABLE_TRACE)
+
+#define flecsi_trace_region(category, name)                                    \
+  flecsi::utils::trace_scope_t flecsi_trace_scope_(category, name)
+
+#define flecsi_trace_task_region(category, id)                                 \
+  flecsi::utils::trace_scope_t flecsi_trace_scope_(category, nullptr, id)
+
+#define flecsi_trace_bytes(bytes) flecsi_trace_scope_.add_bytes(bytes)
+
+#define flecsi_trace_register(id, name)                                        \
+  flecsi::utils::trace_recorder_t::instance().set_name(id, name)
+
+#define flecsi_trace_write(pid)                                                \
+  flecsi::utils::trace_recorder_t::instance().write(pid)
+
+#else
+
+#define flecsi_trace_region(category, name)
+#define flecsi_trace_task_region(category, id)
+#define flecsi_trace_bytes(bytes)
+#define flecsi_trace_register(id, name)
+#define flecsi_trace_write(pid)
+
+#endif // FLECSI_ENABLE_TRACE